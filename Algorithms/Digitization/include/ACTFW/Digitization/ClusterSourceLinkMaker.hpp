@@ -0,0 +1,47 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <string>
+
+#include "ACTFW/Framework/BareAlgorithm.hpp"
+
+namespace FW {
+
+/// Create fittable measurements from planar clusters.
+///
+/// Each cluster is converted into a two-dimensional source link using its
+/// local position and covariance. The source links are stored in the same
+/// order as the clusters, i.e. the cluster index can be used to look up the
+/// corresponding source link and vice versa. This keeps them consistent with
+/// the hit indices used for space points, seeds, and the truth hit-particles
+/// map.
+class ClusterSourceLinkMaker final : public BareAlgorithm
+{
+public:
+  struct Config
+  {
+    /// Input planar clusters collection.
+    std::string inputClusters;
+    /// Input simulated hits collection referenced by the clusters.
+    std::string inputSimulatedHits;
+    /// Output source links collection.
+    std::string outputSourceLinks;
+  };
+
+  ClusterSourceLinkMaker(Config cfg, Acts::Logging::Level lvl);
+
+  ProcessCode
+  execute(const AlgorithmContext& ctx) const final override;
+
+private:
+  Config m_cfg;
+};
+
+}  // namespace FW
@@ -8,13 +8,19 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include "ACTFW/Digitization/Resolution.hpp"
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Utilities/Definitions.hpp"
 
 namespace Acts {
 class DigitizationModule;
@@ -26,7 +32,14 @@ class TrackingGeometry;
 
 namespace FW {
 
+class PlanarClusterContainer;
+
 /// Create planar clusters from simulation hits.
+///
+/// By default, each hit creates a separate cluster. Optionally, the activated
+/// cells from all hits on a module are merged and clusters are formed from
+/// connected cells. Such a cluster can contain contributions from multiple
+/// hits, e.g. in dense environments.
 class DigitizationAlgorithm final : public BareAlgorithm
 {
 public:
@@ -42,6 +55,13 @@ public:
     std::shared_ptr<const Acts::PlanarModuleStepper> planarModuleStepper;
     /// Random numbers tool.
     std::shared_ptr<const RandomNumbers> randomNumbers;
+    /// Merge cells from all hits on a module into connected clusters.
+    bool mergeHits = false;
+    /// Cell connectivity for merged clusters; 4 (edges) or 8 (also corners).
+    std::size_t connectivity = 8u;
+    /// Optional cluster resolutions per geometry hierarchy level. A fixed
+    /// default is used for modules without a matching entry.
+    ResolutionMap resolutions;
   };
 
   /// Construct the digitization algorithm.
@@ -58,16 +78,70 @@ public:
   execute(const AlgorithmContext& ctx) const final override;
 
 private:
+  /// Per-run module data.
+  ///
+  /// The inverse surface transforms are not stored since they depend on the
+  /// event geometry context, e.g. with alignment decorators. The segmentation
+  /// is only accessed within PlanarModuleStepper::cellSteps, which takes the
+  /// full digitization module; caching its parameters here would not remove
+  /// any per-hit work. For the same reason the cell steps can not be written
+  /// into a reused buffer, since cellSteps returns them by value.
   struct Digitizable
   {
+    Acts::GeometryID                       geoId;
     const Acts::Surface*                   surface         = nullptr;
     const Acts::IdentifiedDetectorElement* detectorElement = nullptr;
     const Acts::DigitizationModule*        digitizer       = nullptr;
+    /// Local x shift due to the lorentz angle.
+    double lorentzShift = 0.0;
+    /// Cluster resolution used for the covariance.
+    LocalResolution resolution;
+  };
+  /// Contribution of a single hit to an activated cell.
+  struct CellContribution
+  {
+    uint32_t    channel0;
+    uint32_t    channel1;
+    double      pathLength;
+    double      center0;
+    double      center1;
+    double      time;
+    std::size_t hitIndex;
   };
+  /// Activated cell with merged contributions from all hits.
+  struct ModuleCell
+  {
+    uint64_t    key;
+    std::size_t contributionsBegin;
+    std::size_t contributionsSize;
+  };
+  /// Scratch space to avoid allocations for each module and event.
+  struct ClusteringBuffers
+  {
+    std::vector<CellContribution> contributions;
+    std::vector<ModuleCell>       cells;
+    std::vector<std::size_t>      parents;
+    std::vector<std::size_t>      labels;
+    std::vector<std::size_t>      order;
+    std::vector<std::size_t>      hitIndices;
+    // batched global-to-local transform input and output
+    std::vector<Acts::Vector3D> globalPositions;
+    std::vector<Acts::Vector3D> globalDirections;
+    std::vector<Acts::Vector2D> localPositions;
+    std::vector<Acts::Vector3D> localDirections;
+  };
+
+  /// Build clusters from the collected cell contributions on one module.
+  void
+  clusterModule(const Digitizable&      dg,
+                ClusteringBuffers&      buffers,
+                PlanarClusterContainer& clusters) const;
 
   Config m_cfg;
-  /// Lookup container for all digitizable surfaces
-  std::unordered_map<Acts::GeometryID, Digitizable> m_digitizables;
+  /// Dense table of all digitizable modules ordered by geometry identifier
+  std::vector<Digitizable> m_digitizables;
+  /// Per-thread scratch buffers for the cell clustering
+  mutable tbb::enumerable_thread_specific<ClusteringBuffers> m_buffers;
 };
 
 }  // namespace FW
@@ -11,6 +11,7 @@
 #include <string>
 #include <unordered_map>
 
+#include "ACTFW/Digitization/Resolution.hpp"
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "Acts/Geometry/GeometryID.hpp"
@@ -38,6 +39,9 @@ public:
     /// Width of the Gaussian smearing, i.e. resolution; must be positive.
     double sigmaLoc0 = -1;
     double sigmaLoc1 = -1;
+    /// Optional resolutions per geometry hierarchy level. The global widths
+    /// above are used for modules without a matching entry.
+    ResolutionMap resolutions;
     /// Tracking geometry required to access global-to-local transforms.
     std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry;
     /// Random numbers tool.
@@ -50,9 +54,18 @@ public:
   execute(const AlgorithmContext& ctx) const final override;
 
 private:
+  struct Module
+  {
+    const Acts::Surface* surface   = nullptr;
+    double               sigmaLoc0 = 0.0;
+    double               sigmaLoc1 = 0.0;
+    /// Planar modules use the batched global-to-local transform.
+    bool isPlanar = false;
+  };
+
   Config m_cfg;
-  /// Lookup container for hit surfaces that generate smeared hits
-  std::unordered_map<Acts::GeometryID, const Acts::Surface*> m_surfaces;
+  /// Lookup container for modules that generate smeared hits
+  std::unordered_map<Acts::GeometryID, Module> m_modules;
 };
 
 }  // namespace FW
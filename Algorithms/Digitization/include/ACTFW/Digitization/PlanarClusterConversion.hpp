@@ -0,0 +1,113 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <stdexcept>
+#include <vector>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/EventData/SimIdentifier.hpp"
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+namespace FW {
+
+/// Convert a stored cell to the digitization plugin cell type.
+inline Acts::DigitizationCell
+toDigitizationCell(const PlanarCell& cell)
+{
+  return Acts::DigitizationCell(cell.channel0, cell.channel1, cell.value);
+}
+
+/// Convert a single stored cluster into a full planar module cluster.
+///
+/// @param clusters container that holds the cluster
+/// @param it       position of the cluster within the container
+///
+/// The cluster index within the container is used as the identifier value
+/// and the simulated hit indices are attached as truth information.
+inline Acts::PlanarModuleCluster
+toPlanarModuleCluster(const PlanarClusterContainer&          clusters,
+                      PlanarClusterContainer::const_iterator it)
+{
+  const PlanarCluster& cluster = *it;
+  const auto           index   = clusters.index_of(it);
+
+  std::vector<Acts::DigitizationCell> cells;
+  cells.reserve(cluster.cellsSize);
+  for (const auto& cell : clusters.cells(cluster)) {
+    cells.push_back(toDigitizationCell(cell));
+  }
+  auto hits = clusters.hitIndices(cluster);
+
+  return Acts::PlanarModuleCluster(
+      cluster.surface->getSharedPtr(),
+      Identifier(identifier_type(index),
+                 std::vector<std::size_t>(hits.begin(), hits.end())),
+      cluster.cov,
+      cluster.local0,
+      cluster.local1,
+      cluster.time,
+      std::move(cells));
+}
+
+/// Convert all stored clusters into a geometry map of planar module clusters.
+///
+/// This allocates for every cluster and should only be used to interface with
+/// code that requires the full cluster objects.
+inline GeometryIdMultimap<Acts::PlanarModuleCluster>
+toPlanarModuleClusters(const PlanarClusterContainer& clusters)
+{
+  GeometryIdMultimap<Acts::PlanarModuleCluster> converted;
+  converted.reserve(clusters.size());
+  for (auto it = clusters.begin(); it != clusters.end(); ++it) {
+    // input is ordered by geometry id; always inserts at the end
+    converted.emplace_hint(
+        converted.end(), it->geoId, toPlanarModuleCluster(clusters, it));
+  }
+  return converted;
+}
+
+/// Create a two-dimensional source link from a stored cluster.
+///
+/// @param clusters container that holds the cluster
+/// @param cluster  the cluster to be converted
+/// @param simHits  simulated hits referenced by the cluster hit indices
+/// @throws std::invalid_argument if the cluster has no valid simulated hit
+///
+/// Analogous to the source links created by the `HitSmearing` algorithm the
+/// first associated simulated hit is used as the truth hit.
+inline SimSourceLink
+makeSimSourceLink(const PlanarClusterContainer& clusters,
+                  const PlanarCluster&          cluster,
+                  const SimHitContainer&        simHits)
+{
+  auto hitIndices = clusters.hitIndices(cluster);
+  if (hitIndices.empty()) {
+    throw std::invalid_argument("Cluster without associated simulated hit");
+  }
+  auto hit = simHits.nth(*hitIndices.begin());
+  if (hit == simHits.end()) {
+    throw std::invalid_argument("Cluster with invalid simulated hit index");
+  }
+
+  Acts::BoundVector values = Acts::BoundVector::Zero();
+  values[Acts::eLOC_0]     = cluster.local0;
+  values[Acts::eLOC_1]     = cluster.local1;
+
+  Acts::BoundMatrix cov     = Acts::BoundMatrix::Zero();
+  cov.topLeftCorner<2, 2>() = cluster.cov.topLeftCorner<2, 2>();
+
+  return SimSourceLink(*cluster.surface, *hit, 2, values, cov);
+}
+
+}  // namespace FW
@@ -0,0 +1,41 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <string>
+
+#include "ACTFW/Utilities/GeometryHierarchyMap.hpp"
+
+namespace FW {
+
+/// Measurement resolution in the local frame of a surface.
+struct LocalResolution
+{
+  double sigmaLoc0 = 0.0;
+  double sigmaLoc1 = 0.0;
+  double sigmaTime = 0.0;
+};
+
+/// Resolutions for different parts of the detector.
+using ResolutionMap = GeometryHierarchyMap<LocalResolution>;
+
+/// Read a resolution map from a comma-separated-value file.
+///
+/// @param path is the path to the input file
+/// @throws std::invalid_argument on duplicate or invalid entries
+///
+/// Each line defines the resolution for one hierarchy level using the
+/// columns `volume_id`, `layer_id`, `module_id`, `sigma_loc0`, `sigma_loc1`,
+/// and the optional `sigma_t`. Zero identifiers act as wildcards, i.e. a line
+/// with only the volume id set applies to the whole volume unless a more
+/// specific entry exists. Lengths are in mm and times in ns.
+ResolutionMap
+readResolutionMap(const std::string& path);
+
+}  // namespace FW
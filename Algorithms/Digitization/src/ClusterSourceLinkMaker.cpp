@@ -0,0 +1,67 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Digitization/ClusterSourceLinkMaker.hpp"
+
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "ACTFW/Digitization/PlanarClusterConversion.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+
+FW::ClusterSourceLinkMaker::ClusterSourceLinkMaker(
+    FW::ClusterSourceLinkMaker::Config cfg,
+    Acts::Logging::Level               lvl)
+  : BareAlgorithm("ClusterSourceLinkMaker", lvl), m_cfg(std::move(cfg))
+{
+  if (m_cfg.inputClusters.empty()) {
+    throw std::invalid_argument("Missing input clusters collection");
+  }
+  if (m_cfg.inputSimulatedHits.empty()) {
+    throw std::invalid_argument("Missing input simulated hits collection");
+  }
+  if (m_cfg.outputSourceLinks.empty()) {
+    throw std::invalid_argument("Missing output source links collection");
+  }
+}
+
+FW::ProcessCode
+FW::ClusterSourceLinkMaker::execute(const AlgorithmContext& ctx) const
+{
+  const auto& clusters
+      = ctx.eventStore.get<PlanarClusterContainer>(m_cfg.inputClusters);
+  const auto& hits
+      = ctx.eventStore.get<SimHitContainer>(m_cfg.inputSimulatedHits);
+
+  SimSourceLinkContainer sourceLinks;
+  sourceLinks.reserve(clusters.size());
+  for (const auto& cluster : clusters) {
+    SimSourceLinkContainer::const_iterator it;
+    try {
+      // create source link at the end of the container
+      it = sourceLinks.emplace_hint(sourceLinks.end(),
+                                    makeSimSourceLink(clusters, cluster, hits));
+    } catch (const std::invalid_argument& e) {
+      ACTS_ERROR("Cluster " << sourceLinks.size() << ": " << e.what());
+      return ProcessCode::ABORT;
+    }
+    // ensure clusters and links share the same order
+    if (std::next(it) != sourceLinks.end()) {
+      ACTS_FATAL("The cluster ordering broke. Run for your life.");
+      return ProcessCode::ABORT;
+    }
+  }
+
+  ACTS_DEBUG("Created " << sourceLinks.size() << " source links");
+  ctx.eventStore.add(m_cfg.outputSourceLinks, std::move(sourceLinks));
+  return ProcessCode::SUCCESS;
+}
@@ -8,20 +8,27 @@
 
 #include "ACTFW/Digitization/DigitizationAlgorithm.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
 
 #include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
 #include "ACTFW/EventData/SimHit.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/EventData/SimVertex.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Utilities/BatchedTransform.hpp"
+#include "ACTFW/Utilities/RadixSort.hpp"
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/Geometry/DetectorElementBase.hpp"
 #include "Acts/Geometry/GeometryID.hpp"
 #include "Acts/Geometry/TrackingGeometry.hpp"
 #include "Acts/Plugins/Digitization/DigitizationModule.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
 #include "Acts/Plugins/Digitization/PlanarModuleStepper.hpp"
 #include "Acts/Plugins/Digitization/Segmentation.hpp"
 #include "Acts/Plugins/Identification/IdentifiedDetectorElement.hpp"
@@ -29,6 +36,15 @@
 #include "Acts/Utilities/ParameterDefinitions.hpp"
 #include "Acts/Utilities/Units.hpp"
 
+namespace {
+// fixed resolution for modules without a configured one
+const FW::LocalResolution kDefaultResolution = {
+    std::sqrt(0.05) * Acts::UnitConstants::mm,
+    std::sqrt(0.05) * Acts::UnitConstants::mm,
+    30. * Acts::UnitConstants::ps,
+};
+}  // namespace
+
 FW::DigitizationAlgorithm::DigitizationAlgorithm(
     FW::DigitizationAlgorithm::Config cfg,
     Acts::Logging::Level              lvl)
@@ -49,7 +65,10 @@ FW::DigitizationAlgorithm::DigitizationAlgorithm(
   if (!m_cfg.randomNumbers) {
     throw std::invalid_argument("Missing random numbers tool");
   }
-  // fill the digitizables map to allow lookup by geometry id only
+  if ((m_cfg.connectivity != 4u) and (m_cfg.connectivity != 8u)) {
+    throw std::invalid_argument("Cell connectivity must be either 4 or 8");
+  }
+  // fill the digitizables table to allow lookup by geometry id only
   m_cfg.trackingGeometry->visitSurfaces([this](const Acts::Surface* surface) {
     Digitizable dg;
     // require a valid surface
@@ -62,9 +81,198 @@ FW::DigitizationAlgorithm::DigitizationAlgorithm(
     // require an associated digitization module
     dg.digitizer = dg.detectorElement->digitizationModule().get();
     if (not dg.digitizer) { return; }
+    // precompute the lorentz shift that is identical for all hits
+    dg.lorentzShift = dg.detectorElement->thickness()
+                      * std::tan(dg.digitizer->lorentzAngle())
+                      * -(dg.digitizer->readoutDirection());
+    // resolve the cluster resolution once for each module
+    const auto* res = m_cfg.resolutions.find(surface->geoID());
+    dg.resolution   = res ? *res : kDefaultResolution;
     // record all valid surfaces
-    this->m_digitizables.insert_or_assign(surface->geoID(), dg);
+    dg.geoId = surface->geoID();
+    this->m_digitizables.push_back(dg);
+  });
+  // the table is searched in the same order as the hits
+  std::stable_sort(m_digitizables.begin(),
+                   m_digitizables.end(),
+                   [](const Digitizable& lhs, const Digitizable& rhs) {
+                     return lhs.geoId < rhs.geoId;
+                   });
+  auto duplicates = std::unique(
+      m_digitizables.begin(),
+      m_digitizables.end(),
+      [](const Digitizable& lhs, const Digitizable& rhs) {
+        return lhs.geoId == rhs.geoId;
+      });
+  if (duplicates != m_digitizables.end()) {
+    throw std::invalid_argument("Duplicate digitizable module identifiers");
+  }
+  ACTS_DEBUG("Prepared " << m_digitizables.size() << " digitizable modules");
+}
+
+namespace {
+// uncorrelated covariance from the module resolution
+inline void
+setCovariance(FW::PlanarCluster& cluster, const FW::LocalResolution& res)
+{
+  cluster.cov       = Acts::ActsSymMatrixD<3>::Zero();
+  cluster.cov(0, 0) = res.sigmaLoc0 * res.sigmaLoc0;
+  cluster.cov(1, 1) = res.sigmaLoc1 * res.sigmaLoc1;
+  cluster.cov(2, 2) = res.sigmaTime * res.sigmaTime;
+}
+
+// encode the two channel numbers into a single sortable key
+constexpr uint64_t
+cellKey(uint64_t channel0, uint64_t channel1)
+{
+  return (channel0 << 32) | channel1;
+}
+
+// find the representative of the set and compress the path along the way
+inline std::size_t
+findRoot(std::vector<std::size_t>& parents, std::size_t i)
+{
+  while (parents[i] != i) {
+    parents[i] = parents[parents[i]];
+    i          = parents[i];
+  }
+  return i;
+}
+
+// merge two sets; the smaller index becomes the root to be deterministic
+inline void
+mergeSets(std::vector<std::size_t>& parents, std::size_t i, std::size_t j)
+{
+  i = findRoot(parents, i);
+  j = findRoot(parents, j);
+  if (i < j) {
+    parents[j] = i;
+  } else if (j < i) {
+    parents[i] = j;
+  }
+}
+}  // namespace
+
+void
+FW::DigitizationAlgorithm::clusterModule(const Digitizable&      dg,
+                                         ClusteringBuffers&      buffers,
+                                         PlanarClusterContainer& clusters) const
+{
+  auto& contributions = buffers.contributions;
+  auto& cells         = buffers.cells;
+  auto& parents       = buffers.parents;
+  auto& labels        = buffers.labels;
+  auto& order         = buffers.order;
+  auto& hitIndices    = buffers.hitIndices;
+  if (contributions.empty()) { return; }
+
+  // group contributions to the same cell. the sort is stable and the hits
+  // were added in container order, i.e. the result is reproducible.
+  radixSort(contributions, [](const CellContribution& c) {
+    return cellKey(c.channel0, c.channel1);
+  });
+
+  // merge duplicate cells; each cell stores the start of its contributions
+  cells.clear();
+  for (std::size_t i = 0; i < contributions.size(); ++i) {
+    const auto key = cellKey(contributions[i].channel0,
+                             contributions[i].channel1);
+    if (cells.empty() or (cells.back().key != key)) {
+      cells.push_back({key, i, 0u});
+    }
+    cells.back().contributionsSize += 1;
+  }
+
+  // connected components labeling on the sparse cell grid. cells are sorted
+  // by (channel0, channel1) and only neighbours with larger keys need to be
+  // considered to find all connections.
+  parents.resize(cells.size());
+  std::iota(parents.begin(), parents.end(), 0u);
+  auto findCell = [&](std::size_t from, uint64_t key) -> std::size_t {
+    auto it = std::lower_bound(
+        std::next(cells.begin(), from),
+        cells.end(),
+        key,
+        [](const auto& cell, uint64_t k) { return cell.key < k; });
+    return std::distance(cells.begin(), it);
+  };
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    const uint64_t ch0 = cells[i].key >> 32;
+    const uint64_t ch1 = cells[i].key & 0xffffffffu;
+    // next cell in the same row
+    const auto next = i + 1;
+    if ((next < cells.size()) and (cells[next].key == cellKey(ch0, ch1 + 1))) {
+      mergeSets(parents, i, next);
+    }
+    // neighbours in the next row are stored contiguously
+    const bool     corners = (m_cfg.connectivity == 8u);
+    const uint64_t lo      = (corners and (0u < ch1)) ? (ch1 - 1) : ch1;
+    const uint64_t hi      = corners ? (ch1 + 1) : ch1;
+    for (auto j = findCell(i + 1, cellKey(ch0 + 1, lo));
+         (j < cells.size()) and (cells[j].key <= cellKey(ch0 + 1, hi));
+         ++j) {
+      mergeSets(parents, i, j);
+    }
+  }
+
+  // assign consecutive labels in order of the first cell of each cluster
+  labels.assign(cells.size(), SIZE_MAX);
+  std::size_t numLabels = 0u;
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    auto root = findRoot(parents, i);
+    if (labels[root] == SIZE_MAX) { labels[root] = numLabels++; }
+    labels[i] = labels[root];
+  }
+  // order cells by label, keeping the cell order within each cluster
+  order.resize(cells.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+    return labels[lhs] < labels[rhs];
   });
+
+  // build one cluster per connected component
+  for (auto beg = order.begin(); beg != order.end();) {
+    auto end = std::find_if(
+        beg, order.end(), [&](auto i) { return labels[i] != labels[*beg]; });
+
+    double localX    = 0.;
+    double localY    = 0.;
+    double totalPath = 0.;
+    double time      = std::numeric_limits<double>::max();
+    hitIndices.clear();
+    for (auto ic = beg; ic != end; ++ic) {
+      const ModuleCell& cell     = cells[*ic];
+      double            cellPath = 0.;
+      for (std::size_t k = 0; k < cell.contributionsSize; ++k) {
+        const auto& contrib = contributions[cell.contributionsBegin + k];
+        localX += contrib.pathLength * contrib.center0;
+        localY += contrib.pathLength * contrib.center1;
+        cellPath += contrib.pathLength;
+        time = std::min(time, contrib.time);
+        hitIndices.push_back(contrib.hitIndex);
+      }
+      totalPath += cellPath;
+      clusters.addCell({static_cast<uint32_t>(cell.key >> 32),
+                        static_cast<uint32_t>(cell.key & 0xffffffffu),
+                        static_cast<float>(cellPath)});
+    }
+    // record each contributing hit only once
+    std::sort(hitIndices.begin(), hitIndices.end());
+    hitIndices.erase(std::unique(hitIndices.begin(), hitIndices.end()),
+                     hitIndices.end());
+    for (auto idx : hitIndices) { clusters.addHitIndex(idx); }
+
+    PlanarCluster cluster;
+    cluster.geoId   = dg.surface->geoID();
+    cluster.surface = dg.surface;
+    cluster.local0  = localX / totalPath + dg.lorentzShift;
+    cluster.local1  = localY / totalPath;
+    cluster.time    = time;
+    setCovariance(cluster, dg.resolution);
+    clusters.finishCluster(std::move(cluster));
+
+    beg = end;
+  }
 }
 
 FW::ProcessCode
@@ -73,32 +281,56 @@ FW::DigitizationAlgorithm::execute(const AlgorithmContext& ctx) const
   // Prepare the input and output collections
   const auto& hits
       = ctx.eventStore.get<SimHitContainer>(m_cfg.inputSimulatedHits);
-  FW::GeometryIdMultimap<Acts::PlanarModuleCluster> clusters;
+  PlanarClusterContainer clusters;
+  // at most one cluster and truth hit per hit; a few cells per cluster
+  const auto numClusters = ctx.capacityHint(m_cfg.outputClusters, hits.size());
+  clusters.reserve(numClusters, 4 * numClusters, numClusters);
+  // per-thread scratch buffers; reused for all modules and events
+  ClusteringBuffers& buffers = m_buffers.local();
 
+  // modules and the table are both ordered by geometry identifier, i.e. each
+  // lookup only searches the table after the previous module
+  auto table = m_digitizables.begin();
   for (auto&& [moduleGeoId, moduleHits] : groupByModule(hits)) {
+    table = std::lower_bound(table,
+                             m_digitizables.end(),
+                             moduleGeoId,
+                             [](const Digitizable& dg, Acts::GeometryID id) {
+                               return dg.geoId < id;
+                             });
     // can only digitize hits on digitizable surfaces
-    const auto it = m_digitizables.find(moduleGeoId);
-    if (it == m_digitizables.end()) { continue; }
+    if ((table == m_digitizables.end()) or (table->geoId != moduleGeoId)) {
+      continue;
+    }
 
-    const auto& dg = it->second;
-    // local intersection / direction
+    const auto& dg = *table;
+    // local intersection / direction. the transform depends on the event
+    // geometry context, e.g. for alignment, and can not be precomputed.
+    // all hits on the module are transformed together in one batch.
     const auto invTransfrom = dg.surface->transform(ctx.geoContext).inverse();
+    buffers.globalPositions.clear();
+    buffers.globalDirections.clear();
+    for (const auto& hit : moduleHits) {
+      buffers.globalPositions.push_back(hit.position());
+      buffers.globalDirections.push_back(hit.unitDirection());
+    }
+    transformToLocal(
+        invTransfrom, buffers.globalPositions, buffers.localPositions);
+    rotateToLocal(
+        invTransfrom, buffers.globalDirections, buffers.localDirections);
+    buffers.contributions.clear();
 
     // use iterators manually so we can retrieve the hit index in the container
+    std::size_t ilocal = 0;
     for (auto ih = moduleHits.begin(); ih != moduleHits.end(); ++ih) {
       const auto& hit = *ih;
       const auto  idx = hits.index_of(ih);
 
-      Acts::Vector2D localIntersect = (invTransfrom * hit.position()).head<2>();
-      Acts::Vector3D localDirection
-          = invTransfrom.linear() * hit.unitDirection();
+      const Acts::Vector2D& localIntersect = buffers.localPositions[ilocal];
+      const Acts::Vector3D& localDirection = buffers.localDirections[ilocal];
+      ++ilocal;
 
-      // compute digitization steps
-      const auto thickness    = dg.detectorElement->thickness();
-      const auto lorentzAngle = dg.digitizer->lorentzAngle();
-      auto       lorentzShift = thickness * std::tan(lorentzAngle);
-      lorentzShift *= -(dg.digitizer->readoutDirection());
-      // now calculate the steps through the silicon
+      // calculate the steps through the silicon
       std::vector<Acts::DigitizationStep> dSteps
           = m_cfg.planarModuleStepper->cellSteps(
               ctx.geoContext, *dg.digitizer, localIntersect, localDirection);
@@ -108,56 +340,57 @@ FW::DigitizationAlgorithm::execute(const AlgorithmContext& ctx) const
         continue;
       }
 
+      // collect the cells of all hits and cluster them later on
+      if (m_cfg.mergeHits) {
+        for (const auto& dStep : dSteps) {
+          buffers.contributions.push_back(
+              {static_cast<uint32_t>(dStep.stepCell.channel0),
+               static_cast<uint32_t>(dStep.stepCell.channel1),
+               dStep.stepLength,
+               dStep.stepCellCenter.x(),
+               dStep.stepCellCenter.y(),
+               hit.time(),
+               idx});
+        }
+        continue;
+      }
+
       // lets create a cluster - centroid method
       double localX    = 0.;
       double localY    = 0.;
       double totalPath = 0.;
-      // the cells to be used
-      std::vector<Acts::DigitizationCell> usedCells;
-      usedCells.reserve(dSteps.size());
-      // loop over the steps
-      for (auto dStep : dSteps) {
+      // loop over the steps; the cells are added directly to the store
+      for (const auto& dStep : dSteps) {
         // @todo implement smearing
         localX += dStep.stepLength * dStep.stepCellCenter.x();
         localY += dStep.stepLength * dStep.stepCellCenter.y();
         totalPath += dStep.stepLength;
-        usedCells.push_back(Acts::DigitizationCell(dStep.stepCell.channel0,
-                                                   dStep.stepCell.channel1,
-                                                   dStep.stepLength));
+        clusters.addCell({static_cast<uint32_t>(dStep.stepCell.channel0),
+                          static_cast<uint32_t>(dStep.stepCell.channel1),
+                          static_cast<float>(dStep.stepLength)});
       }
       // divide by the total path
       localX /= totalPath;
-      localX += lorentzShift;
+      localX += dg.lorentzShift;
       localY /= totalPath;
 
-      // get the segmentation & find the corresponding cell id
-      const Acts::Segmentation& segmentation = dg.digitizer->segmentation();
-      auto                      binUtility   = segmentation.binUtility();
-      Acts::Vector2D            localPosition(localX, localY);
-      // @todo remove unneccesary conversion
-      size_t bin0          = binUtility.bin(localPosition, 0);
-      size_t bin1          = binUtility.bin(localPosition, 1);
-      size_t binSerialized = binUtility.serialize({{bin0, bin1, 0}});
-
-      // the covariance is currently set to 0.
-      Acts::ActsSymMatrixD<3> cov;
-      cov << 0.05, 0., 0., 0., 0.05, 0., 0., 0.,
-          900. * Acts::UnitConstants::ps * Acts::UnitConstants::ps;
-
       // create the planar cluster
-      Acts::PlanarModuleCluster pCluster(
-          dg.surface->getSharedPtr(),
-          Identifier(identifier_type(idx), {idx}),
-          std::move(cov),
-          localX,
-          localY,
-          hit.time(),
-          std::move(usedCells));
+      PlanarCluster cluster;
+      cluster.geoId   = hit.geometryId();
+      cluster.surface = dg.surface;
+      cluster.local0  = localX;
+      cluster.local1  = localY;
+      cluster.time    = hit.time();
+      setCovariance(cluster, dg.resolution);
 
       // insert into the cluster container. since the input data is already
       // sorted by geoId, we should always be able to add at the end.
-      clusters.emplace_hint(
-          clusters.end(), hit.geometryId(), std::move(pCluster));
+      clusters.addHitIndex(idx);
+      clusters.finishCluster(std::move(cluster));
+    }
+
+    if (m_cfg.mergeHits) {
+      clusterModule(dg, buffers, clusters);
     }
   }
 
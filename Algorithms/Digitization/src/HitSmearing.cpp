@@ -12,7 +12,9 @@
 #include "ACTFW/EventData/SimHit.hpp"
 #include "ACTFW/EventData/SimSourceLink.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Utilities/BatchedTransform.hpp"
 #include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/Definitions.hpp"
 
 FW::HitSmearing::HitSmearing(const Config& cfg, Acts::Logging::Level lvl)
@@ -24,7 +26,9 @@ FW::HitSmearing::HitSmearing(const Config& cfg, Acts::Logging::Level lvl)
   if (m_cfg.outputSourceLinks.empty()) {
     throw std::invalid_argument("Missing output source links collection");
   }
-  if ((m_cfg.sigmaLoc0 < 0) or (m_cfg.sigmaLoc1 < 0)) {
+  const bool hasGlobalResolution
+      = (0 <= m_cfg.sigmaLoc0) and (0 <= m_cfg.sigmaLoc1);
+  if (not hasGlobalResolution and m_cfg.resolutions.empty()) {
     throw std::invalid_argument("Invalid resolution setting");
   }
   if (not m_cfg.trackingGeometry) {
@@ -33,11 +37,25 @@ FW::HitSmearing::HitSmearing(const Config& cfg, Acts::Logging::Level lvl)
   if (!m_cfg.randomNumbers) {
     throw std::invalid_argument("Missing random numbers tool");
   }
-  // fill the surface map to allow lookup by geometry id only
-  m_cfg.trackingGeometry->visitSurfaces([this](const Acts::Surface* surface) {
+  // fill the module map to allow lookup by geometry id only. resolutions are
+  // resolved once here so no additional lookup is needed for each hit.
+  m_cfg.trackingGeometry->visitSurfaces([&](const Acts::Surface* surface) {
     // for now we just require a valid surface
     if (not surface) { return; }
-    this->m_surfaces.insert_or_assign(surface->geoID(), surface);
+    Module module;
+    module.surface  = surface;
+    module.isPlanar = (surface->type() == Acts::Surface::Plane);
+    if (const auto* res = m_cfg.resolutions.find(surface->geoID())) {
+      module.sigmaLoc0 = res->sigmaLoc0;
+      module.sigmaLoc1 = res->sigmaLoc1;
+    } else if (hasGlobalResolution) {
+      module.sigmaLoc0 = m_cfg.sigmaLoc0;
+      module.sigmaLoc1 = m_cfg.sigmaLoc1;
+    } else {
+      ACTS_DEBUG("No resolution for surface " << surface->geoID());
+      return;
+    }
+    m_modules.insert_or_assign(surface->geoID(), module);
   });
 }
 
@@ -54,30 +72,51 @@ FW::HitSmearing::execute(const AlgorithmContext& ctx) const
   auto rng = m_cfg.randomNumbers->spawnGenerator(ctx);
   std::normal_distribution<double> stdNormal(0.0, 1.0);
 
-  // setup local covariance
-  // TODO add support for per volume/layer/module settings
-  Acts::BoundMatrix cov           = Acts::BoundMatrix::Zero();
-  cov(Acts::eLOC_0, Acts::eLOC_0) = m_cfg.sigmaLoc0 * m_cfg.sigmaLoc0;
-  cov(Acts::eLOC_1, Acts::eLOC_1) = m_cfg.sigmaLoc1 * m_cfg.sigmaLoc1;
+  // local positions are computed per module; buffers are reused
+  std::vector<Acts::Vector3D> globalPositions;
+  std::vector<Acts::Vector2D> localPositions;
 
   for (auto&& [moduleGeoId, moduleHits] : groupByModule(hits)) {
     // check if we should create hits for this surface
-    const auto is = m_surfaces.find(moduleGeoId);
-    if (is == m_surfaces.end()) { continue; }
+    const auto im = m_modules.find(moduleGeoId);
+    if (im == m_modules.end()) { continue; }
+
+    const Module&        module  = im->second;
+    const Acts::Surface* surface = module.surface;
+
+    // setup local covariance for this module
+    Acts::BoundMatrix cov           = Acts::BoundMatrix::Zero();
+    cov(Acts::eLOC_0, Acts::eLOC_0) = module.sigmaLoc0 * module.sigmaLoc0;
+    cov(Acts::eLOC_1, Acts::eLOC_1) = module.sigmaLoc1 * module.sigmaLoc1;
+
+    // transform all global positions into local coordinates at once
+    localPositions.clear();
+    if (module.isPlanar) {
+      globalPositions.clear();
+      for (const auto& hit : moduleHits) {
+        globalPositions.push_back(hit.position());
+      }
+      transformToLocal(surface->transform(ctx.geoContext).inverse(),
+                       globalPositions,
+                       localPositions);
+    } else {
+      for (const auto& hit : moduleHits) {
+        Acts::Vector2D pos(0, 0);
+        surface->globalToLocal(
+            ctx.geoContext, hit.position(), hit.unitDirection(), pos);
+        localPositions.push_back(pos);
+      }
+    }
 
     // smear all truth hits for this module
-    const Acts::Surface* surface = is->second;
+    std::size_t ihit = 0;
     for (const auto& hit : moduleHits) {
-
-      // transform global position into local coordinates
-      Acts::Vector2D pos(0, 0);
-      surface->globalToLocal(
-          ctx.geoContext, hit.position(), hit.unitDirection(), pos);
+      const Acts::Vector2D& pos = localPositions[ihit++];
 
       // smear truth to create local measurement
       Acts::BoundVector loc = Acts::BoundVector::Zero();
-      loc[Acts::eLOC_0]     = pos[0] + m_cfg.sigmaLoc0 * stdNormal(rng);
-      loc[Acts::eLOC_1]     = pos[1] + m_cfg.sigmaLoc1 * stdNormal(rng);
+      loc[Acts::eLOC_0]     = pos[0] + module.sigmaLoc0 * stdNormal(rng);
+      loc[Acts::eLOC_1]     = pos[1] + module.sigmaLoc1 * stdNormal(rng);
 
       // create source link at the end of the container
       auto it = sourceLinks.emplace_hint(
@@ -0,0 +1,69 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Digitization/Resolution.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <dfe/dfe_io_dsv.hpp>
+#include <dfe/dfe_namedtuple.hpp>
+
+#include "Acts/Utilities/Units.hpp"
+
+namespace {
+struct ResolutionData
+{
+  uint64_t volume_id;
+  uint64_t layer_id;
+  uint64_t module_id;
+  double   sigma_loc0;
+  double   sigma_loc1;
+  double   sigma_t = 0.0;
+
+  DFE_NAMEDTUPLE(ResolutionData,
+                 volume_id,
+                 layer_id,
+                 module_id,
+                 sigma_loc0,
+                 sigma_loc1,
+                 sigma_t);
+};
+}  // namespace
+
+FW::ResolutionMap
+FW::readResolutionMap(const std::string& path)
+{
+  dfe::NamedTupleCsvReader<ResolutionData> reader(path, {"sigma_t"});
+
+  std::vector<ResolutionMap::InputElement> elements;
+  ResolutionData                           data;
+  while (reader.read(data)) {
+    if ((data.sigma_loc0 < 0) or (data.sigma_loc1 < 0) or (data.sigma_t < 0)) {
+      throw std::invalid_argument("Negative resolution in '" + path + "'");
+    }
+    // a module requires a layer and a layer requires a volume
+    if (((data.module_id != 0u) and (data.layer_id == 0u))
+        or ((data.layer_id != 0u) and (data.volume_id == 0u))) {
+      throw std::invalid_argument("Invalid geometry hierarchy in '" + path
+                                  + "'");
+    }
+    Acts::GeometryID geoId;
+    geoId.setVolume(data.volume_id);
+    geoId.setLayer(data.layer_id);
+    geoId.setSensitive(data.module_id);
+
+    LocalResolution resolution;
+    resolution.sigmaLoc0 = data.sigma_loc0 * Acts::UnitConstants::mm;
+    resolution.sigmaLoc1 = data.sigma_loc1 * Acts::UnitConstants::mm;
+    resolution.sigmaTime = data.sigma_t * Acts::UnitConstants::ns;
+    elements.emplace_back(geoId, resolution);
+  }
+  return ResolutionMap(std::move(elements));
+}
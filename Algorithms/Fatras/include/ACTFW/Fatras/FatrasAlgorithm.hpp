@@ -73,11 +73,15 @@ public:
     SimParticleContainer::sequence_type particlesInitialUnordered;
     SimParticleContainer::sequence_type particlesFinalUnordered;
     SimHitContainer::sequence_type      hitsUnordered;
-    // reserve appropriate resources
+    // reserve appropriate resources. use the sizes from previous events if
+    // available and fall back to static estimates otherwise.
     constexpr auto meanHitsPerParticle = 16u;
-    particlesInitialUnordered.reserve(inputParticles.size());
-    particlesFinalUnordered.reserve(inputParticles.size());
-    hitsUnordered.reserve(meanHitsPerParticle * inputParticles.size());
+    particlesInitialUnordered.reserve(ctx.capacityHint(
+        m_cfg.outputParticlesInitial, inputParticles.size()));
+    particlesFinalUnordered.reserve(
+        ctx.capacityHint(m_cfg.outputParticlesFinal, inputParticles.size()));
+    hitsUnordered.reserve(ctx.capacityHint(
+        m_cfg.outputHits, meanHitsPerParticle * inputParticles.size()));
 
     // run the simulation w/ a local random generator
     auto rng = m_cfg.randomNumbers->spawnGenerator(ctx);
@@ -116,10 +120,10 @@ public:
     // restore ordering for output containers
     SimParticleContainer particlesInitial;
     SimParticleContainer particlesFinal;
-    SimHitContainer      hits;
     particlesInitial.adopt_sequence(std::move(particlesInitialUnordered));
     particlesFinal.adopt_sequence(std::move(particlesFinalUnordered));
-    hits.adopt_sequence(std::move(hitsUnordered));
+    // hits are the largest collection; use the linear-time sort
+    SimHitContainer hits = makeGeometryIdMultiset(std::move(hitsUnordered));
 
     // store ordered output containers
     ctx.eventStore.add(m_cfg.outputParticlesInitial,
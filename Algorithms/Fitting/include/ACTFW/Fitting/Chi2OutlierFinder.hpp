@@ -0,0 +1,71 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+#include <Eigen/Core>
+#include <Eigen/Cholesky>
+
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+
+namespace FW {
+
+/// Outlier finder for the Kalman fitter based on the predicted chi2.
+///
+/// A measurement is flagged as an outlier if the chi2 of its residual with
+/// respect to the predicted track parameters exceeds the configured maximum.
+/// With the default, infinite maximum no measurement is ever flagged and the
+/// chi2 is not computed, i.e. it behaves like the `Acts::VoidOutlierFinder`.
+///
+/// The finder is the only configurable part of the Kalman fitter options and
+/// also carries the track quality limits. A fitter that can stop a track
+/// early, e.g. the `LockstepKalmanFitter`, aborts tracks that can not pass
+/// them anymore. The regular `Acts::KalmanFitter` has no hook to stop the
+/// propagation from its options; the limits are then only applied after the
+/// fit.
+struct Chi2OutlierFinder
+{
+  /// Maximum chi2 for a measurement to be used in the fit.
+  double chi2Max = std::numeric_limits<double>::infinity();
+  /// Maximum number of consecutive outliers along the track.
+  std::size_t maxConsecutiveOutliers = std::numeric_limits<std::size_t>::max();
+  /// Maximum chi2/ndf of the track.
+  double chi2NdfMax = std::numeric_limits<double>::infinity();
+
+  template <typename track_state_t>
+  bool
+  operator()(const track_state_t& state) const
+  {
+    if (chi2Max == std::numeric_limits<double>::infinity()) { return false; }
+    if (not state.hasCalibrated() or not state.hasPredicted()) { return false; }
+
+    // the measurement dimension is only known at runtime. use fixed-size
+    // storage with dynamic extents to avoid allocations.
+    constexpr int kMax = Acts::eBoundParametersSize;
+    using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1, 0, kMax, 1>;
+    using Matrix
+        = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, 0, kMax, kMax>;
+    using Projector = Eigen::
+        Matrix<double, Eigen::Dynamic, Acts::eBoundParametersSize, 0, kMax>;
+
+    const auto      size = state.calibratedSize();
+    const Projector H
+        = state.projector().topLeftCorner(size, Acts::eBoundParametersSize);
+    const Vector residual
+        = state.calibrated().head(size) - H * state.predicted();
+    const Matrix cov = state.calibratedCovariance().topLeftCorner(size, size)
+        + H * state.predictedCovariance() * H.transpose();
+    const double chi2 = residual.dot(cov.ldlt().solve(residual));
+    return chi2Max < chi2;
+  }
+};
+
+}  // namespace FW
@@ -8,12 +8,16 @@
 
 #pragma once
 
+#include <cstddef>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "ACTFW/EventData/SimSourceLink.hpp"
 #include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Fitting/Chi2OutlierFinder.hpp"
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "ACTFW/Plugins/BField/BFieldOptions.hpp"
 #include "Acts/Fitter/KalmanFitter.hpp"
@@ -30,7 +34,15 @@ public:
   using FitterFunction = std::function<FitterResult(
       const std::vector<SimSourceLink>&,
       const TrackParameters&,
-      const Acts::KalmanFitterOptions<Acts::VoidOutlierFinder>&)>;
+      const Acts::KalmanFitterOptions<Chi2OutlierFinder>&)>;
+  /// Fit function that fits a batch of tracks at once. Tracks without a
+  /// result could not be fitted in the batch and are refitted with the
+  /// regular fit function.
+  using BatchFitterFunction
+      = std::function<std::vector<std::optional<FitterResult>>(
+          const std::vector<std::vector<SimSourceLink>>&,
+          const std::vector<TrackParameters>&,
+          const Acts::KalmanFitterOptions<Chi2OutlierFinder>&)>;
 
   /// Create the fitter function implementation.
   ///
@@ -42,6 +54,18 @@ public:
       Options::BFieldVariant                        magneticField,
       Acts::Logging::Level                          lvl);
 
+  /// Create the lockstep fitter function implementation.
+  ///
+  /// @param lanes The number of tracks per batch; must be 4, 8, or 16
+  /// @param smoothing Whether to smooth or to only run the forward filter
+  static BatchFitterFunction
+  makeLockstepFitterFunction(
+      std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry,
+      Options::BFieldVariant                        magneticField,
+      std::size_t                                   lanes,
+      bool                                          smoothing,
+      Acts::Logging::Level                          lvl);
+
   struct Config
   {
     /// Input source links collection.
@@ -54,6 +78,28 @@ public:
     std::string outputTrajectories;
     /// Type erased fitter function.
     FitterFunction fit;
+    /// Minimum number of tracks per parallel task within an event; zero
+    /// disables the intra-event parallelism and fits all tracks serially.
+    std::size_t minTracksPerTask = 0u;
+    /// Number of tracks fitted in lockstep with the batch fit function; zero
+    /// fits each track separately with the regular fit function. Must not
+    /// exceed the number of lanes of the batch fit function.
+    std::size_t lockstepLanes = 0u;
+    /// Type erased lockstep fitter function; required for lockstep lanes.
+    BatchFitterFunction fitBatch;
+    /// Maximum predicted chi2 for a measurement before it is flagged as an
+    /// outlier; infinite disables the outlier rejection.
+    double outlierChi2Max = std::numeric_limits<double>::infinity();
+    /// Maximum chi2/ndf of the fitted track; worse tracks are discarded.
+    /// The lockstep fitter stops tracks once they can not pass anymore; the
+    /// regular fitter applies it after the fit.
+    double chi2NdfMax = std::numeric_limits<double>::infinity();
+    /// Maximum number of consecutive outliers along the fitted track; tracks
+    /// with longer sequences of outliers are discarded. The lockstep fitter
+    /// stops tracks when the limit is exceeded; the regular fitter applies it
+    /// after the fit.
+    std::size_t maxConsecutiveOutliers
+        = std::numeric_limits<std::size_t>::max();
   };
 
   /// Constructor of the fitting algorithm
@@ -71,6 +117,8 @@ public:
 
 private:
   Config m_cfg;
+  /// Target surface for the fitted parameters; shared by all events.
+  std::shared_ptr<const Acts::Surface> m_perigeeSurface;
 };
 
 }  // namespace FW
@@ -0,0 +1,175 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Fitting/Chi2OutlierFinder.hpp"
+#include "Acts/EventData/MultiTrajectory.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Fitter/KalmanFitter.hpp"
+#include "Acts/Propagator/AbortList.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/MaterialInteractor.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+#include "Acts/Utilities/Result.hpp"
+
+namespace FW {
+
+/// Kalman fitter that fits a batch of tracks in lockstep.
+///
+/// Each track occupies one lane. All lanes advance together from one
+/// measurement to the next: every lane is propagated to its next measurement
+/// surface, then the gain-matrix update runs for all lanes at once on
+/// structure-of-arrays blocks with the lane index as the innermost, i.e.
+/// vectorizable, dimension. The Rauch-Tung-Striebel smoother runs backwards
+/// over the stored blocks in the same way. Lanes with fewer measurements are
+/// masked once they are finished.
+///
+/// The propagation itself is performed per lane with the regular propagator;
+/// the stepper and navigator only handle single tracks. The measurements of a
+/// lane are visited in order of their distance to the initial position and
+/// must be reached one after the other. A lane falls back, i.e. is returned
+/// without a result so it can be fitted with the scalar fitter, if
+///
+/// - a measurement is not a two-dimensional local position measurement,
+/// - the initial parameters have no covariance,
+/// - a propagation fails, e.g. because the navigation diverged from the
+///   expected sequence of surfaces,
+/// - the update or the smoother gives non-finite results, or
+/// - the extrapolation to the reference surface fails.
+///
+/// Tracks are aborted early, i.e. without further propagation and smoothing,
+/// once they can not pass the consecutive outlier or the chi2/ndf limits of
+/// the outlier finder anymore. They are returned as an `operation_canceled`
+/// error. The chi2 limit uses the largest possible final ndf and is exact
+/// unless later outliers would reduce the final ndf to zero or below.
+///
+/// Without smoothing, the states only contain the predicted and filtered
+/// parameters and the reference parameters are extrapolated backwards from
+/// the last filtered state.
+///
+/// @tparam propagator_t The propagator type
+/// @tparam kLanes The maximum number of tracks per batch
+template <typename propagator_t, std::size_t kLanes>
+class LockstepKalmanFitter
+{
+public:
+  using FitterResult
+      = Acts::Result<Acts::KalmanFitterResult<SimSourceLink>>;
+  using Options = Acts::KalmanFitterOptions<Chi2OutlierFinder>;
+
+  /// Construct the fitter.
+  ///
+  /// @param propagator The propagator used for each lane
+  /// @param smoothing Whether to run the smoother after the forward filter
+  /// @param logger The logging instance
+  LockstepKalmanFitter(propagator_t                        propagator,
+                       bool                                smoothing,
+                       std::unique_ptr<const Acts::Logger> logger);
+
+  /// Fit a batch of tracks.
+  ///
+  /// @param sourceLinks The measurements of each track
+  /// @param initialParameters The initial parameters of each track
+  /// @param options The fitter options shared by all tracks
+  /// @return One entry per track; empty for tracks that fell back
+  std::vector<std::optional<FitterResult>>
+  fit(const std::vector<std::vector<SimSourceLink>>& sourceLinks,
+      const std::vector<TrackParameters>&            initialParameters,
+      const Options&                                 options) const;
+
+private:
+  static constexpr std::size_t kSize = Acts::eBoundParametersSize;
+
+  /// Track parameters and covariances of all lanes on one step.
+  struct LaneStates
+  {
+    double params[kSize][kLanes];
+    double cov[kSize][kSize][kLanes];
+  };
+
+  /// All lockstep data for one step, i.e. one measurement per lane.
+  struct Step
+  {
+    LaneStates predicted;
+    LaneStates filtered;
+    LaneStates smoothed;
+    /// Transport jacobian from the previous step
+    double jacobian[kSize][kSize][kLanes];
+    /// Local measurement and its covariance
+    double meas[2][kLanes];
+    double measCov[2][2][kLanes];
+    /// Filtered chi2 of the measurement
+    double chi2[kLanes];
+    /// Zero for lanes without a measurement on this step or for outliers
+    double gain[kLanes];
+    double pathLength[kLanes];
+
+    /// Reset all lanes to finite neutral values.
+    void
+    reset();
+  };
+
+  propagator_t                        m_propagator;
+  bool                                m_smoothing;
+  std::unique_ptr<const Acts::Logger> m_logger;
+
+  const Acts::Logger&
+  logger() const
+  {
+    return *m_logger;
+  }
+
+  /// Gain-matrix update of all lanes for one step.
+  ///
+  /// Measurements with a predicted chi2 above the maximum are outliers and
+  /// their gain is set to zero.
+  static void
+  update(Step& step, double chi2Max);
+
+  /// Smooth the step with the already smoothed following step.
+  static void
+  smooth(Step& step, const Step& next);
+
+  /// Write the parameters and covariance of one lane.
+  static void
+  store(LaneStates&                 states,
+        std::size_t                 lane,
+        const Acts::BoundVector&    params,
+        const Acts::BoundSymMatrix& cov);
+
+  /// Read the parameters and covariance of one lane.
+  static void
+  load(const LaneStates&     states,
+       std::size_t           lane,
+       Acts::BoundVector&    params,
+       Acts::BoundSymMatrix& cov);
+};
+
+#include "LockstepKalmanFitter.ipp"
+
+}  // namespace FW
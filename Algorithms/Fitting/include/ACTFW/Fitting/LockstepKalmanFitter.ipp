@@ -0,0 +1,516 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+template <typename propagator_t, std::size_t kLanes>
+LockstepKalmanFitter<propagator_t, kLanes>::LockstepKalmanFitter(
+    propagator_t                        propagator,
+    bool                                smoothing,
+    std::unique_ptr<const Acts::Logger> logger)
+  : m_propagator(std::move(propagator))
+  , m_smoothing(smoothing)
+  , m_logger(std::move(logger))
+{
+}
+
+template <typename propagator_t, std::size_t kLanes>
+void
+LockstepKalmanFitter<propagator_t, kLanes>::Step::reset()
+{
+  // unused lanes are computed with the others; keep them well-defined
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      predicted.params[i][l] = 0;
+      filtered.params[i][l]  = 0;
+      smoothed.params[i][l]  = 0;
+    }
+    for (std::size_t j = 0; j < kSize; ++j) {
+      const double value = (i == j) ? 1 : 0;
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        predicted.cov[i][j][l] = value;
+        filtered.cov[i][j][l]  = value;
+        smoothed.cov[i][j][l]  = value;
+        jacobian[i][j][l]      = value;
+      }
+    }
+  }
+  for (std::size_t l = 0; l < kLanes; ++l) {
+    meas[0][l]       = 0;
+    meas[1][l]       = 0;
+    measCov[0][0][l] = 1;
+    measCov[0][1][l] = 0;
+    measCov[1][0][l] = 0;
+    measCov[1][1][l] = 1;
+    chi2[l]          = 0;
+    gain[l]          = 0;
+    pathLength[l]    = 0;
+  }
+}
+
+template <typename propagator_t, std::size_t kLanes>
+void
+LockstepKalmanFitter<propagator_t, kLanes>::update(Step& step, double chi2Max)
+{
+  using namespace Acts;
+
+  const auto& pred = step.predicted;
+  auto&       filt = step.filtered;
+
+  // residual and inverse residual covariance; H only selects the local
+  // position, i.e. H P H^T is the leading 2x2 block of P
+  double res[2][kLanes];
+  double sInv[2][2][kLanes];
+  for (std::size_t l = 0; l < kLanes; ++l) {
+    res[0][l]         = step.meas[0][l] - pred.params[eLOC_0][l];
+    res[1][l]         = step.meas[1][l] - pred.params[eLOC_1][l];
+    const double s00  = pred.cov[eLOC_0][eLOC_0][l] + step.measCov[0][0][l];
+    const double s01  = pred.cov[eLOC_0][eLOC_1][l] + step.measCov[0][1][l];
+    const double s11  = pred.cov[eLOC_1][eLOC_1][l] + step.measCov[1][1][l];
+    const double iDet = 1 / (s00 * s11 - s01 * s01);
+    sInv[0][0][l]     = s11 * iDet;
+    sInv[0][1][l]     = -s01 * iDet;
+    sInv[1][1][l]     = s00 * iDet;
+    // predicted chi2 as in the Chi2OutlierFinder; outliers are not used
+    const double chi2
+        = res[0][l] * (sInv[0][0][l] * res[0][l] + sInv[0][1][l] * res[1][l])
+        + res[1][l] * (sInv[0][1][l] * res[0][l] + sInv[1][1][l] * res[1][l]);
+    step.gain[l] = (chi2Max < chi2) ? 0 : step.gain[l];
+  }
+
+  // gain matrix K = P H^T S^-1, zero for masked lanes
+  double gain[kSize][2][kLanes];
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      const double p0 = pred.cov[i][eLOC_0][l];
+      const double p1 = pred.cov[i][eLOC_1][l];
+      gain[i][0][l]
+          = step.gain[l] * (p0 * sInv[0][0][l] + p1 * sInv[0][1][l]);
+      gain[i][1][l]
+          = step.gain[l] * (p0 * sInv[0][1][l] + p1 * sInv[1][1][l]);
+    }
+  }
+
+  // x' = x + K r and P' = P - K H P
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      filt.params[i][l] = pred.params[i][l] + gain[i][0][l] * res[0][l]
+          + gain[i][1][l] * res[1][l];
+    }
+    for (std::size_t j = 0; j < kSize; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        filt.cov[i][j][l] = pred.cov[i][j][l]
+            - gain[i][0][l] * pred.cov[eLOC_0][j][l]
+            - gain[i][1][l] * pred.cov[eLOC_1][j][l];
+      }
+    }
+  }
+
+  // filtered chi2 as in the gain matrix updater, i.e. with the filtered
+  // residual and its covariance V - H P' H^T
+  for (std::size_t l = 0; l < kLanes; ++l) {
+    const double r0   = step.meas[0][l] - filt.params[eLOC_0][l];
+    const double r1   = step.meas[1][l] - filt.params[eLOC_1][l];
+    const double c00  = step.measCov[0][0][l] - filt.cov[eLOC_0][eLOC_0][l];
+    const double c01  = step.measCov[0][1][l] - filt.cov[eLOC_0][eLOC_1][l];
+    const double c11  = step.measCov[1][1][l] - filt.cov[eLOC_1][eLOC_1][l];
+    const double iDet = 1 / (c00 * c11 - c01 * c01);
+    const double chi2
+        = (r0 * r0 * c11 - 2 * r0 * r1 * c01 + r1 * r1 * c00) * iDet;
+    step.chi2[l] = (step.gain[l] != 0) ? chi2 : 0;
+  }
+}
+
+template <typename propagator_t, std::size_t kLanes>
+void
+LockstepKalmanFitter<propagator_t, kLanes>::smooth(Step& step, const Step& next)
+{
+  const auto& pf  = step.filtered.cov;
+  const auto& pp  = next.predicted.cov;
+  const auto& jac = next.jacobian;
+
+  // the smoother gain G = Pf J^T Pp^-1 is computed as its transpose
+  // G^T = Pp^-1 (J Pf) by Cholesky decomposition of the symmetric Pp.
+  double gt[kSize][kSize][kLanes];
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t j = 0; j < kSize; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) { gt[i][j][l] = 0; }
+      for (std::size_t m = 0; m < kSize; ++m) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          gt[i][j][l] += jac[i][m][l] * pf[m][j][l];
+        }
+      }
+    }
+  }
+  double chol[kSize][kSize][kLanes];
+  for (std::size_t j = 0; j < kSize; ++j) {
+    for (std::size_t i = j; i < kSize; ++i) {
+      double sum[kLanes];
+      for (std::size_t l = 0; l < kLanes; ++l) { sum[l] = pp[i][j][l]; }
+      for (std::size_t m = 0; m < j; ++m) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          sum[l] -= chol[i][m][l] * chol[j][m][l];
+        }
+      }
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        chol[i][j][l] = (i == j) ? std::sqrt(sum[l]) : sum[l] / chol[j][j][l];
+      }
+    }
+  }
+  // forward substitution with L and backward substitution with L^T
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t m = 0; m < i; ++m) {
+      for (std::size_t j = 0; j < kSize; ++j) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          gt[i][j][l] -= chol[i][m][l] * gt[m][j][l];
+        }
+      }
+    }
+    for (std::size_t j = 0; j < kSize; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        gt[i][j][l] /= chol[i][i][l];
+      }
+    }
+  }
+  for (std::size_t i = kSize; 0 < i--;) {
+    for (std::size_t m = i + 1; m < kSize; ++m) {
+      for (std::size_t j = 0; j < kSize; ++j) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          gt[i][j][l] -= chol[m][i][l] * gt[m][j][l];
+        }
+      }
+    }
+    for (std::size_t j = 0; j < kSize; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        gt[i][j][l] /= chol[i][i][l];
+      }
+    }
+  }
+
+  // xs = xf + G (xs' - xp') and Ps = Pf + G (Ps' - Pp') G^T
+  double dcov[kSize][kSize][kLanes];
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t l = 0; l < kLanes; ++l) {
+      step.smoothed.params[i][l] = step.filtered.params[i][l];
+    }
+    for (std::size_t m = 0; m < kSize; ++m) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        step.smoothed.params[i][l] += gt[m][i][l]
+            * (next.smoothed.params[m][l] - next.predicted.params[m][l]);
+      }
+    }
+    for (std::size_t n = 0; n < kSize; ++n) {
+      for (std::size_t l = 0; l < kLanes; ++l) { dcov[i][n][l] = 0; }
+      for (std::size_t m = 0; m < kSize; ++m) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          dcov[i][n][l] += gt[m][i][l]
+              * (next.smoothed.cov[m][n][l] - next.predicted.cov[m][n][l]);
+        }
+      }
+    }
+  }
+  for (std::size_t i = 0; i < kSize; ++i) {
+    for (std::size_t j = 0; j < kSize; ++j) {
+      for (std::size_t l = 0; l < kLanes; ++l) {
+        step.smoothed.cov[i][j][l] = pf[i][j][l];
+      }
+      for (std::size_t n = 0; n < kSize; ++n) {
+        for (std::size_t l = 0; l < kLanes; ++l) {
+          step.smoothed.cov[i][j][l] += dcov[i][n][l] * gt[n][j][l];
+        }
+      }
+    }
+  }
+}
+
+template <typename propagator_t, std::size_t kLanes>
+void
+LockstepKalmanFitter<propagator_t, kLanes>::store(
+    LaneStates&                 states,
+    std::size_t                 lane,
+    const Acts::BoundVector&    params,
+    const Acts::BoundSymMatrix& cov)
+{
+  for (std::size_t i = 0; i < kSize; ++i) {
+    states.params[i][lane] = params[i];
+    for (std::size_t j = 0; j < kSize; ++j) {
+      states.cov[i][j][lane] = cov(i, j);
+    }
+  }
+}
+
+template <typename propagator_t, std::size_t kLanes>
+void
+LockstepKalmanFitter<propagator_t, kLanes>::load(const LaneStates&     states,
+                                                 std::size_t           lane,
+                                                 Acts::BoundVector&    params,
+                                                 Acts::BoundSymMatrix& cov)
+{
+  for (std::size_t i = 0; i < kSize; ++i) {
+    params[i] = states.params[i][lane];
+    for (std::size_t j = 0; j < kSize; ++j) {
+      cov(i, j) = states.cov[i][j][lane];
+    }
+  }
+}
+
+template <typename propagator_t, std::size_t kLanes>
+std::vector<std::optional<
+    typename LockstepKalmanFitter<propagator_t, kLanes>::FitterResult>>
+LockstepKalmanFitter<propagator_t, kLanes>::fit(
+    const std::vector<std::vector<SimSourceLink>>& sourceLinks,
+    const std::vector<TrackParameters>&            initialParameters,
+    const Options&                                 options) const
+{
+  using namespace Acts;
+  using PropagatorOptions
+      = Acts::PropagatorOptions<ActionList<MaterialInteractor>, AbortList<>>;
+
+  const std::size_t nTracks = sourceLinks.size();
+  if ((kLanes < nTracks) or (initialParameters.size() != nTracks)) {
+    throw std::invalid_argument("Invalid number of tracks for the batch");
+  }
+  std::vector<std::optional<FitterResult>> results(nTracks);
+
+  // order the measurements of each lane along the track, i.e. by their
+  // distance to the initial position
+  std::array<bool, kLanes>                               active{};
+  std::array<std::vector<const SimSourceLink*>, kLanes> ordered;
+  std::vector<std::pair<double, const SimSourceLink*>>  byDistance;
+  std::size_t                                           nSteps = 0;
+  for (std::size_t lane = 0; lane < nTracks; ++lane) {
+    const auto& start = initialParameters[lane];
+    if (sourceLinks[lane].empty() or not start.covariance()) { continue; }
+
+    byDistance.clear();
+    for (const auto& sl : sourceLinks[lane]) {
+      if (sl.dimension() != 2) { break; }
+      Vector3D pos(0, 0, 0);
+      sl.referenceSurface().localToGlobal(
+          options.geoContext,
+          Vector2D(sl.values()[eLOC_0], sl.values()[eLOC_1]),
+          start.momentum(),
+          pos);
+      byDistance.emplace_back((pos - start.position()).norm(), &sl);
+    }
+    // only local position measurements are supported
+    if (byDistance.size() != sourceLinks[lane].size()) { continue; }
+
+    std::sort(byDistance.begin(),
+              byDistance.end(),
+              [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+              });
+    for (const auto& entry : byDistance) {
+      ordered[lane].push_back(entry.second);
+    }
+    active[lane] = true;
+    nSteps       = std::max(nSteps, ordered[lane].size());
+  }
+
+  PropagatorOptions propOptions(options.geoContext, options.magFieldContext);
+  auto& interactor = propOptions.actionList.template get<MaterialInteractor>();
+  interactor.multipleScattering = options.multipleScattering;
+  interactor.energyLoss         = options.energyLoss;
+  interactor.recordInteractions = false;
+
+  // propagate one lane to its next measurement surface
+  auto propagate = [&](const auto&    start,
+                       const Surface& target,
+                       Step&          step,
+                       std::size_t    lane) {
+    auto result = m_propagator.propagate(start, target, propOptions);
+    if (not result.ok()) { return false; }
+    const auto& output = result.value();
+    if (not output.endParameters or not output.endParameters->covariance()
+        or not output.transportJacobian) {
+      return false;
+    }
+    store(step.predicted,
+          lane,
+          output.endParameters->parameters(),
+          *output.endParameters->covariance());
+    for (std::size_t i = 0; i < kSize; ++i) {
+      for (std::size_t j = 0; j < kSize; ++j) {
+        step.jacobian[i][j][lane] = (*output.transportJacobian)(i, j);
+      }
+    }
+    step.pathLength[lane] = output.pathLength;
+    return true;
+  };
+
+  // forward filter; all lanes move to their next measurement together. A
+  // lane is aborted as soon as it can not pass the quality limits anymore.
+  const auto& limits = options.outlierFinder;
+  std::array<std::size_t, kLanes> length{};
+  std::array<std::size_t, kLanes> nMeasurements{};
+  std::array<std::size_t, kLanes> nOutliers{};
+  std::array<double, kLanes>      chi2Sum{};
+  std::array<bool, kLanes>        aborted{};
+  for (std::size_t lane = 0; lane < nTracks; ++lane) {
+    length[lane] = ordered[lane].size();
+  }
+  std::vector<Step> steps(nSteps);
+  BoundVector       params;
+  BoundSymMatrix    cov;
+  for (std::size_t k = 0; k < nSteps; ++k) {
+    Step& step = steps[k];
+    step.reset();
+    for (std::size_t lane = 0; lane < nTracks; ++lane) {
+      if (not active[lane] or (length[lane] <= k)) { continue; }
+
+      const SimSourceLink& sl = *ordered[lane][k];
+      bool                 propagated;
+      if (k == 0) {
+        propagated = propagate(
+            initialParameters[lane], sl.referenceSurface(), step, lane);
+      } else {
+        load(steps[k - 1].filtered, lane, params, cov);
+        BoundParameters start(
+            options.geoContext,
+            cov,
+            params,
+            ordered[lane][k - 1]->referenceSurface().getSharedPtr());
+        propagated = propagate(start, sl.referenceSurface(), step, lane);
+      }
+      if (not propagated) {
+        ACTS_DEBUG("Lane " << lane << " falls back at measurement " << k);
+        active[lane] = false;
+        continue;
+      }
+      step.meas[0][lane]       = sl.values()[eLOC_0];
+      step.meas[1][lane]       = sl.values()[eLOC_1];
+      step.measCov[0][0][lane] = sl.covariance()(eLOC_0, eLOC_0);
+      step.measCov[0][1][lane] = sl.covariance()(eLOC_0, eLOC_1);
+      step.measCov[1][0][lane] = sl.covariance()(eLOC_1, eLOC_0);
+      step.measCov[1][1][lane] = sl.covariance()(eLOC_1, eLOC_1);
+      step.gain[lane]          = 1;
+    }
+    update(step, limits.chi2Max);
+
+    for (std::size_t lane = 0; lane < nTracks; ++lane) {
+      if (not active[lane] or (length[lane] <= k)) { continue; }
+
+      if (step.gain[lane] != 0) {
+        nMeasurements[lane] += 1;
+        nOutliers[lane] = 0;
+        chi2Sum[lane] += step.chi2[lane];
+      } else {
+        nOutliers[lane] += 1;
+      }
+      // the chi2 sum can only grow and the final ndf is at most the ndf with
+      // all remaining measurements, i.e. the track would fail the final cut.
+      const std::size_t nMax = nMeasurements[lane] + (length[lane] - k - 1);
+      const bool        hasFailedChi2 = (5 < 2 * nMax)
+          and (limits.chi2NdfMax * (2 * nMax - 5) < chi2Sum[lane]);
+      if ((limits.maxConsecutiveOutliers < nOutliers[lane]) or hasFailedChi2) {
+        ACTS_DEBUG("Lane " << lane << " is aborted at measurement " << k);
+        aborted[lane] = true;
+        active[lane]  = false;
+        results[lane] = FitterResult::failure(
+            std::make_error_code(std::errc::operation_canceled));
+      }
+    }
+  }
+
+  // backward smoother; the last state of each lane is already smoothed
+  if (m_smoothing) {
+    for (std::size_t k = nSteps; 0 < k--;) {
+      Step& step = steps[k];
+      if (k + 1 < nSteps) { smooth(step, steps[k + 1]); }
+      for (std::size_t lane = 0; lane < nTracks; ++lane) {
+        if (k + 1 != length[lane]) { continue; }
+        load(step.filtered, lane, params, cov);
+        store(step.smoothed, lane, params, cov);
+      }
+    }
+  }
+  // without smoothing, the reference parameters are extrapolated from the
+  // last filtered state which includes the information of all measurements
+  const auto mask = m_smoothing
+      ? TrackStatePropMask::All
+      : (TrackStatePropMask::Predicted | TrackStatePropMask::Filtered
+         | TrackStatePropMask::Jacobian | TrackStatePropMask::Uncalibrated
+         | TrackStatePropMask::Calibrated);
+
+  // build the trajectories of all lanes that made it through
+  PropagatorOptions refOptions(propOptions);
+  refOptions.direction = backward;
+  for (std::size_t lane = 0; lane < nTracks; ++lane) {
+    if (not active[lane]) { continue; }
+
+    KalmanFitterResult<SimSourceLink> output;
+    auto&                             trajectory = output.fittedStates;
+    std::size_t                       tip        = SIZE_MAX;
+    bool                              isFinite   = true;
+    for (std::size_t k = 0; k < length[lane]; ++k) {
+      const Step&          step = steps[k];
+      const SimSourceLink& sl   = *ordered[lane][k];
+
+      tip        = trajectory.addTrackState(mask, tip);
+      auto state = trajectory.getTrackState(tip);
+      load(step.predicted, lane, params, cov);
+      state.predicted()           = params;
+      state.predictedCovariance() = cov;
+      load(step.filtered, lane, params, cov);
+      state.filtered()           = params;
+      state.filteredCovariance() = cov;
+      if (m_smoothing) {
+        load(step.smoothed, lane, params, cov);
+        state.smoothed()           = params;
+        state.smoothedCovariance() = cov;
+      }
+      isFinite = isFinite and params.allFinite() and cov.allFinite();
+      for (std::size_t i = 0; i < kSize; ++i) {
+        for (std::size_t j = 0; j < kSize; ++j) {
+          state.jacobian()(i, j) = step.jacobian[i][j][lane];
+        }
+      }
+      state.pathLength()   = step.pathLength[lane];
+      state.uncalibrated() = sl;
+      std::visit([&](const auto& meas) { state.setCalibrated(meas); }, *sl);
+
+      auto& typeFlags = state.typeFlags();
+      typeFlags.set(TrackStateFlag::ParameterFlag);
+      if (step.gain[lane] != 0) {
+        typeFlags.set(TrackStateFlag::MeasurementFlag);
+        state.chi2() = step.chi2[lane];
+        output.measurementStates += 1;
+      } else {
+        typeFlags.set(TrackStateFlag::OutlierFlag);
+      }
+    }
+    if (not isFinite) {
+      ACTS_DEBUG("Lane " << lane << " falls back with non-finite states");
+      continue;
+    }
+    output.trackTip = tip;
+
+    // extrapolate the innermost smoothed or the outermost filtered state to
+    // the reference surface
+    if (options.referenceSurface) {
+      const std::size_t k = m_smoothing ? 0 : (length[lane] - 1);
+      load(m_smoothing ? steps[k].smoothed : steps[k].filtered,
+           lane,
+           params,
+           cov);
+      const auto&     surface = ordered[lane][k]->referenceSurface();
+      BoundParameters start(
+          options.geoContext, cov, params, surface.getSharedPtr());
+      auto result = m_propagator.propagate(
+          start, *options.referenceSurface, refOptions);
+      if (not result.ok() or not result.value().endParameters) {
+        ACTS_DEBUG("Lane " << lane << " falls back at the reference surface");
+        continue;
+      }
+      output.fittedParameters = *result.value().endParameters;
+    }
+    output.smoothed = m_smoothing;
+    output.finished = true;
+    results[lane]   = FitterResult::success(std::move(output));
+  }
+  return results;
+}
@@ -8,15 +8,59 @@
 
 #include "ACTFW/Fitting/FittingAlgorithm.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <stdexcept>
+#include <system_error>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
 
 #include "ACTFW/EventData/ProtoTrack.hpp"
 #include "ACTFW/EventData/Track.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "Acts/Surfaces/PerigeeSurface.hpp"
 
+namespace {
+/// Fit quality summary computed along the fitted trajectory.
+struct FitQuality
+{
+  double      chi2                   = 0.0;
+  int         ndf                    = 0;
+  std::size_t maxConsecutiveOutliers = 0u;
+};
+
+template <typename trajectory_t>
+FitQuality
+computeFitQuality(const trajectory_t& trajectory, std::size_t trackTip)
+{
+  FitQuality  quality;
+  std::size_t nOutliers = 0u;
+  trajectory.visitBackwards(trackTip, [&](const auto& state) {
+    const auto typeFlags = state.typeFlags();
+    if (typeFlags.test(Acts::TrackStateFlag::MeasurementFlag)) {
+      quality.chi2 += state.chi2();
+      quality.ndf += state.calibratedSize();
+      nOutliers = 0u;
+    } else if (typeFlags.test(Acts::TrackStateFlag::OutlierFlag)) {
+      nOutliers += 1u;
+      quality.maxConsecutiveOutliers
+          = std::max(quality.maxConsecutiveOutliers, nOutliers);
+    }
+  });
+  // the measurements constrain the five spatial track parameters
+  quality.ndf -= 5;
+  return quality;
+}
+}  // namespace
+
 FW::FittingAlgorithm::FittingAlgorithm(Config cfg, Acts::Logging::Level level)
-  : FW::BareAlgorithm("FittingAlgorithm", level), m_cfg(std::move(cfg))
+  : FW::BareAlgorithm("FittingAlgorithm", level)
+  , m_cfg(std::move(cfg))
+  , m_perigeeSurface(Acts::Surface::makeShared<Acts::PerigeeSurface>(
+        Acts::Vector3D{0., 0., 0.}))
 {
   if (m_cfg.inputSourceLinks.empty()) {
     throw std::invalid_argument("Missing input source links collection");
@@ -31,6 +75,12 @@ FW::FittingAlgorithm::FittingAlgorithm(Config cfg, Acts::Logging::Level level)
   if (m_cfg.outputTrajectories.empty()) {
     throw std::invalid_argument("Missing output trajectories collection");
   }
+  if ((0u < m_cfg.lockstepLanes) and not m_cfg.fitBatch) {
+    throw std::invalid_argument("Missing lockstep fit function");
+  }
+  if (not(0 < m_cfg.outlierChi2Max) or not(0 < m_cfg.chi2NdfMax)) {
+    throw std::invalid_argument("Non-positive chi2 limits");
+  }
 }
 
 FW::ProcessCode
@@ -38,11 +88,11 @@ FW::FittingAlgorithm::execute(const FW::AlgorithmContext& ctx) const
 {
 
   // Read input data
-  const auto sourceLinks
+  const auto& sourceLinks
       = ctx.eventStore.get<SimSourceLinkContainer>(m_cfg.inputSourceLinks);
-  const auto protoTracks
+  const auto& protoTracks
       = ctx.eventStore.get<ProtoTrackContainer>(m_cfg.inputProtoTracks);
-  const auto initialParameters = ctx.eventStore.get<TrackParametersContainer>(
+  const auto& initialParameters = ctx.eventStore.get<TrackParametersContainer>(
       m_cfg.inputInitialTrackParameters);
 
   // Consistency cross checks
@@ -51,56 +101,63 @@ FW::FittingAlgorithm::execute(const FW::AlgorithmContext& ctx) const
     return ProcessCode::ABORT;
   }
 
-  // Prepare the output data with MultiTrajectory
-  TrajectoryContainer trajectories;
-  trajectories.reserve(protoTracks.size());
-
-  // Construct a perigee surface as the target surface
-  auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-      Acts::Vector3D{0., 0., 0.});
-
-  // Perform the fit for each input track
-  std::vector<SimSourceLink> trackSourceLinks;
-  for (std::size_t itrack = 0; itrack < protoTracks.size(); ++itrack) {
-    // The list of hits and the initial start parameters
-    const auto& protoTrack    = protoTracks[itrack];
-    const auto& initialParams = initialParameters[itrack];
-
-    // We can have empty tracks which must give empty fit results
-    if (protoTrack.empty()) {
-      trajectories.push_back(TruthFitTrack());
-      ACTS_WARNING("Empty track " << itrack << " found.");
-      continue;
-    }
+  // Prepare the output data with one slot per proto track
+  TrajectoryContainer trajectories(protoTracks.size());
+
+  // The KalmanFitter options are identical for all tracks
+  Chi2OutlierFinder outlierFinder;
+  outlierFinder.chi2Max                = m_cfg.outlierChi2Max;
+  outlierFinder.maxConsecutiveOutliers = m_cfg.maxConsecutiveOutliers;
+  outlierFinder.chi2NdfMax             = m_cfg.chi2NdfMax;
+  Acts::KalmanFitterOptions<Chi2OutlierFinder> kfOptions(
+      ctx.geoContext,
+      ctx.magFieldContext,
+      ctx.calibContext,
+      outlierFinder,
+      m_perigeeSurface.get());
 
-    // Clear & reserve the right size
+  // Fill the source links of a track via their indices from the container
+  std::atomic<bool> invalidInput(false);
+  auto collectSourceLinks = [&](std::size_t                 itrack,
+                                std::vector<SimSourceLink>& trackSourceLinks) {
+    const auto& protoTrack = protoTracks[itrack];
     trackSourceLinks.clear();
     trackSourceLinks.reserve(protoTrack.size());
-
-    // Fill the source links via their indices from the container
     for (auto hitIndex : protoTrack) {
       auto sourceLink = sourceLinks.nth(hitIndex);
       if (sourceLink == sourceLinks.end()) {
         ACTS_FATAL("Proto track " << itrack << " contains invalid hit index"
                                   << hitIndex);
-        return ProcessCode::ABORT;
+        invalidInput = true;
+        return false;
       }
       trackSourceLinks.push_back(*sourceLink);
     }
+    return true;
+  };
 
-    // Set the KalmanFitter options
-    Acts::KalmanFitterOptions<Acts::VoidOutlierFinder> kfOptions(
-        ctx.geoContext,
-        ctx.magFieldContext,
-        ctx.calibContext,
-        Acts::VoidOutlierFinder(),
-        &(*pSurface));
-
-    ACTS_DEBUG("Invoke fitter");
-    auto result = m_cfg.fit(trackSourceLinks, initialParams, kfOptions);
+  // Store the fit result of a track in its own output slot, i.e. the result
+  // does not depend on the execution order.
+  const bool hasQualityCuts
+      = (m_cfg.chi2NdfMax < std::numeric_limits<double>::infinity())
+      or (m_cfg.maxConsecutiveOutliers
+          < std::numeric_limits<std::size_t>::max());
+  auto storeResult = [&](std::size_t itrack, FitterResult result) {
     if (result.ok()) {
       // Get the fit output object
       const auto& fitOutput = result.value();
+      // Discard tracks that fail the quality requirements
+      if (hasQualityCuts) {
+        const auto quality
+            = computeFitQuality(fitOutput.fittedStates, fitOutput.trackTip);
+        if ((m_cfg.maxConsecutiveOutliers < quality.maxConsecutiveOutliers)
+            or ((0 < quality.ndf)
+                and (m_cfg.chi2NdfMax < (quality.chi2 / quality.ndf)))) {
+          ACTS_DEBUG("Discard track " << itrack << " with chi2/ndf "
+                                      << quality.chi2 << "/" << quality.ndf);
+          return;
+        }
+      }
       if (fitOutput.fittedParameters) {
         const auto& params = fitOutput.fittedParameters.value();
         ACTS_VERBOSE("Fitted paramemeters for track " << itrack);
@@ -108,21 +165,118 @@ FW::FittingAlgorithm::execute(const FW::AlgorithmContext& ctx) const
         ACTS_VERBOSE("  momentum: " << params.momentum().transpose());
         // Construct a truth fit track using trajectory and
         // track parameter
-        trajectories.emplace_back(fitOutput.trackTip,
-                                  std::move(fitOutput.fittedStates),
-                                  std::move(params));
+        trajectories[itrack] = TruthFitTrack(fitOutput.trackTip,
+                                             std::move(fitOutput.fittedStates),
+                                             std::move(params));
       } else {
         ACTS_DEBUG("No fitted paramemeters for track " << itrack);
         // Construct a truth fit track using trajectory
-        trajectories.emplace_back(fitOutput.trackTip,
-                                  std::move(fitOutput.fittedStates));
+        trajectories[itrack] = TruthFitTrack(
+            fitOutput.trackTip, std::move(fitOutput.fittedStates));
       }
+    } else if (result.error() == std::errc::operation_canceled) {
+      // The fitter stopped a track that would fail the quality requirements
+      ACTS_DEBUG("Discard aborted track " << itrack);
     } else {
+      // Fit failed, but still keep the empty truth fit track
       ACTS_WARNING("Fit failed for track " << itrack << " with error"
                                            << result.error());
-      // Fit failed, but still create a empty truth fit track
-      trajectories.push_back(TruthFitTrack());
     }
+  };
+
+  // Perform the fit for a range of input tracks one by one
+  auto fitTracks = [&](std::size_t begin, std::size_t end) {
+    std::vector<SimSourceLink> trackSourceLinks;
+    for (std::size_t itrack = begin; itrack < end; ++itrack) {
+      // We can have empty tracks which must give empty fit results
+      if (protoTracks[itrack].empty()) {
+        ACTS_WARNING("Empty track " << itrack << " found.");
+        continue;
+      }
+      if (not collectSourceLinks(itrack, trackSourceLinks)) { return; }
+
+      ACTS_DEBUG("Invoke fitter");
+      storeResult(
+          itrack,
+          m_cfg.fit(trackSourceLinks, initialParameters[itrack], kfOptions));
+    }
+  };
+
+  // Perform the fit for a range of input tracks in lockstep batches. Tracks
+  // that drop out of a batch are fitted one by one.
+  std::atomic<std::size_t> nFallbacks(0u);
+  auto fitBatches = [&](std::size_t begin, std::size_t end) {
+    std::vector<std::vector<SimSourceLink>> batchSourceLinks;
+    std::vector<TrackParameters>            batchParameters;
+    std::vector<std::size_t>                batchTracks;
+    std::size_t                             itrack = begin;
+    while (itrack < end) {
+      batchSourceLinks.resize(m_cfg.lockstepLanes);
+      batchParameters.clear();
+      batchTracks.clear();
+      for (; (itrack < end) and (batchTracks.size() < m_cfg.lockstepLanes);
+           ++itrack) {
+        if (protoTracks[itrack].empty()) {
+          ACTS_WARNING("Empty track " << itrack << " found.");
+          continue;
+        }
+        if (not collectSourceLinks(itrack,
+                                   batchSourceLinks[batchTracks.size()])) {
+          return;
+        }
+        batchParameters.push_back(initialParameters[itrack]);
+        batchTracks.push_back(itrack);
+      }
+      if (batchTracks.empty()) { break; }
+      batchSourceLinks.resize(batchTracks.size());
+
+      ACTS_DEBUG("Invoke lockstep fitter for " << batchTracks.size()
+                                               << " tracks");
+      auto results
+          = m_cfg.fitBatch(batchSourceLinks, batchParameters, kfOptions);
+      for (std::size_t lane = 0; lane < batchTracks.size(); ++lane) {
+        if (results[lane]) {
+          storeResult(batchTracks[lane], std::move(*results[lane]));
+        } else {
+          nFallbacks += 1;
+          storeResult(batchTracks[lane],
+                      m_cfg.fit(batchSourceLinks[lane],
+                                batchParameters[lane],
+                                kfOptions));
+        }
+      }
+    }
+  };
+  auto fit = [&](std::size_t begin, std::size_t end) {
+    if (0u < m_cfg.lockstepLanes) {
+      fitBatches(begin, end);
+    } else {
+      fitTracks(begin, end);
+    }
+  };
+
+  if ((0u < m_cfg.minTracksPerTask)
+      and (m_cfg.minTracksPerTask < protoTracks.size())) {
+    // a blocked range is only split if it is larger than the grain size and
+    // then into halves, i.e. this grain size ensures the minimum task size.
+    const std::size_t grainSize = 2 * m_cfg.minTracksPerTask - 1;
+    // the nested loop runs in the same arena as the event loop and uses its
+    // threads without oversubscription. isolation prevents a thread waiting
+    // for the tracks of this event from picking up a different event.
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(
+          tbb::blocked_range<std::size_t>(0, protoTracks.size(), grainSize),
+          [&](const tbb::blocked_range<std::size_t>& r) {
+            fit(r.begin(), r.end());
+          });
+    });
+  } else {
+    fit(0, protoTracks.size());
+  }
+  if (invalidInput) { return ProcessCode::ABORT; }
+  if (0u < m_cfg.lockstepLanes) {
+    ACTS_DEBUG(nFallbacks << " of " << protoTracks.size()
+                          << " tracks fell back from the lockstep fitter");
   }
 
   ctx.eventStore.add(m_cfg.outputTrajectories, std::move(trajectories));
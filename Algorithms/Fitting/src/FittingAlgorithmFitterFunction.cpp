@@ -12,9 +12,11 @@
 #include <map>
 #include <random>
 #include <stdexcept>
+#include <type_traits>
 
 #include <boost/program_options.hpp>
 
+#include "ACTFW/Fitting/LockstepKalmanFitter.hpp"
 #include "ACTFW/Plugins/BField/ScalableBField.hpp"
 #include "Acts/Fitter/GainMatrixSmoother.hpp"
 #include "Acts/Fitter/GainMatrixUpdater.hpp"
@@ -41,7 +43,24 @@ struct FitterFunctionImpl
   operator()(
       const std::vector<FW::SimSourceLink>& sourceLinks,
       const FW::TrackParameters&            initialParameters,
-      const Acts::KalmanFitterOptions<Acts::VoidOutlierFinder>& options) const
+      const Acts::KalmanFitterOptions<FW::Chi2OutlierFinder>& options) const
+  {
+    return fitter.fit(sourceLinks, initialParameters, options);
+  };
+};
+
+template <typename Fitter>
+struct BatchFitterFunctionImpl
+{
+  Fitter fitter;
+
+  BatchFitterFunctionImpl(Fitter&& f) : fitter(std::move(f)) {}
+
+  std::vector<std::optional<FW::FittingAlgorithm::FitterResult>>
+  operator()(
+      const std::vector<std::vector<FW::SimSourceLink>>& sourceLinks,
+      const std::vector<FW::TrackParameters>&            initialParameters,
+      const Acts::KalmanFitterOptions<FW::Chi2OutlierFinder>& options) const
   {
     return fitter.fit(sourceLinks, initialParameters, options);
   };
@@ -86,3 +105,56 @@ FW::FittingAlgorithm::makeFitterFunction(
       },
       std::move(magneticField));
 }
+
+FW::FittingAlgorithm::BatchFitterFunction
+FW::FittingAlgorithm::makeLockstepFitterFunction(
+    std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry,
+    Options::BFieldVariant                        magneticField,
+    std::size_t                                   lanes,
+    bool                                          smoothing,
+    Acts::Logging::Level                          lvl)
+{
+  if ((lanes != 4u) and (lanes != 8u) and (lanes != 16u)) {
+    throw std::invalid_argument("Lockstep lanes must be 4, 8, or 16");
+  }
+
+  // unpack the magnetic field variant and instantiate the corresponding fitter.
+  return std::visit(
+      [trackingGeometry, lanes, smoothing, lvl](
+          auto&& inputField) -> BatchFitterFunction {
+        // each entry in the variant is already a shared_ptr
+        // need ::element_type to get the real magnetic field type
+        using InputMagneticField =
+            typename std::decay_t<decltype(inputField)>::element_type;
+        using MagneticField = Acts::SharedBField<InputMagneticField>;
+        using Stepper       = Acts::EigenStepper<MagneticField>;
+        using Navigator     = Acts::Navigator;
+        using Propagator    = Acts::Propagator<Stepper, Navigator>;
+
+        // construct the propagator with the same setup as the regular fitter
+        MagneticField field(std::move(inputField));
+        Stepper       stepper(std::move(field));
+        Navigator     navigator(trackingGeometry);
+        navigator.resolvePassive   = false;
+        navigator.resolveMaterial  = true;
+        navigator.resolveSensitive = true;
+        Propagator propagator(std::move(stepper), std::move(navigator));
+
+        // the lane count is a compile-time parameter of the fitter
+        auto makeFunction = [&](auto nLanes) -> BatchFitterFunction {
+          using Fitter
+              = LockstepKalmanFitter<Propagator, decltype(nLanes)::value>;
+          Fitter fitter(std::move(propagator),
+                        smoothing,
+                        Acts::getDefaultLogger("LockstepKalmanFitter", lvl));
+          return BatchFitterFunctionImpl<Fitter>(std::move(fitter));
+        };
+        if (lanes == 4u) {
+          return makeFunction(std::integral_constant<std::size_t, 4u>());
+        } else if (lanes == 8u) {
+          return makeFunction(std::integral_constant<std::size_t, 8u>());
+        }
+        return makeFunction(std::integral_constant<std::size_t, 16u>());
+      },
+      std::move(magneticField));
+}
@@ -8,6 +8,8 @@
 
 #include "ACTFW/Generators/FlattenEvent.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <vector>
 
 #include "ACTFW/EventData/SimParticle.hpp"
@@ -28,23 +30,62 @@ FW::FlattenEvent::FlattenEvent(const Config& cfg, Acts::Logging::Level lvl)
 FW::ProcessCode
 FW::FlattenEvent::execute(const AlgorithmContext& ctx) const
 {
-  // setup input and output containers
-  const auto& event
-      = ctx.eventStore.get<std::vector<SimVertex>>(m_cfg.inputEvent);
+  // setup output container
   SimParticleContainer::sequence_type unsortedParticles;
 
   // extract particles
-  for (const auto& vertex : event) {
-    for (const auto& particle : vertex.outgoing) {
-      unsortedParticles.emplace_back(particle);
+  if (m_cfg.consumeEvent) {
+    auto event = ctx.eventStore.pop<std::vector<SimVertex>>(m_cfg.inputEvent);
+    std::size_t numParticles = 0u;
+    for (const auto& vertex : event) { numParticles += vertex.outgoing.size(); }
+    unsortedParticles.reserve(numParticles);
+    for (auto& vertex : event) {
+      std::move(vertex.outgoing.begin(),
+                vertex.outgoing.end(),
+                std::back_inserter(unsortedParticles));
+    }
+  } else {
+    const auto& event
+        = ctx.eventStore.get<std::vector<SimVertex>>(m_cfg.inputEvent);
+    std::size_t numParticles = 0u;
+    for (const auto& vertex : event) { numParticles += vertex.outgoing.size(); }
+    unsortedParticles.reserve(numParticles);
+    for (const auto& vertex : event) {
+      unsortedParticles.insert(unsortedParticles.end(),
+                               vertex.outgoing.begin(),
+                               vertex.outgoing.end());
     }
   }
-  unsortedParticles.shrink_to_fit();
 
-  // re-establish ordering by barcode
+  // re-establish ordering by barcode. generators usually create particles
+  // already ordered and the sorting can be skipped in that case.
   SimParticleContainer particles;
-  particles.adopt_sequence(std::move(unsortedParticles));
+  auto isNotOrdered = [cmp = particles.value_comp()](const auto& lhs,
+                                                     const auto& rhs) {
+    return not cmp(lhs, rhs);
+  };
+  if (std::adjacent_find(
+          unsortedParticles.begin(), unsortedParticles.end(), isNotOrdered)
+      == unsortedParticles.end()) {
+    particles.adopt_sequence(boost::container::ordered_unique_range,
+                             std::move(unsortedParticles));
+  } else {
+    particles.adopt_sequence(std::move(unsortedParticles));
+  }
 
   ctx.eventStore.add(m_cfg.outputParticles, std::move(particles));
   return ProcessCode::SUCCESS;
 }
+
+std::vector<std::string>
+FW::FlattenEvent::inputCollections() const
+{
+  return {m_cfg.inputEvent};
+}
+
+std::vector<std::string>
+FW::FlattenEvent::consumedCollections() const
+{
+  if (m_cfg.consumeEvent) { return {m_cfg.inputEvent}; }
+  return {};
+}
@@ -24,6 +24,10 @@ public:
     std::string inputEvent;
     /// The output particles collection.
     std::string outputParticles;
+    /// Consume the input event and move the particles instead of copying.
+    ///
+    /// The input event is not available to subsequent stages if enabled.
+    bool consumeEvent = false;
   };
 
   FlattenEvent(const Config& cfg, Acts::Logging::Level lvl);
@@ -31,6 +35,12 @@ public:
   ProcessCode
   execute(const AlgorithmContext& ctx) const final override;
 
+  /// The input event, which is consumed if configured.
+  std::vector<std::string>
+  inputCollections() const final override;
+  std::vector<std::string>
+  consumedCollections() const final override;
+
 private:
   Config m_cfg;
 };
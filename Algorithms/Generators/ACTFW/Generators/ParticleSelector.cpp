@@ -164,3 +164,9 @@ FW::ParticleSelector::execute(const FW::AlgorithmContext& ctx) const
   ctx.eventStore.add(m_cfg.outputEvent, std::move(selected));
   return ProcessCode::SUCCESS;
 }
+
+std::vector<std::string>
+FW::ParticleSelector::inputCollections() const
+{
+  return {m_cfg.inputEvent};
+}
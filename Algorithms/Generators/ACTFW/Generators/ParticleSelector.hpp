@@ -63,6 +63,9 @@ public:
   ProcessCode
   execute(const AlgorithmContext& ctx) const;
 
+  std::vector<std::string>
+  inputCollections() const override;
+
 private:
   Config m_cfg;
 };
@@ -64,7 +64,7 @@ public:
     {
     }
 
-    /// Input collection
+    /// Input collection; the mapped tracks replace it under the same name
     std::string collection = "material-tracks";
 
     /// The material collection to be stored
@@ -103,6 +103,10 @@ public:
   FW::ProcessCode
   execute(const AlgorithmContext& context) const final override;
 
+  /// The input material tracks; they are replaced but not consumed.
+  std::vector<std::string>
+  inputCollections() const final override;
+
 private:
   Config m_cfg;  //!< internal config object
   Acts::SurfaceMaterialMapper::State
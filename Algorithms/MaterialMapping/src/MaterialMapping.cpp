@@ -60,9 +60,10 @@ FW::ProcessCode
 FW::MaterialMapping::execute(const FW::AlgorithmContext& context) const
 {
 
-  // Write to the collection to the EventStore
+  // Take over the collection; the tracks are modified by the mapping and
+  // forwarded under the mapped and the original name without copying them.
   std::vector<Acts::RecordedMaterialTrack> mtrackCollection
-      = context.eventStore.get<std::vector<Acts::RecordedMaterialTrack>>(
+      = context.eventStore.pop<std::vector<Acts::RecordedMaterialTrack>>(
           m_cfg.collection);
 
   // To make it work with the framework needs a lock guard
@@ -76,6 +77,13 @@ FW::MaterialMapping::execute(const FW::AlgorithmContext& context) const
 
   context.eventStore.add(m_cfg.mappingMaterialCollection,
                          std::move(mtrackCollection));
+  context.eventStore.alias(m_cfg.mappingMaterialCollection, m_cfg.collection);
 
   return FW::ProcessCode::SUCCESS;
 }
+
+std::vector<std::string>
+FW::MaterialMapping::inputCollections() const
+{
+  return {m_cfg.collection};
+}
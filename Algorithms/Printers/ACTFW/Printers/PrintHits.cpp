@@ -12,10 +12,10 @@
 
 #include "ACTFW/EventData/GeometryContainers.hpp"
 #include "ACTFW/EventData/IndexContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "ACTFW/Utilities/Range.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
 #include "Acts/Utilities/Logger.hpp"
 
 FW::PrintHits::PrintHits(const FW::PrintHits::Config& cfg,
@@ -27,7 +27,7 @@ FW::PrintHits::PrintHits(const FW::PrintHits::Config& cfg,
 FW::ProcessCode
 FW::PrintHits::execute(const FW::AlgorithmContext& ctx) const
 {
-  using Clusters        = FW::GeometryIdMultimap<Acts::PlanarModuleCluster>;
+  using Clusters        = FW::PlanarClusterContainer;
   using HitParticlesMap = FW::IndexMultimap<ActsFatras::Barcode>;
   using HitIds          = std::vector<size_t>;
 
@@ -43,10 +43,8 @@ FW::PrintHits::execute(const FW::AlgorithmContext& ctx) const
     auto hitId = hitIds[ihit];
     auto ic    = clusters.nth(ihit);
     if (ic == clusters.end()) { break; }
-    Acts::GeometryID                 geoId = ic->first;
-    const Acts::PlanarModuleCluster& c     = ic->second;
-    ACTS_INFO("  Cluster " << ihit << " hitId " << hitId << " geoId " << geoId
-                           << " size " << c.digitizationCells().size());
+    ACTS_INFO("  Cluster " << ihit << " hitId " << hitId << " geoId "
+                           << ic->geoId << " size " << ic->cellsSize);
     // get all contributing particles
     for (const auto& p : makeRange(hitParticlesMap.equal_range(ihit))) {
       ACTS_INFO("    generating particle " << p.first);
@@ -54,10 +52,12 @@ FW::PrintHits::execute(const FW::AlgorithmContext& ctx) const
   }
 
   // print hits within geometry selection
-  auto numVolume = selectVolume(clusters, m_cfg.volumeId).size();
-  auto numLayer  = selectLayer(clusters, m_cfg.volumeId, m_cfg.layerId).size();
+  const auto& byGeoId = clusters.clusters();
+
+  auto numVolume = selectVolume(byGeoId, m_cfg.volumeId).size();
+  auto numLayer  = selectLayer(byGeoId, m_cfg.volumeId, m_cfg.layerId).size();
   auto rangeModule
-      = selectModule(clusters, m_cfg.volumeId, m_cfg.layerId, m_cfg.moduleId);
+      = selectModule(byGeoId, m_cfg.volumeId, m_cfg.layerId, m_cfg.moduleId);
 
   ACTS_INFO("Hits total: " << clusters.size());
   ACTS_INFO("Hits in volume " << m_cfg.volumeId << ": " << numVolume);
@@ -66,17 +66,15 @@ FW::PrintHits::execute(const FW::AlgorithmContext& ctx) const
   ACTS_INFO("Hits in volume " << m_cfg.volumeId << " layer " << m_cfg.layerId
                               << " module " << m_cfg.moduleId << ": "
                               << rangeModule.size());
-  // we could also use for (const Acts::PlanarModuleCluster& c : rangeModule)
+  // we could also use for (const PlanarCluster& c : rangeModule)
   // for simplicity, but then we could not get the hit index.
   ACTS_INFO("Hits by geometry selection")
   for (auto ic = rangeModule.begin(); ic != rangeModule.end(); ++ic) {
     auto ihit  = clusters.index_of(ic);
     auto hitId = hitIds[ihit];
 
-    Acts::GeometryID                 geoId = ic->first;
-    const Acts::PlanarModuleCluster& c     = ic->second;
-    ACTS_INFO("  Cluster " << ihit << " hitId " << hitId << " geoId " << geoId
-                           << " size " << c.digitizationCells().size());
+    ACTS_INFO("  Cluster " << ihit << " hitId " << hitId << " geoId "
+                           << ic->geoId << " size " << ic->cellsSize);
   }
 
   return ProcessCode::SUCCESS;
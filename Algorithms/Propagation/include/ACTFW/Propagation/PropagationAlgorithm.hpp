@@ -13,10 +13,16 @@
 #include <memory>
 #include <optional>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "ACTFW/Framework/ProcessCode.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Propagation/StepRecorder.hpp"
+#include "ACTFW/Propagation/SurfaceIntersectionRecorder.hpp"
 #include "Acts/EventData/NeutralParameters.hpp"
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/Propagator/AbortList.hpp"
@@ -46,8 +52,15 @@ using RecordedMaterialTrack
     = std::pair<std::pair<Acts::Vector3D, Acts::Vector3D>, RecordedMaterial>;
 
 /// Finally the output of the propagation test
-using PropagationOutput
-    = std::pair<std::vector<Acts::detail::Step>, RecordedMaterial>;
+struct PropagationOutput
+{
+  /// The recorded steps; only filled in the step logging mode
+  std::vector<Acts::detail::Step> steps;
+  /// The target surface intersections; only filled in the surface mode
+  std::vector<SurfaceIntersection> intersections;
+  /// The recorded material - if configured
+  RecordedMaterial material;
+};
 
 /// @brief this test algorithm performs test propagation
 /// within the Acts::Propagator
@@ -55,6 +68,19 @@ using PropagationOutput
 /// If the propagator is equipped appropriately, it can
 /// also be used to test the Extrapolator within the geomtetry
 ///
+/// Each test uses its own random number stream derived from the event seed
+/// and the test index. The tests can thus run in parallel within an event and
+/// still produce the same output, in the same order, as the serial mode.
+///
+/// By default every step is recorded. To reduce the memory and output volume,
+/// e.g. for material validation, the recording can be restricted to steps on
+/// selected surfaces, decimated, and limited to the last steps of each track.
+///
+/// Extrapolation studies that only need the track parameters on some target
+/// surfaces can use the surface mode instead. No step is recorded and only
+/// the crossings of the selected target surfaces are written as compact
+/// intersection records, ordered by test and by crossing within each test.
+///
 /// @tparam propagator_t Type of the Propagator to be tested
 template <typename propagator_t>
 class PropagationAlgorithm : public BareAlgorithm
@@ -71,7 +97,8 @@ public:
     /// how to set it up
     std::shared_ptr<RandomNumbers> randomNumberSvc = nullptr;
 
-    /// proapgation mode
+    /// proapgation mode: 0 records the steps, 1 records the crossings of
+    /// the target surfaces
     int mode = 0;
     /// debug output
     bool debugOutput = false;
@@ -84,6 +111,9 @@ public:
 
     /// number of particles
     size_t ntests = 100;
+    /// Minimum number of tests per parallel task within an event; zero
+    /// disables the intra-event parallelism and runs all tests serially.
+    size_t minTestsPerTask = 0;
     /// d0 gaussian sigma
     double d0Sigma = 15_um;
     /// z0 gaussian sigma
@@ -108,12 +138,32 @@ public:
     /// Max step size steering
     double maxStepSize = 3_m;
 
+    /// Step recording: steps on sensitive, material, or boundary surfaces;
+    /// disabled types are dropped unless the surface has an enabled type
+    bool recordSensitiveSteps = true;
+    bool recordMaterialSteps  = true;
+    bool recordBoundarySteps  = true;
+    /// Step recording: every n-th of all other steps; zero records none
+    size_t stepDecimation = 1;
+    /// Step recording: maximum number of steps per track; only the last
+    /// steps are kept. Zero means no limit.
+    size_t maxStepsPerTrack = 0;
+
+    /// Target surfaces for the surface mode; the geometry identifiers can
+    /// describe volumes, layers, or modules. All surfaces reached by the
+    /// navigator within the tracking geometry are targets if it is empty.
+    std::vector<Acts::GeometryID> targetSelection;
+
     /// The step collection to be stored
     std::string propagationStepCollection = "PropagationSteps";
 
     /// The material collection to be stored
     std::string propagationMaterialCollection = "RecordedMaterialTracks";
 
+    /// The surface intersection collection to be stored in the surface mode
+    std::string propagationIntersectionCollection
+        = "propagation-intersections";
+
     /// covariance transport
     bool covarianceTransport = false;
 
@@ -140,6 +190,9 @@ public:
 private:
   Config m_cfg;  ///< the config class
 
+  /// the compiled target selection for the surface mode
+  SurfaceIntersectionRecorder::Selection m_targetSelection;
+
   /// Private helper method to create a corrleated covariance matrix
   /// @param[in] rnd is the random engine
   /// @param[in] gauss is a gaussian distribution to draw from
@@ -156,7 +209,7 @@ private:
   /// @param [in] startParameters the start parameters
   /// @param [in] pathLengthe the path limit of this propagation
   ///
-  /// @return collection of Propagation steps for further analysis
+  /// @return collection of Propagation steps or surface intersections
   template <typename parameters_t>
   PropagationOutput
   executeTest(const AlgorithmContext& context,
@@ -6,7 +6,11 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <cstdint>
+#include <iterator>
 #include <random>
+#include <stdexcept>
+#include <type_traits>
 
 #include <Acts/Utilities/Helpers.hpp>
 
@@ -42,6 +46,19 @@ PropagationAlgorithm<propagator_t>::PropagationAlgorithm(
     Acts::Logging::Level                              loglevel)
   : BareAlgorithm("PropagationAlgorithm", loglevel), m_cfg(cfg)
 {
+  if ((m_cfg.mode != 0) and (m_cfg.mode != 1)) {
+    throw std::invalid_argument("Unknown propagation mode");
+  }
+  if ((m_cfg.mode == 1) and m_cfg.propagationIntersectionCollection.empty()) {
+    throw std::invalid_argument("Missing surface intersection collection");
+  }
+
+  std::vector<SurfaceIntersectionRecorder::Selection::InputElement> selection;
+  for (auto geoId : m_cfg.targetSelection) {
+    selection.emplace_back(geoId, SurfaceIntersectionRecorder::Selected());
+  }
+  m_targetSelection
+      = SurfaceIntersectionRecorder::Selection(std::move(selection));
 }
 
 /// Templated execute test method for
@@ -62,18 +79,18 @@ PropagationAlgorithm<propagator_t>::executeTest(
 
   PropagationOutput pOutput;
 
-  // This is the outside in mode
-  if (m_cfg.mode == 0) {
+  // The material interactor & end of world aborter
+  using MaterialInteractor = Acts::MaterialInteractor;
+  using DebugOutput        = Acts::detail::DebugOutputActor;
+  using EndOfWorld         = Acts::detail::EndOfWorldReached;
 
-    // The step length logger for testing & end of world aborter
-    using MaterialInteractor = Acts::MaterialInteractor;
-    using SteppingLogger     = Acts::detail::SteppingLogger;
-    using DebugOutput        = Acts::detail::DebugOutputActor;
-    using EndOfWorld         = Acts::detail::EndOfWorldReached;
+  // The propagation is identical for all modes, only the recorder differs
+  auto propagate = [&](const auto& recorder) {
+    using Recorder = std::decay_t<decltype(recorder)>;
 
     // Action list and abort list
     using ActionList
-        = Acts::ActionList<SteppingLogger, MaterialInteractor, DebugOutput>;
+        = Acts::ActionList<Recorder, MaterialInteractor, DebugOutput>;
     using AbortList         = Acts::AbortList<EndOfWorld>;
     using PropagatorOptions = Acts::PropagatorOptions<ActionList, AbortList>;
 
@@ -87,26 +104,25 @@ PropagationAlgorithm<propagator_t>::executeTest(
            < m_cfg.ptLoopers);
 
     // Switch the material interaction on/off & eventually into logging mode
-    auto& mInteractor = options.actionList.get<MaterialInteractor>();
+    auto& mInteractor = options.actionList.template get<MaterialInteractor>();
     mInteractor.multipleScattering = m_cfg.multipleScattering;
     mInteractor.energyLoss         = m_cfg.energyLoss;
     mInteractor.recordInteractions = m_cfg.recordMaterialInteractions;
 
+    // Select the recorded steps or surfaces
+    options.actionList.template get<Recorder>() = recorder;
+
     // Set a maximum step size
     options.maxStepSize = m_cfg.maxStepSize;
 
     // Propagate using the propagator
-    const auto& result
-        = m_cfg.propagator.propagate(startParameters, options).value();
-    auto steppingResults = result.template get<SteppingLogger::result_type>();
+    auto result = m_cfg.propagator.propagate(startParameters, options).value();
 
-    // Set the stepping result
-    pOutput.first = std::move(steppingResults.steps);
     // Also set the material recording result - if configured
     if (m_cfg.recordMaterialInteractions) {
-      auto materialResult
+      auto& materialResult
           = result.template get<MaterialInteractor::result_type>();
-      pOutput.second = std::move(materialResult);
+      pOutput.material = std::move(materialResult);
     }
 
     // screen output if requested
@@ -114,6 +130,30 @@ PropagationAlgorithm<propagator_t>::executeTest(
       auto& debugResult = result.template get<DebugOutput::result_type>();
       ACTS_VERBOSE(debugResult.debugString);
     }
+
+    // The recorder result is moved out without copying the records
+    return std::move(result.template get<typename Recorder::result_type>());
+  };
+
+  // This is the outside in mode
+  if (m_cfg.mode == 0) {
+    // Select the recorded steps
+    StepRecorder recorder;
+    recorder.sensitive  = m_cfg.recordSensitiveSteps;
+    recorder.material   = m_cfg.recordMaterialSteps;
+    recorder.boundary   = m_cfg.recordBoundarySteps;
+    recorder.decimation = m_cfg.stepDecimation;
+    recorder.maxSteps   = m_cfg.maxStepsPerTrack;
+
+    auto recorderResult = propagate(recorder);
+    pOutput.steps       = StepRecorder::takeSteps(recorderResult);
+  }
+  // This is the surface mode, i.e. no step is recorded
+  if (m_cfg.mode == 1) {
+    SurfaceIntersectionRecorder recorder;
+    recorder.selection = &m_targetSelection;
+
+    pOutput.intersections = std::move(propagate(recorder).intersections);
   }
   return pOutput;
 }
@@ -123,97 +163,161 @@ ProcessCode
 PropagationAlgorithm<propagator_t>::execute(
     const AlgorithmContext& context) const
 {
-  // Create a random number generator
-  FW::RandomEngine rng = m_cfg.randomNumberSvc->spawnGenerator(context);
-
-  // Standard gaussian distribution for covarianmces
-  std::normal_distribution<double> gauss(0., 1.);
-
-  // Setup random number distributions for some quantities
-  std::uniform_real_distribution<double> phiDist(m_cfg.phiRange.first,
-                                                 m_cfg.phiRange.second);
-  std::uniform_real_distribution<double> etaDist(m_cfg.etaRange.first,
-                                                 m_cfg.etaRange.second);
-  std::uniform_real_distribution<double> ptDist(m_cfg.ptRange.first,
-                                                m_cfg.ptRange.second);
-  std::uniform_real_distribution<double> qDist(0., 1.);
+  // The event seed is combined with the test index to give an independent
+  // random stream for each test, i.e. the generated test tracks do not depend
+  // on the order in which the tests are executed.
+  const uint64_t eventSeed = m_cfg.randomNumberSvc->generateSeed(context);
 
   std::shared_ptr<const Acts::PerigeeSurface> surface
       = Acts::Surface::makeShared<Acts::PerigeeSurface>(
           Acts::Vector3D(0., 0., 0.));
 
-  // Output : the propagation steps
-  std::vector<std::vector<Acts::detail::Step>> propagationSteps;
-  propagationSteps.reserve(m_cfg.ntests);
+  // Output : the propagation steps or the surface intersections, one slot
+  // per test. Only the slots of the configured mode are filled.
+  std::vector<std::vector<Acts::detail::Step>> propagationSteps(m_cfg.ntests);
+  std::vector<std::vector<SurfaceIntersection>> intersections(m_cfg.ntests);
 
-  // Output (optional): the recorded material
-  std::vector<RecordedMaterialTrack> recordedMaterial;
+  // Output (optional): the recorded material, one slot per test
+  std::vector<std::optional<RecordedMaterialTrack>> materialTracks;
   if (m_cfg.recordMaterialInteractions) {
-    recordedMaterial.reserve(m_cfg.ntests);
+    materialTracks.resize(m_cfg.ntests);
   }
 
-  // loop over number of particles
-  for (size_t it = 0; it < m_cfg.ntests; ++it) {
-    /// get the d0 and z0
-    double d0     = m_cfg.d0Sigma * gauss(rng);
-    double z0     = m_cfg.z0Sigma * gauss(rng);
-    double phi    = phiDist(rng);
-    double eta    = etaDist(rng);
-    double theta  = 2 * atan(exp(-eta));
-    double pt     = ptDist(rng);
-    double p      = pt / sin(theta);
-    double charge = qDist(rng) > 0.5 ? 1. : -1.;
-    double qop    = charge / p;
-    double t      = m_cfg.tSigma * gauss(rng);
-    // parameters
-    Acts::BoundVector pars;
-    pars << d0, z0, phi, theta, qop, t;
-    // some screen output
-
-    Acts::Vector3D sPosition(0., 0., 0.);
-    Acts::Vector3D sMomentum(0., 0., 0.);
-
-    // The covariance generation
-    auto cov = generateCovariance(rng, gauss);
-
-    // execute the test for charged particles
-    PropagationOutput pOutput;
-    if (charge) {
-      // charged extrapolation - with hit recording
-      Acts::BoundParameters startParameters(
-          context.geoContext, std::move(cov), std::move(pars), surface);
-      sPosition = startParameters.position();
-      sMomentum = startParameters.momentum();
-      pOutput   = executeTest<Acts::TrackParameters>(context, startParameters);
-    } else {
-      // execute the test for neeutral particles
-      Acts::NeutralBoundParameters neutralParameters(
-          context.geoContext, std::move(cov), std::move(pars), surface);
-      sPosition = neutralParameters.position();
-      sMomentum = neutralParameters.momentum();
-      pOutput
-          = executeTest<Acts::NeutralParameters>(context, neutralParameters);
+  // Run a range of tests. Each test only writes to its own output slots and
+  // the propagator state is local to each propagation call.
+  auto runTests = [&](size_t begin, size_t end) {
+    for (size_t it = begin; it < end; ++it) {
+      std::seed_seq seeds{uint32_t(eventSeed),
+                          uint32_t(eventSeed >> 32),
+                          uint32_t(it),
+                          uint32_t(uint64_t(it) >> 32)};
+      FW::RandomEngine rng(seeds);
+
+      // Standard gaussian distribution for covarianmces
+      std::normal_distribution<double> gauss(0., 1.);
+
+      // Setup random number distributions for some quantities
+      std::uniform_real_distribution<double> phiDist(m_cfg.phiRange.first,
+                                                     m_cfg.phiRange.second);
+      std::uniform_real_distribution<double> etaDist(m_cfg.etaRange.first,
+                                                     m_cfg.etaRange.second);
+      std::uniform_real_distribution<double> ptDist(m_cfg.ptRange.first,
+                                                    m_cfg.ptRange.second);
+      std::uniform_real_distribution<double> qDist(0., 1.);
+
+      /// get the d0 and z0
+      double d0     = m_cfg.d0Sigma * gauss(rng);
+      double z0     = m_cfg.z0Sigma * gauss(rng);
+      double phi    = phiDist(rng);
+      double eta    = etaDist(rng);
+      double theta  = 2 * atan(exp(-eta));
+      double pt     = ptDist(rng);
+      double p      = pt / sin(theta);
+      double charge = qDist(rng) > 0.5 ? 1. : -1.;
+      double qop    = charge / p;
+      double t      = m_cfg.tSigma * gauss(rng);
+      // parameters
+      Acts::BoundVector pars;
+      pars << d0, z0, phi, theta, qop, t;
+      // some screen output
+
+      Acts::Vector3D sPosition(0., 0., 0.);
+      Acts::Vector3D sMomentum(0., 0., 0.);
+
+      // The covariance generation
+      auto cov = generateCovariance(rng, gauss);
+
+      // execute the test for charged particles
+      PropagationOutput pOutput;
+      if (charge) {
+        // charged extrapolation - with hit recording
+        Acts::BoundParameters startParameters(
+            context.geoContext, std::move(cov), std::move(pars), surface);
+        sPosition = startParameters.position();
+        sMomentum = startParameters.momentum();
+        pOutput
+            = executeTest<Acts::TrackParameters>(context, startParameters);
+      } else {
+        // execute the test for neeutral particles
+        Acts::NeutralBoundParameters neutralParameters(
+            context.geoContext, std::move(cov), std::move(pars), surface);
+        sPosition = neutralParameters.position();
+        sMomentum = neutralParameters.momentum();
+        pOutput
+            = executeTest<Acts::NeutralParameters>(context, neutralParameters);
+      }
+      // Record the propagator steps or the surface intersections
+      propagationSteps[it] = std::move(pOutput.steps);
+      intersections[it]    = std::move(pOutput.intersections);
+      for (auto& intersection : intersections[it]) { intersection.track = it; }
+      if (m_cfg.recordMaterialInteractions
+          && pOutput.material.materialInteractions.size()) {
+        // Create a recorded material track
+        RecordedMaterialTrack rmTrack;
+        // Start position
+        rmTrack.first.first = std::move(sPosition);
+        // Start momentum
+        rmTrack.first.second = std::move(sMomentum);
+        // The material
+        rmTrack.second = std::move(pOutput.material);
+        // push it it
+        materialTracks[it] = std::move(rmTrack);
+      }
     }
-    // Record the propagator steps
-    propagationSteps.push_back(std::move(pOutput.first));
-    if (m_cfg.recordMaterialInteractions
-        && pOutput.second.materialInteractions.size()) {
-      // Create a recorded material track
-      RecordedMaterialTrack rmTrack;
-      // Start position
-      rmTrack.first.first = std::move(sPosition);
-      // Start momentum
-      rmTrack.first.second = std::move(sMomentum);
-      // The material
-      rmTrack.second = std::move(pOutput.second);
-      // push it it
-      recordedMaterial.push_back(std::move(rmTrack));
+  };
+
+  if ((0u < m_cfg.minTestsPerTask) and (m_cfg.minTestsPerTask < m_cfg.ntests)) {
+    // a blocked range is only split if it is larger than the grain size and
+    // then into halves, i.e. this grain size ensures the minimum task size.
+    const size_t grainSize = 2 * m_cfg.minTestsPerTask - 1;
+    // isolation prevents a thread waiting for the tests of this event from
+    // picking up a different event.
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(
+          tbb::blocked_range<size_t>(0, m_cfg.ntests, grainSize),
+          [&](const tbb::blocked_range<size_t>& r) {
+            runTests(r.begin(), r.end());
+          });
+    });
+  } else {
+    runTests(0, m_cfg.ntests);
+  }
+
+  // Keep the recorded material tracks in the test order
+  std::vector<RecordedMaterialTrack> recordedMaterial;
+  for (auto& materialTrack : materialTracks) {
+    if (materialTrack) {
+      recordedMaterial.push_back(std::move(*materialTrack));
     }
   }
 
-  // Write the propagation step data to the event store
-  context.eventStore.add(m_cfg.propagationStepCollection,
-                         std::move(propagationSteps));
+  if (m_cfg.mode == 0) {
+    size_t numSteps = 0;
+    for (const auto& steps : propagationSteps) { numSteps += steps.size(); }
+    ACTS_DEBUG("Recorded " << numSteps << " steps ("
+                           << (numSteps * sizeof(Acts::detail::Step)) / 1024
+                           << " kB) for " << m_cfg.ntests << " tests");
+
+    // Write the propagation step data to the event store
+    context.eventStore.add(m_cfg.propagationStepCollection,
+                           std::move(propagationSteps));
+  } else {
+    // Concatenate the surface intersections in the test order
+    std::vector<SurfaceIntersection> surfaceIntersections;
+    for (auto& testIntersections : intersections) {
+      surfaceIntersections.insert(
+          surfaceIntersections.end(),
+          std::make_move_iterator(testIntersections.begin()),
+          std::make_move_iterator(testIntersections.end()));
+    }
+    ACTS_DEBUG("Recorded " << surfaceIntersections.size()
+                           << " surface intersections for " << m_cfg.ntests
+                           << " tests");
+
+    // Write the surface intersections to the event store
+    context.eventStore.add(m_cfg.propagationIntersectionCollection,
+                           std::move(surfaceIntersections));
+  }
 
   // Write the recorded material to the event store
   if (m_cfg.recordMaterialInteractions) {
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <iostream>
+#include <stdexcept>
 #include "ACTFW/Utilities/Options.hpp"
 #include "Acts/Utilities/Logger.hpp"
 #include "Acts/Utilities/Units.hpp"
@@ -40,7 +41,17 @@ namespace Options {
         "Propgation type: 0 (StraightLine), 1 (Eigen), 2 (Atlas).")(
         "prop-mode",
         po::value<int>()->default_value(0),
-        "Propgation modes: 0 (inside-out), 1 (surface to surface).")(
+        "Propgation modes: 0 (inside-out), 1 (surface intersections).")(
+        "prop-target-volumes",
+        po::value<read_series>()->multitoken()->default_value({}),
+        "Volume ids of the target surfaces in the surface mode.")(
+        "prop-target-layers",
+        po::value<read_series>()->multitoken()->default_value({}),
+        "Volume and layer id pairs of the target surfaces in the surface "
+        "mode. All reached surfaces are targets without any selection.")(
+        "prop-intersection-collection",
+        po::value<std::string>()->default_value("propagation-intersections"),
+        "Propagation surface intersection collection.")(
         "prop-cov",
         po::value<bool>()->default_value(false),
         "Propagate (random) test covariances.")(
@@ -59,6 +70,9 @@ namespace Options {
         "prop-ntests",
         po::value<size_t>()->default_value(1000),
         "Number of tests performed.")(
+        "prop-tests-per-task",
+        po::value<size_t>()->default_value(0),
+        "Minimum number of tests per parallel task; 0 runs them serially.")(
         "prop-d0-sigma",
         po::value<double>()->default_value(15_um),
         "Sigma of the transverse impact parameter [in mm].")(
@@ -91,6 +105,21 @@ namespace Options {
         po::value<read_range>()->multitoken()->default_value(
             {100_MeV, 100_GeV}),
         "Transverse momentum range for proprapolated tracks [in GeV].")(
+        "prop-record-sensitive",
+        po::value<bool>()->default_value(true),
+        "Record the steps on sensitive surfaces, drop them otherwise.")(
+        "prop-record-material-steps",
+        po::value<bool>()->default_value(true),
+        "Record the steps on surfaces with material, drop them otherwise.")(
+        "prop-record-boundary",
+        po::value<bool>()->default_value(true),
+        "Record the steps on boundary surfaces, drop them otherwise.")(
+        "prop-step-decimation",
+        po::value<size_t>()->default_value(1),
+        "Record every n-th of all other steps, 0 records none of them.")(
+        "prop-max-steps-per-track",
+        po::value<size_t>()->default_value(0),
+        "Record only the last steps of each track, 0 records all of them.")(
         "prop-max-stepsize",
         po::value<double>()->default_value(3_m),
         "Maximum step size for the propagation [in mm].")(
@@ -144,11 +173,41 @@ namespace Options {
     pAlgConfig.ptLoopers = vm["prop-pt-loopers"].template as<double>() * 1_GeV;
     pAlgConfig.maxStepSize
         = vm["prop-max-stepsize"].template as<double>() * 1_mm;
+    pAlgConfig.minTestsPerTask
+        = vm["prop-tests-per-task"].template as<size_t>();
+
+    /// The step recording
+    pAlgConfig.recordSensitiveSteps
+        = vm["prop-record-sensitive"].template as<bool>();
+    pAlgConfig.recordMaterialSteps
+        = vm["prop-record-material-steps"].template as<bool>();
+    pAlgConfig.recordBoundarySteps
+        = vm["prop-record-boundary"].template as<bool>();
+    pAlgConfig.stepDecimation
+        = vm["prop-step-decimation"].template as<size_t>();
+    pAlgConfig.maxStepsPerTrack
+        = vm["prop-max-steps-per-track"].template as<size_t>();
 
     pAlgConfig.propagationStepCollection
         = vm["prop-step-collection"].template as<std::string>();
     pAlgConfig.propagationMaterialCollection
         = vm["prop-material-collection"].template as<std::string>();
+    pAlgConfig.propagationIntersectionCollection
+        = vm["prop-intersection-collection"].template as<std::string>();
+
+    /// The target surfaces of the surface mode
+    for (auto volume : vm["prop-target-volumes"].template as<read_series>()) {
+      pAlgConfig.targetSelection.push_back(
+          Acts::GeometryID().setVolume(volume));
+    }
+    auto layers = vm["prop-target-layers"].template as<read_series>();
+    if ((layers.size() % 2) != 0) {
+      throw std::invalid_argument("Incomplete target volume and layer ids");
+    }
+    for (size_t i = 0; i < layers.size(); i += 2) {
+      pAlgConfig.targetSelection.push_back(
+          Acts::GeometryID().setVolume(layers[i]).setLayer(layers[i + 1]));
+    }
 
     /// The covariance transport
     if (vm["prop-cov"].template as<bool>()) {
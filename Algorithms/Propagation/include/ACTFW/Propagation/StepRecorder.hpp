@@ -0,0 +1,137 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Acts/Propagator/detail/SteppingLogger.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+
+namespace FW {
+
+/// Propagation actor that records a configurable selection of steps.
+///
+/// Steps on sensitive, material, or boundary surfaces are recorded if the
+/// flag of any of their surface types is set and dropped otherwise. All other
+/// steps are decimated and only every n-th one is recorded. Optionally, only
+/// the last steps of each track are kept in a fixed-size ring buffer. The
+/// default configuration records every step, identical to the Acts stepping
+/// logger.
+struct StepRecorder
+{
+  /// Record steps on sensitive surfaces; drop them otherwise.
+  bool sensitive = true;
+  /// Record steps on surfaces with material; drop them otherwise.
+  bool material = true;
+  /// Record steps on boundary surfaces; drop them otherwise.
+  bool boundary = true;
+  /// Record every n-th of all other steps; zero records none of them.
+  size_t decimation = 1;
+  /// Maximum number of recorded steps; zero means no limit.
+  size_t maxSteps = 0;
+
+  struct this_result
+  {
+    /// The recorded steps; possibly out of order for a limited ring buffer.
+    std::vector<Acts::detail::Step> steps;
+    /// Number of recorded steps including the overwritten ones.
+    size_t numRecorded = 0;
+    /// Number of steps considered for the decimation.
+    size_t numDecimated = 0;
+  };
+  using result_type = this_result;
+
+  /// Record the current step if it is selected.
+  ///
+  /// @param state is the mutable propagator state object
+  /// @param stepper The stepper in use
+  /// @param result is the mutable result state object
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  operator()(propagator_state_t& state,
+             const stepper_t&    stepper,
+             result_type&        result) const
+  {
+    // don't log if you have reached the target
+    if (state.navigation.targetReached) { return; }
+
+    const Acts::Surface* surface = state.navigation.currentSurface;
+    const auto           type    = surface ? classify(*surface) : Type::Other;
+    if (type == Type::Dropped) { return; }
+    if (type == Type::Other) {
+      const bool keep
+          = (0 < decimation) and ((result.numDecimated % decimation) == 0);
+      ++result.numDecimated;
+      if (not keep) { return; }
+    }
+
+    Acts::detail::Step step;
+    step.stepSize = state.stepping.stepSize;
+    step.position = stepper.position(state.stepping);
+    step.momentum = stepper.momentum(state.stepping);
+    if (surface != nullptr) { step.surface = surface->getSharedPtr(); }
+    step.volume = state.navigation.currentVolume;
+
+    // overwrite the oldest step once the ring buffer is full
+    if ((maxSteps == 0) or (result.steps.size() < maxSteps)) {
+      result.steps.push_back(std::move(step));
+    } else {
+      result.steps[result.numRecorded % maxSteps] = std::move(step);
+    }
+    ++result.numRecorded;
+  }
+
+  /// Pure observer interface
+  /// - this does not apply to the step recorder
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  operator()(propagator_state_t& /*state*/, const stepper_t& /*unused*/) const
+  {
+  }
+
+  /// Move the recorded steps out of the result in propagation order.
+  ///
+  /// @param result is the result of a finished propagation
+  static std::vector<Acts::detail::Step>
+  takeSteps(result_type& result)
+  {
+    auto& steps = result.steps;
+    if (steps.size() < result.numRecorded) {
+      // the oldest step is the next one to be overwritten
+      std::rotate(steps.begin(),
+                  steps.begin() + (result.numRecorded % steps.size()),
+                  steps.end());
+    }
+    return std::move(steps);
+  }
+
+private:
+  enum class Type { Selected, Dropped, Other };
+
+  /// Surfaces of any enabled type are selected; surfaces that only have
+  /// disabled types are dropped. Other surfaces are decimated.
+  Type
+  classify(const Acts::Surface& surface) const
+  {
+    const auto geoID       = surface.geoID();
+    const bool isSensitive = (geoID.sensitive() != 0);
+    const bool hasMaterial = (surface.surfaceMaterial() != nullptr);
+    const bool isBoundary  = (geoID.boundary() != 0);
+    if ((sensitive and isSensitive) or (material and hasMaterial)
+        or (boundary and isBoundary)) {
+      return Type::Selected;
+    }
+    if (isSensitive or hasMaterial or isBoundary) { return Type::Dropped; }
+    return Type::Other;
+  }
+};
+
+}  // namespace FW
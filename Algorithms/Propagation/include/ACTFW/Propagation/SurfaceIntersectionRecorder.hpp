@@ -0,0 +1,105 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "ACTFW/Utilities/GeometryHierarchyMap.hpp"
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace FW {
+
+/// Compact record of a track crossing a target surface.
+struct SurfaceIntersection
+{
+  /// Index of the track within the event.
+  size_t track = 0;
+  /// Geometry identifier of the crossed surface.
+  Acts::GeometryID geoId;
+  /// Global position at the crossing.
+  Acts::Vector3D position = Acts::Vector3D::Zero();
+  /// Global momentum at the crossing.
+  Acts::Vector3D momentum = Acts::Vector3D::Zero();
+  /// Path length from the start parameters.
+  double pathLength = 0;
+};
+
+/// Propagation actor that records the crossings of selected target surfaces.
+///
+/// A surface is recorded when the navigator reaches it, i.e. the targets are
+/// limited to the surfaces that are resolved by the navigator: sensitive and
+/// material surfaces, layer and approach surfaces, and volume boundaries. The
+/// selection uses the geometry hierarchy; selecting a layer records all its
+/// surfaces. Contrary to the step recorder no other step is stored. Surfaces
+/// without a geometry identifier, e.g. the start perigee, are never recorded.
+struct SurfaceIntersectionRecorder
+{
+  // selection only requires existence; vector<bool> can not be used
+  struct Selected
+  {
+  };
+  using Selection = GeometryHierarchyMap<Selected>;
+
+  /// Selected target surfaces; all reached surfaces of the tracking geometry
+  /// are recorded if not set or empty. The selection is not owned and must
+  /// outlive the propagation. It is only looked up for reached surfaces and
+  /// not for every step.
+  const Selection* selection = nullptr;
+
+  struct this_result
+  {
+    /// The recorded intersections in propagation order.
+    std::vector<SurfaceIntersection> intersections;
+  };
+  using result_type = this_result;
+
+  /// Record the current surface if it is selected.
+  ///
+  /// @param state is the mutable propagator state object
+  /// @param stepper The stepper in use
+  /// @param result is the mutable result state object
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  operator()(propagator_state_t& state,
+             const stepper_t&    stepper,
+             result_type&        result) const
+  {
+    const Acts::Surface* surface = state.navigation.currentSurface;
+    if (surface == nullptr) { return; }
+
+    // surfaces outside the tracking geometry, e.g. the start perigee, have
+    // no identifier and are never targets
+    const auto geoId = surface->geoID();
+    if (geoId.value() == 0) { return; }
+    if (selection and not selection->empty()
+        and not selection->find(geoId)) {
+      return;
+    }
+
+    SurfaceIntersection intersection;
+    intersection.geoId      = geoId;
+    intersection.position   = stepper.position(state.stepping);
+    intersection.momentum   = stepper.momentum(state.stepping);
+    intersection.pathLength = state.stepping.pathAccumulated;
+    result.intersections.push_back(std::move(intersection));
+  }
+
+  /// Pure observer interface
+  /// - this does not apply to the intersection recorder
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  operator()(propagator_state_t& /*state*/, const stepper_t& /*unused*/) const
+  {
+  }
+};
+
+}  // namespace FW
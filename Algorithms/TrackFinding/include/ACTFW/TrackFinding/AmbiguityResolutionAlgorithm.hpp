@@ -0,0 +1,70 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <string>
+
+#include "ACTFW/Framework/BareAlgorithm.hpp"
+
+namespace FW {
+
+/// Resolve shared measurements between track candidates.
+///
+/// The worst track candidate is removed iteratively until no remaining track
+/// shares more than the allowed fraction of its measurements with other
+/// tracks. Candidates are ordered by their fraction of shared measurements and
+/// then by their quality score, i.e. chi2/ndf for trajectories and the number
+/// of hits for proto tracks. The number of tracks using each measurement is
+/// kept in an occupancy array and the candidates in a priority queue that is
+/// only updated for the tracks affected by a removal. The cost thus scales
+/// with the total number of measurements on all tracks instead of quadratic
+/// with the number of tracks.
+///
+/// Either proto tracks or trajectories can be resolved. Proto tracks use the
+/// hit indices directly; the measurements of trajectories are identified via
+/// their position in the input source links collection. The surviving tracks
+/// are written in their input order. Input trajectories are consumed, i.e.
+/// they are removed from the event store and the survivors are moved to the
+/// output instead of being copied.
+class AmbiguityResolutionAlgorithm final : public BareAlgorithm
+{
+public:
+  struct Config
+  {
+    /// Input proto tracks collection; exclusive with the trajectories.
+    std::string inputProtoTracks;
+    /// Output proto tracks collection.
+    std::string outputProtoTracks;
+    /// Input trajectories collection; exclusive with the proto tracks. It is
+    /// consumed and can not be used by later algorithms or writers.
+    std::string inputTrajectories;
+    /// Output trajectories collection.
+    std::string outputTrajectories;
+    /// Input source links collection; only required for trajectories.
+    std::string inputSourceLinks;
+    /// Maximum fraction of shared measurements for a surviving track.
+    double maxSharedFraction = 0.0;
+  };
+
+  AmbiguityResolutionAlgorithm(Config cfg, Acts::Logging::Level lvl);
+
+  ProcessCode
+  execute(const AlgorithmContext& ctx) const final override;
+
+  /// The input tracks and source links; input trajectories are consumed.
+  std::vector<std::string>
+  inputCollections() const final override;
+  std::vector<std::string>
+  consumedCollections() const final override;
+
+private:
+  Config m_cfg;
+};
+
+}  // namespace FW
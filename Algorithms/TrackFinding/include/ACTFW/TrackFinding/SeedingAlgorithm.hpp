@@ -0,0 +1,115 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Framework/BareAlgorithm.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+namespace FW {
+
+class SpacePointContainer;
+
+/// Find track seeds from space point triplets.
+///
+/// Each space point is used as the middle point of a triplet. Bottom and top
+/// candidates are searched in the same and the neighbouring phi/z bins of the
+/// binned space point container. Since the points within each bin are sorted
+/// by radius, the candidates within the allowed radial distance are found by
+/// binary search. Doublets must point back to the collision region; triplets
+/// must have compatible slopes and a helix in the transverse plane through
+/// all three points must satisfy the transverse momentum and impact
+/// parameter requirements.
+///
+/// The phi bins of the space point container must be wide enough to contain
+/// the full bending of the lowest transverse momentum tracks within the
+/// maximum radial distance between points.
+///
+/// Alternatively, the seeds are found with the Acts seed finder. It builds
+/// its own phi/z grid from the space points and replaces the slope tolerance
+/// with a multiple scattering estimate; all other requirements are shared.
+///
+/// The seeds are written as proto tracks with three hits, using the space
+/// point measurement indices, and as initial track parameters estimated at
+/// the bottom space point.
+class SeedingAlgorithm final : public BareAlgorithm
+{
+public:
+  struct Config
+  {
+    /// Input space points collection.
+    std::string inputSpacePoints;
+    /// Output proto tracks collection with three hits per seed.
+    std::string outputProtoTracks;
+    /// Output initial track parameters collection, one entry per seed.
+    std::string outputInitialParameters;
+    /// Radial distance between points within a seed.
+    double deltaRMin = 5 * Acts::UnitConstants::mm;
+    double deltaRMax = 270 * Acts::UnitConstants::mm;
+    /// Maximum slope, i.e. cot(theta), of the seed; the default is |eta|<2.7.
+    double cotThetaMax = 7.40627;
+    /// Maximum slope difference between the bottom and top doublets.
+    double cotThetaTolerance = 0.1;
+    /// Maximum longitudinal distance from the origin at the beamline.
+    double collisionRegion = 250 * Acts::UnitConstants::mm;
+    /// Maximum transverse impact parameter.
+    double impactMax = 10 * Acts::UnitConstants::mm;
+    /// Minimum transverse momentum.
+    double minPt = 500 * Acts::UnitConstants::MeV;
+    /// Magnetic field along the beamline; assumed to be homogeneous.
+    double bFieldInZ = 2 * Acts::UnitConstants::T;
+    /// Maximum number of seeds per middle space point; best impact first.
+    std::size_t maxSeedsPerMiddle = 5u;
+    /// Use the Acts seed finder instead of the built-in triplet search.
+    bool useActsSeedfinder = false;
+    /// Multiple scattering estimate; only used by the Acts seed finder.
+    double sigmaScattering  = 5.0;
+    double radLengthPerSeed = 0.05;
+    /// Uncertainties for the initial track parameters.
+    double sigmaLoc0  = 1 * Acts::UnitConstants::mm;
+    double sigmaLoc1  = 1 * Acts::UnitConstants::mm;
+    double sigmaPhi   = 0.02;
+    double sigmaTheta = 0.02;
+    double sigmaPRel  = 0.1;
+    double sigmaTime  = 1 * Acts::UnitConstants::ns;
+  };
+
+  SeedingAlgorithm(Config cfg, Acts::Logging::Level lvl);
+
+  ProcessCode
+  execute(const AlgorithmContext& ctx) const final override;
+
+private:
+  /// Find seeds with the built-in triplet search.
+  void
+  findTriplets(const SpacePointContainer& spacePoints,
+               ProtoTrackContainer&       protoTracks,
+               TrackParametersContainer&  parameters) const;
+  /// Find seeds with the Acts seed finder.
+  void
+  findActsSeeds(const SpacePointContainer& spacePoints,
+                ProtoTrackContainer&       protoTracks,
+                TrackParametersContainer&  parameters) const;
+  /// Store a seed and estimate its initial track parameters.
+  void
+  addSeed(const SpacePointContainer& spacePoints,
+          std::size_t                bottom,
+          std::size_t                middle,
+          std::size_t                top,
+          ProtoTrackContainer&       protoTracks,
+          TrackParametersContainer&  parameters) const;
+
+  Config m_cfg;
+};
+
+}  // namespace FW
@@ -0,0 +1,60 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "ACTFW/EventData/SpacePoints.hpp"
+#include "ACTFW/Framework/BareAlgorithm.hpp"
+#include "ACTFW/Utilities/GeometryHierarchyMap.hpp"
+#include "Acts/Geometry/GeometryID.hpp"
+
+namespace FW {
+
+/// Construct space points from planar clusters.
+///
+/// The local cluster positions of each module are transformed into the global
+/// frame together. The local position covariance is rotated into the global
+/// frame and projected onto the transverse radius and the z direction. All
+/// space points are sorted into a phi/z binned container for seeding. The
+/// measurement index of each space point is the index of its cluster in the
+/// input container.
+class SpacePointMaker final : public BareAlgorithm
+{
+public:
+  struct Config
+  {
+    /// Input planar clusters collection.
+    std::string inputClusters;
+    /// Output space points collection.
+    std::string outputSpacePoints;
+    /// Geometry selection; the geometry identifiers can describe volumes,
+    /// layers, or modules. All clusters are used if it is empty.
+    std::vector<Acts::GeometryID> geometrySelection;
+    /// Space point binning in phi and z.
+    SpacePointBinning binning;
+  };
+
+  SpacePointMaker(Config cfg, Acts::Logging::Level lvl);
+
+  ProcessCode
+  execute(const AlgorithmContext& ctx) const final override;
+
+private:
+  // selection only requires existence; vector<bool> can not be used
+  struct Selected
+  {
+  };
+
+  Config                         m_cfg;
+  GeometryHierarchyMap<Selected> m_selection;
+};
+
+}  // namespace FW
@@ -0,0 +1,113 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/EventData/TrackFindingStatistics.hpp"
+#include "ACTFW/Framework/BareAlgorithm.hpp"
+#include "ACTFW/Plugins/BField/BFieldOptions.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/TrackFinder/CKFSourceLinkSelector.hpp"
+#include "Acts/TrackFinder/CombinatorialKalmanFilter.hpp"
+
+namespace FW {
+
+/// Find tracks with the combinatorial Kalman filter.
+///
+/// The track finding starts from each set of initial track parameters, e.g.
+/// from seeding, and follows the track through the detector. On each surface
+/// the compatible measurements are selected by their chi2 with respect to the
+/// predicted track state. Each compatible measurement creates a new branch,
+/// i.e. a single set of initial parameters can result in multiple track
+/// candidates. The best candidates of each seed are written as separate
+/// trajectories that share the multi trajectory of the seed.
+///
+/// The source links are ordered by geometry identifier and are given to the
+/// track finder as a single contiguous sequence per event; the measurements
+/// on each surface are thus adjacent in memory for the candidate lookup. The
+/// combinatorial Kalman filter of this Acts version only accepts such a flat
+/// sequence and builds its own per-surface lookup for every seed; a per-event
+/// surface index can not be passed to it.
+///
+/// The per-event counts of seeds, candidates, and tracks are optionally
+/// written to the event store, e.g. to be summarized at the end of the run.
+class TrackFindingAlgorithm final : public BareAlgorithm
+{
+public:
+  using TrackFinderResult = Acts::Result<
+      Acts::CombinatorialKalmanFilterResult<SimSourceLink>>;
+  /// Track finder function that takes input measurements, initial track
+  /// parameters, and finder options and returns the found track candidates.
+  using TrackFinderFunction = std::function<TrackFinderResult(
+      const std::vector<SimSourceLink>&,
+      const TrackParameters&,
+      const Acts::CombinatorialKalmanFilterOptions<
+          Acts::CKFSourceLinkSelector>&)>;
+
+  /// Create the track finder function implementation.
+  ///
+  /// The magnetic field is intentionally given by-value since the variant
+  /// contains shared_ptr anyways.
+  static TrackFinderFunction
+  makeTrackFinderFunction(
+      std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry,
+      Options::BFieldVariant                        magneticField,
+      Acts::Logging::Level                          lvl);
+
+  struct Config
+  {
+    /// Input source links collection.
+    std::string inputSourceLinks;
+    /// Input initial track parameters collection, e.g. from seeding.
+    std::string inputInitialTrackParameters;
+    /// Output found trajectories collection.
+    std::string outputTrajectories;
+    /// Optional output track finding statistics.
+    std::string outputStatistics;
+    /// Type erased track finder function.
+    TrackFinderFunction findTracks;
+    /// Maximum chi2 for a measurement to be compatible with the prediction.
+    double chi2Max = 15.0;
+    /// Maximum number of compatible measurements per surface, i.e. the
+    /// maximum number of branches created on a single surface.
+    std::size_t maxBranchesPerSurface = 10u;
+    /// Maximum number of track candidates kept per initial parameters; the
+    /// candidates with the most measurements and the lowest chi2 are kept.
+    std::size_t maxTracksPerSeed = 10u;
+  };
+
+  /// Constructor of the track finding algorithm
+  ///
+  /// @param cfg is the config struct to configure the algorithm
+  /// @param lvl is the logging level
+  TrackFindingAlgorithm(Config cfg, Acts::Logging::Level lvl);
+
+  /// Framework execute method of the track finding algorithm
+  ///
+  /// @param ctx is the algorithm context that holds event-wise information
+  /// @return a process code to steer the algorithm flow
+  ProcessCode
+  execute(const AlgorithmContext& ctx) const final override;
+
+private:
+  Config m_cfg;
+  /// Measurement selection derived from the configured limits.
+  Acts::CKFSourceLinkSelector::Config m_sourceLinkSelectorCfg;
+  /// Target surface for the track parameters; shared by all events.
+  std::shared_ptr<const Acts::Surface> m_perigeeSurface;
+};
+
+}  // namespace FW
@@ -0,0 +1,282 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/TrackFinding/AmbiguityResolutionAlgorithm.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Utilities/Range.hpp"
+
+namespace {
+/// Measurement indices of all tracks in a compressed row layout.
+struct TrackMeasurements
+{
+  /// Measurements of track i are stored in [offsets[i], offsets[i+1]).
+  std::vector<std::size_t> offsets = {0u};
+  std::vector<std::size_t> indices;
+  /// Quality score for each track; larger values are worse.
+  std::vector<double> scores;
+  /// Upper limit of the measurement indices.
+  std::size_t numMeasurements = 0u;
+
+  void
+  add(std::size_t index)
+  {
+    indices.push_back(index);
+    numMeasurements = std::max(numMeasurements, index + 1);
+  }
+  void
+  finishTrack(double score)
+  {
+    offsets.push_back(indices.size());
+    scores.push_back(score);
+  }
+  std::size_t
+  size() const
+  {
+    return scores.size();
+  }
+  auto
+  measurements(std::size_t itrack) const
+  {
+    return FW::makeRange(std::next(indices.begin(), offsets[itrack]),
+                         std::next(indices.begin(), offsets[itrack + 1]));
+  }
+};
+
+/// Candidate entry in the removal queue.
+struct Candidate
+{
+  double      sharedFraction;
+  double      score;
+  std::size_t track;
+  std::size_t nShared;
+};
+
+/// Priority of the candidates; the worst candidate is at the top.
+struct LessWorse
+{
+  bool
+  operator()(const Candidate& lhs, const Candidate& rhs) const
+  {
+    if (lhs.sharedFraction != rhs.sharedFraction) {
+      return lhs.sharedFraction < rhs.sharedFraction;
+    }
+    if (lhs.score != rhs.score) { return lhs.score < rhs.score; }
+    // ensure a reproducible order; later tracks are removed first
+    return lhs.track < rhs.track;
+  }
+};
+
+/// Greedily remove the worst tracks until the shared fraction is acceptable.
+///
+/// @return flag for each track whether it survived
+std::vector<bool>
+resolveAmbiguities(const TrackMeasurements& tracks, double maxSharedFraction)
+{
+  // number of tracks using each measurement
+  std::vector<std::size_t> occupancy(tracks.numMeasurements, 0u);
+  for (auto imeas : tracks.indices) { occupancy[imeas] += 1u; }
+  // tracks using each measurement in a compressed row layout
+  std::vector<std::size_t> userOffsets(tracks.numMeasurements + 1, 0u);
+  std::partial_sum(
+      occupancy.begin(), occupancy.end(), std::next(userOffsets.begin()));
+  std::vector<std::size_t> users(tracks.indices.size());
+  std::vector<std::size_t> fill(userOffsets.begin(),
+                                std::prev(userOffsets.end()));
+  for (std::size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    for (auto imeas : tracks.measurements(itrack)) {
+      users[fill[imeas]++] = itrack;
+    }
+  }
+
+  std::vector<bool>        alive(tracks.size(), true);
+  std::vector<std::size_t> nShared(tracks.size(), 0u);
+
+  auto makeCandidate = [&](std::size_t itrack) {
+    const auto nMeasurements = tracks.measurements(itrack).size();
+    return Candidate{double(nShared[itrack]) / nMeasurements,
+                     tracks.scores[itrack],
+                     itrack,
+                     nShared[itrack]};
+  };
+
+  // only tracks with shared measurements can be removed
+  std::priority_queue<Candidate, std::vector<Candidate>, LessWorse> queue;
+  for (std::size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    for (auto imeas : tracks.measurements(itrack)) {
+      if (1u < occupancy[imeas]) { nShared[itrack] += 1u; }
+    }
+    if (0u < nShared[itrack]) { queue.push(makeCandidate(itrack)); }
+  }
+
+  while (not queue.empty()) {
+    const auto candidate = queue.top();
+    queue.pop();
+    // the shared count only decreases; outdated entries are skipped
+    if (not alive[candidate.track]
+        or (candidate.nShared != nShared[candidate.track])) {
+      continue;
+    }
+    // this is the worst remaining track; all others are acceptable as well
+    if (candidate.sharedFraction <= maxSharedFraction) { break; }
+
+    alive[candidate.track] = false;
+    for (auto imeas : tracks.measurements(candidate.track)) {
+      occupancy[imeas] -= 1u;
+      if (occupancy[imeas] != 1u) { continue; }
+      // the measurement is no longer shared for the last remaining user
+      for (std::size_t iuser = userOffsets[imeas];
+           iuser < userOffsets[imeas + 1];
+           ++iuser) {
+        const auto itrack = users[iuser];
+        if (not alive[itrack]) { continue; }
+        nShared[itrack] -= 1u;
+        if (0u < nShared[itrack]) { queue.push(makeCandidate(itrack)); }
+        break;
+      }
+    }
+  }
+  return alive;
+}
+}  // namespace
+
+FW::AmbiguityResolutionAlgorithm::AmbiguityResolutionAlgorithm(
+    FW::AmbiguityResolutionAlgorithm::Config cfg,
+    Acts::Logging::Level                     lvl)
+  : BareAlgorithm("AmbiguityResolutionAlgorithm", lvl), m_cfg(std::move(cfg))
+{
+  if (m_cfg.inputProtoTracks.empty() == m_cfg.inputTrajectories.empty()) {
+    throw std::invalid_argument(
+        "Exactly one of input proto tracks or trajectories is required");
+  }
+  if (not m_cfg.inputProtoTracks.empty() and m_cfg.outputProtoTracks.empty()) {
+    throw std::invalid_argument("Missing output proto tracks collection");
+  }
+  if (not m_cfg.inputTrajectories.empty()) {
+    if (m_cfg.outputTrajectories.empty()) {
+      throw std::invalid_argument("Missing output trajectories collection");
+    }
+    if (m_cfg.inputSourceLinks.empty()) {
+      throw std::invalid_argument("Missing input source links collection");
+    }
+  }
+  if (not(0 <= m_cfg.maxSharedFraction and m_cfg.maxSharedFraction <= 1)) {
+    throw std::invalid_argument("Invalid maximum shared fraction");
+  }
+}
+
+FW::ProcessCode
+FW::AmbiguityResolutionAlgorithm::execute(const AlgorithmContext& ctx) const
+{
+  TrackMeasurements tracks;
+
+  if (not m_cfg.inputProtoTracks.empty()) {
+    const auto& protoTracks
+        = ctx.eventStore.get<ProtoTrackContainer>(m_cfg.inputProtoTracks);
+
+    // tracks with less hits are worse
+    for (const auto& protoTrack : protoTracks) {
+      for (auto hitIndex : protoTrack) { tracks.add(hitIndex); }
+      tracks.finishTrack(-double(protoTrack.size()));
+    }
+    const auto alive = resolveAmbiguities(tracks, m_cfg.maxSharedFraction);
+
+    ProtoTrackContainer resolved;
+    for (std::size_t itrack = 0; itrack < protoTracks.size(); ++itrack) {
+      if (alive[itrack]) { resolved.push_back(protoTracks[itrack]); }
+    }
+    ACTS_DEBUG("Kept " << resolved.size() << " of " << protoTracks.size()
+                       << " proto tracks");
+    ctx.eventStore.add(m_cfg.outputProtoTracks, std::move(resolved));
+    return ProcessCode::SUCCESS;
+  }
+
+  const auto& sourceLinks
+      = ctx.eventStore.get<SimSourceLinkContainer>(m_cfg.inputSourceLinks);
+  // the input is consumed and the surviving trajectories are moved
+  auto trajectories
+      = ctx.eventStore.pop<TrajectoryContainer>(m_cfg.inputTrajectories);
+
+  // tracks with larger chi2/ndf are worse
+  for (std::size_t itrack = 0; itrack < trajectories.size(); ++itrack) {
+    const auto& trajectory = trajectories[itrack];
+    if (not trajectory.hasTrajectory()) {
+      tracks.finishTrack(std::numeric_limits<double>::infinity());
+      continue;
+    }
+    const auto& [trackTip, states] = trajectory.trajectory();
+    double      chi2               = 0.0;
+    int         ndf                = 0;
+    bool        isValid            = true;
+    states.visitBackwards(trackTip, [&](const auto& state) {
+      if (not state.typeFlags().test(Acts::TrackStateFlag::MeasurementFlag)) {
+        return true;
+      }
+      // identify the measurement by its position in the input collection
+      const auto& sourceLink = state.uncalibrated();
+      const auto  geoId      = sourceLink.geometryId();
+      const auto  module     = selectModule(sourceLinks, geoId);
+      const auto  it
+          = std::find(module.begin(), module.end(), sourceLink);
+      if (it == module.end()) {
+        isValid = false;
+        return false;
+      }
+      tracks.add(std::distance(sourceLinks.begin(), it));
+      chi2 += state.chi2();
+      ndf += state.calibratedSize();
+      return true;
+    });
+    if (not isValid) {
+      ACTS_FATAL("Trajectory " << itrack << " contains unknown measurements");
+      return ProcessCode::ABORT;
+    }
+    // the measurements constrain the five spatial track parameters
+    ndf -= 5;
+    tracks.finishTrack((0 < ndf) ? (chi2 / ndf)
+                                 : std::numeric_limits<double>::infinity());
+  }
+  const auto alive = resolveAmbiguities(tracks, m_cfg.maxSharedFraction);
+
+  TrajectoryContainer resolved;
+  for (std::size_t itrack = 0; itrack < trajectories.size(); ++itrack) {
+    if (alive[itrack]) { resolved.push_back(std::move(trajectories[itrack])); }
+  }
+  ACTS_DEBUG("Kept " << resolved.size() << " of " << trajectories.size()
+                     << " trajectories with " << tracks.indices.size()
+                     << " measurements");
+  ctx.eventStore.add(m_cfg.outputTrajectories, std::move(resolved));
+  return ProcessCode::SUCCESS;
+}
+
+std::vector<std::string>
+FW::AmbiguityResolutionAlgorithm::inputCollections() const
+{
+  if (m_cfg.inputTrajectories.empty()) { return {m_cfg.inputProtoTracks}; }
+  return {m_cfg.inputTrajectories, m_cfg.inputSourceLinks};
+}
+
+std::vector<std::string>
+FW::AmbiguityResolutionAlgorithm::consumedCollections() const
+{
+  if (m_cfg.inputTrajectories.empty()) { return {}; }
+  return {m_cfg.inputTrajectories};
+}
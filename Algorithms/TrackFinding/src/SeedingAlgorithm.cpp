@@ -0,0 +1,400 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/TrackFinding/SeedingAlgorithm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/EventData/SpacePoints.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "Acts/Seeding/BinFinder.hpp"
+#include "Acts/Seeding/BinnedSPGroup.hpp"
+#include "Acts/Seeding/Seed.hpp"
+#include "Acts/Seeding/SeedFilter.hpp"
+#include "Acts/Seeding/Seedfinder.hpp"
+#include "Acts/Seeding/SpacePointGrid.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+
+namespace {
+/// Triplet candidate for a fixed middle space point.
+struct Triplet
+{
+  std::size_t bottom;
+  std::size_t top;
+  double      impact;
+};
+
+/// Space point type for the Acts seed finder.
+///
+/// Refers back to the space point in the binned container by its index.
+struct SeedfinderSpacePoint
+{
+  std::size_t index;
+  float       posX;
+  float       posY;
+  float       posZ;
+  float       varianceR;
+  float       varianceZ;
+
+  float
+  x() const
+  {
+    return posX;
+  }
+  float
+  y() const
+  {
+    return posY;
+  }
+  float
+  z() const
+  {
+    return posZ;
+  }
+};
+
+/// Index range [begin,end) of values within [lower,upper) in a sorted range.
+std::pair<std::size_t, std::size_t>
+findSortedRange(const std::vector<float>& values,
+                std::size_t               begin,
+                std::size_t               end,
+                double                    lower,
+                double                    upper)
+{
+  auto b  = std::next(values.begin(), begin);
+  auto e  = std::next(values.begin(), end);
+  auto lo = std::lower_bound(b, e, lower);
+  auto hi = std::lower_bound(lo, e, upper);
+  return {begin + std::distance(b, lo), begin + std::distance(b, hi)};
+}
+}  // namespace
+
+FW::SeedingAlgorithm::SeedingAlgorithm(FW::SeedingAlgorithm::Config cfg,
+                                       Acts::Logging::Level         lvl)
+  : BareAlgorithm("SeedingAlgorithm", lvl), m_cfg(std::move(cfg))
+{
+  if (m_cfg.inputSpacePoints.empty()) {
+    throw std::invalid_argument("Missing input space points collection");
+  }
+  if (m_cfg.outputProtoTracks.empty()) {
+    throw std::invalid_argument("Missing output proto tracks collection");
+  }
+  if (m_cfg.outputInitialParameters.empty()) {
+    throw std::invalid_argument(
+        "Missing output initial track parameters collection");
+  }
+  if (not(0 <= m_cfg.deltaRMin and m_cfg.deltaRMin < m_cfg.deltaRMax)) {
+    throw std::invalid_argument("Invalid seed radial distance range");
+  }
+  if (not(0 < m_cfg.minPt)) {
+    throw std::invalid_argument("Non-positive minimum transverse momentum");
+  }
+  if (m_cfg.bFieldInZ == 0) {
+    throw std::invalid_argument("Seeding requires a non-zero magnetic field");
+  }
+  if (m_cfg.maxSeedsPerMiddle == 0u) {
+    throw std::invalid_argument("Missing seeds per middle space point");
+  }
+}
+
+void
+FW::SeedingAlgorithm::addSeed(const SpacePointContainer& spacePoints,
+                              std::size_t                bottom,
+                              std::size_t                middle,
+                              std::size_t                top,
+                              ProtoTrackContainer&       protoTracks,
+                              TrackParametersContainer&  parameters) const
+{
+  const auto& xs      = spacePoints.x();
+  const auto& ys      = spacePoints.y();
+  const auto& zs      = spacePoints.z();
+  const auto& rs      = spacePoints.r();
+  const auto& indices = spacePoints.measurementIndex();
+
+  // circle through all three points, relative to the middle point
+  const double ax      = xs[bottom] - xs[middle];
+  const double ay      = ys[bottom] - ys[middle];
+  const double aa      = ax * ax + ay * ay;
+  const double cx      = xs[top] - xs[middle];
+  const double cy      = ys[top] - ys[middle];
+  const double cc      = cx * cx + cy * cy;
+  const double det     = ax * cy - ay * cx;
+  const double centerX = (aa * cy - ay * cc) / (2 * det);
+  const double centerY = (ax * cc - aa * cx) / (2 * det);
+  const double radius  = std::hypot(centerX, centerY);
+  // positive charges bend clockwise for a field along positive z
+  const double charge = ((0 < det) == (0 < m_cfg.bFieldInZ)) ? 1.0 : -1.0;
+
+  // the direction at the bottom point is tangential to the circle
+  Acts::Vector2D tangent(-(ay - centerY), ax - centerX);
+  tangent /= radius;
+  if ((tangent.x() * ax + tangent.y() * ay) > 0) { tangent = -tangent; }
+
+  // momentum in native units is field times radius for unit charge
+  const double pt       = std::abs(m_cfg.bFieldInZ) * radius;
+  const double cotTheta = (zs[top] - zs[bottom]) / (rs[top] - rs[bottom]);
+  const double p        = pt * std::hypot(1.0, cotTheta);
+
+  const Acts::Vector3D pos(xs[bottom], ys[bottom], zs[bottom]);
+  const Acts::Vector3D mom(pt * tangent.x(), pt * tangent.y(), pt * cotTheta);
+
+  // uncorrelated uncertainties from the configuration
+  const double         sigmaQOverP = m_cfg.sigmaPRel / p;
+  Acts::BoundSymMatrix cov         = Acts::BoundSymMatrix::Zero();
+  cov(Acts::eLOC_0, Acts::eLOC_0)  = m_cfg.sigmaLoc0 * m_cfg.sigmaLoc0;
+  cov(Acts::eLOC_1, Acts::eLOC_1)  = m_cfg.sigmaLoc1 * m_cfg.sigmaLoc1;
+  cov(Acts::ePHI, Acts::ePHI)      = m_cfg.sigmaPhi * m_cfg.sigmaPhi;
+  cov(Acts::eTHETA, Acts::eTHETA)  = m_cfg.sigmaTheta * m_cfg.sigmaTheta;
+  cov(Acts::eQOP, Acts::eQOP)      = sigmaQOverP * sigmaQOverP;
+  cov(Acts::eT, Acts::eT)          = m_cfg.sigmaTime * m_cfg.sigmaTime;
+
+  protoTracks.push_back({indices[bottom], indices[middle], indices[top]});
+  parameters.emplace_back(
+      std::make_optional(std::move(cov)), pos, mom, charge, 0.0);
+}
+
+void
+FW::SeedingAlgorithm::findTriplets(const SpacePointContainer& spacePoints,
+                                   ProtoTrackContainer&       protoTracks,
+                                   TrackParametersContainer&  parameters) const
+{
+  const auto& binning = spacePoints.binning();
+  const auto& xs      = spacePoints.x();
+  const auto& ys      = spacePoints.y();
+  const auto& zs      = spacePoints.z();
+  const auto& rs      = spacePoints.r();
+
+  // candidate buffers are reused for all middle space points
+  std::vector<std::pair<std::size_t, std::size_t>> neighbours;
+  std::vector<std::size_t>                         bottoms;
+  std::vector<std::size_t>                         tops;
+  std::vector<Triplet>                             triplets;
+
+  // check if a doublet is compatible with the collision region
+  auto isCompatible = [&](std::size_t inner, std::size_t outer) {
+    const double cotTheta = (zs[outer] - zs[inner]) / (rs[outer] - rs[inner]);
+    const double z0       = zs[inner] - rs[inner] * cotTheta;
+    return (std::abs(cotTheta) <= m_cfg.cotThetaMax)
+        and (std::abs(z0) <= m_cfg.collisionRegion);
+  };
+
+  // avoid duplicate neighbours if there are less than three phi bins
+  const auto numPhiNeighbours = std::min<std::size_t>(3u, binning.numPhiBins);
+
+  for (std::size_t iphi = 0; iphi < binning.numPhiBins; ++iphi) {
+    for (std::size_t iz = 0; iz < binning.numZBins; ++iz) {
+      const auto [mBegin, mEnd] = spacePoints.binRange(iphi, iz);
+      if (mBegin == mEnd) { continue; }
+
+      // neighbouring bins wrap around in phi but not in z
+      neighbours.clear();
+      for (std::size_t dphi = 0; dphi < numPhiNeighbours; ++dphi) {
+        const auto jphi
+            = (iphi + binning.numPhiBins + dphi - 1) % binning.numPhiBins;
+        for (auto jz = std::max<std::size_t>(iz, 1u) - 1;
+             jz < std::min(iz + 2, binning.numZBins);
+             ++jz) {
+          neighbours.push_back(spacePoints.binRange(jphi, jz));
+        }
+      }
+
+      for (std::size_t middle = mBegin; middle < mEnd; ++middle) {
+        const double rM = rs[middle];
+
+        // collect compatible bottom and top space points
+        bottoms.clear();
+        tops.clear();
+        for (const auto& [nBegin, nEnd] : neighbours) {
+          const auto [bBegin, bEnd] = findSortedRange(
+              rs, nBegin, nEnd, rM - m_cfg.deltaRMax, rM - m_cfg.deltaRMin);
+          for (auto bottom = bBegin; bottom < bEnd; ++bottom) {
+            if (isCompatible(bottom, middle)) { bottoms.push_back(bottom); }
+          }
+          const auto [tBegin, tEnd] = findSortedRange(
+              rs, nBegin, nEnd, rM + m_cfg.deltaRMin, rM + m_cfg.deltaRMax);
+          for (auto top = tBegin; top < tEnd; ++top) {
+            if (isCompatible(middle, top)) { tops.push_back(top); }
+          }
+        }
+        if (bottoms.empty() or tops.empty()) { continue; }
+
+        // combine doublets into triplets
+        triplets.clear();
+        for (auto bottom : bottoms) {
+          const double cotThetaB
+              = (zs[middle] - zs[bottom]) / (rM - rs[bottom]);
+          const double ax = xs[bottom] - xs[middle];
+          const double ay = ys[bottom] - ys[middle];
+          const double aa = ax * ax + ay * ay;
+          for (auto top : tops) {
+            const double cotThetaT = (zs[top] - zs[middle]) / (rs[top] - rM);
+            if (m_cfg.cotThetaTolerance < std::abs(cotThetaB - cotThetaT)) {
+              continue;
+            }
+            // circle through all three points, relative to the middle point
+            const double cx  = xs[top] - xs[middle];
+            const double cy  = ys[top] - ys[middle];
+            const double cc  = cx * cx + cy * cy;
+            const double det = ax * cy - ay * cx;
+            // straight lines have no defined charge or momentum
+            if (det == 0) { continue; }
+            const double centerX = (aa * cy - ay * cc) / (2 * det);
+            const double centerY = (ax * cc - aa * cx) / (2 * det);
+            const double radius  = std::hypot(centerX, centerY);
+            // momentum in native units is field times radius for unit charge
+            const double pt = std::abs(m_cfg.bFieldInZ) * radius;
+            if (pt < m_cfg.minPt) { continue; }
+            const double impact = std::abs(
+                std::hypot(xs[middle] + centerX, ys[middle] + centerY)
+                - radius);
+            if (m_cfg.impactMax < impact) { continue; }
+            triplets.push_back({bottom, top, impact});
+          }
+        }
+
+        // keep only the best triplets for this middle space point
+        const auto nSeeds = std::min(triplets.size(), m_cfg.maxSeedsPerMiddle);
+        std::partial_sort(triplets.begin(),
+                          std::next(triplets.begin(), nSeeds),
+                          triplets.end(),
+                          [](const Triplet& lhs, const Triplet& rhs) {
+                            return lhs.impact < rhs.impact;
+                          });
+        for (std::size_t iseed = 0; iseed < nSeeds; ++iseed) {
+          addSeed(spacePoints,
+                  triplets[iseed].bottom,
+                  middle,
+                  triplets[iseed].top,
+                  protoTracks,
+                  parameters);
+        }
+      }
+    }
+  }
+}
+
+void
+FW::SeedingAlgorithm::findActsSeeds(const SpacePointContainer& spacePoints,
+                                    ProtoTrackContainer&       protoTracks,
+                                    TrackParametersContainer&  parameters) const
+{
+  using SpacePoint = SeedfinderSpacePoint;
+
+  if (spacePoints.empty()) { return; }
+
+  const auto& binning = spacePoints.binning();
+  const auto& rs      = spacePoints.r();
+
+  std::vector<SpacePoint> points;
+  points.reserve(spacePoints.size());
+  for (std::size_t i = 0; i < spacePoints.size(); ++i) {
+    points.push_back({i,
+                      spacePoints.x()[i],
+                      spacePoints.y()[i],
+                      spacePoints.z()[i],
+                      spacePoints.varianceR()[i],
+                      spacePoints.varianceZ()[i]});
+  }
+  std::vector<const SpacePoint*> pointPtrs;
+  pointPtrs.reserve(points.size());
+  for (const auto& point : points) { pointPtrs.push_back(&point); }
+
+  // the Acts seed finder uses mm, MeV, and kT
+  const float rMax      = *std::max_element(rs.begin(), rs.end());
+  const float bFieldInZ = m_cfg.bFieldInZ / (1000 * Acts::UnitConstants::T);
+  const float minPt     = m_cfg.minPt / Acts::UnitConstants::MeV;
+
+  Acts::SeedFilterConfig filterCfg;
+  filterCfg.maxSeedsPerSpM = m_cfg.maxSeedsPerMiddle;
+
+  Acts::SeedfinderConfig<SpacePoint> finderCfg;
+  finderCfg.seedFilter = std::make_unique<Acts::SeedFilter<SpacePoint>>(
+      Acts::SeedFilter<SpacePoint>(filterCfg));
+  finderCfg.rMax               = rMax;
+  finderCfg.deltaRMin          = m_cfg.deltaRMin;
+  finderCfg.deltaRMax          = m_cfg.deltaRMax;
+  finderCfg.collisionRegionMin = -m_cfg.collisionRegion;
+  finderCfg.collisionRegionMax = m_cfg.collisionRegion;
+  finderCfg.zMin               = binning.zMin;
+  finderCfg.zMax               = binning.zMax;
+  finderCfg.maxSeedsPerSpM     = m_cfg.maxSeedsPerMiddle;
+  finderCfg.cotThetaMax        = m_cfg.cotThetaMax;
+  finderCfg.sigmaScattering    = m_cfg.sigmaScattering;
+  finderCfg.radLengthPerSeed   = m_cfg.radLengthPerSeed;
+  finderCfg.minPt              = minPt;
+  finderCfg.bFieldInZ          = bFieldInZ;
+  finderCfg.impactMax          = m_cfg.impactMax;
+
+  Acts::SpacePointGridConfig gridCfg;
+  gridCfg.bFieldInZ   = bFieldInZ;
+  gridCfg.minPt       = minPt;
+  gridCfg.rMax        = rMax;
+  gridCfg.zMax        = binning.zMax;
+  gridCfg.zMin        = binning.zMin;
+  gridCfg.deltaRMax   = m_cfg.deltaRMax;
+  gridCfg.cotThetaMax = m_cfg.cotThetaMax;
+
+  // the measured variances are used directly
+  auto covariance = [](const SpacePoint& sp, float, float, float) {
+    return Acts::Vector2D(sp.varianceR, sp.varianceZ);
+  };
+  auto binFinder = std::make_shared<Acts::BinFinder<SpacePoint>>();
+  Acts::BinnedSPGroup<SpacePoint> groups(
+      pointPtrs.begin(),
+      pointPtrs.end(),
+      covariance,
+      binFinder,
+      binFinder,
+      Acts::SpacePointGridCreator::createGrid<SpacePoint>(gridCfg),
+      finderCfg);
+  Acts::Seedfinder<SpacePoint> finder(finderCfg);
+
+  for (auto group = groups.begin(); not(group == groups.end()); ++group) {
+    for (const auto& seed : finder.createSeedsForGroup(
+             group.bottom(), group.middle(), group.top())) {
+      const auto& sps = seed.sp();
+      addSeed(spacePoints,
+              sps[0]->index,
+              sps[1]->index,
+              sps[2]->index,
+              protoTracks,
+              parameters);
+    }
+  }
+}
+
+FW::ProcessCode
+FW::SeedingAlgorithm::execute(const AlgorithmContext& ctx) const
+{
+  const auto& spacePoints
+      = ctx.eventStore.get<SpacePointContainer>(m_cfg.inputSpacePoints);
+
+  ProtoTrackContainer      protoTracks;
+  TrackParametersContainer parameters;
+  if (m_cfg.useActsSeedfinder) {
+    findActsSeeds(spacePoints, protoTracks, parameters);
+  } else {
+    findTriplets(spacePoints, protoTracks, parameters);
+  }
+
+  ACTS_DEBUG("Found " << protoTracks.size() << " seeds from "
+                      << spacePoints.size() << " space points");
+  ctx.eventStore.add(m_cfg.outputProtoTracks, std::move(protoTracks));
+  ctx.eventStore.add(m_cfg.outputInitialParameters, std::move(parameters));
+  return ProcessCode::SUCCESS;
+}
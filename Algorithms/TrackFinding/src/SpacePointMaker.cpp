@@ -0,0 +1,112 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/TrackFinding/SpacePointMaker.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Utilities/BatchedTransform.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+FW::SpacePointMaker::SpacePointMaker(FW::SpacePointMaker::Config cfg,
+                                     Acts::Logging::Level        lvl)
+  : BareAlgorithm("SpacePointMaker", lvl), m_cfg(std::move(cfg))
+{
+  if (m_cfg.inputClusters.empty()) {
+    throw std::invalid_argument("Missing input clusters collection");
+  }
+  if (m_cfg.outputSpacePoints.empty()) {
+    throw std::invalid_argument("Missing output space points collection");
+  }
+  // an empty container validates the binning before the first event
+  SpacePointContainer(m_cfg.binning, std::vector<SpacePoint>());
+
+  std::vector<GeometryHierarchyMap<Selected>::InputElement> selection;
+  for (auto geoId : m_cfg.geometrySelection) {
+    selection.emplace_back(geoId, Selected());
+  }
+  m_selection = GeometryHierarchyMap<Selected>(std::move(selection));
+}
+
+FW::ProcessCode
+FW::SpacePointMaker::execute(const AlgorithmContext& ctx) const
+{
+  const auto& clusters
+      = ctx.eventStore.get<PlanarClusterContainer>(m_cfg.inputClusters);
+  // space points store the cluster index as 32bit unsigned integer
+  if (std::numeric_limits<uint32_t>::max() < clusters.size()) {
+    ACTS_ERROR("Too many clusters " << clusters.size()
+                                    << " for 32bit measurement indices");
+    return ProcessCode::ABORT;
+  }
+
+  std::vector<SpacePoint> spacePoints;
+  spacePoints.reserve(clusters.size());
+  // positions are transformed per module; buffers are reused
+  std::vector<Acts::Vector2D> localPositions;
+  std::vector<Acts::Vector3D> globalPositions;
+
+  for (auto&& [moduleGeoId, moduleClusters] :
+       groupByModule(clusters.clusters())) {
+    if (not m_selection.empty() and not m_selection.find(moduleGeoId)) {
+      continue;
+    }
+
+    // all clusters on a module share the same surface and transform
+    const Acts::Surface* surface = moduleClusters.begin()->surface;
+    if (not surface) {
+      ACTS_ERROR("Missing surface for clusters on module " << moduleGeoId);
+      return ProcessCode::ABORT;
+    }
+    const auto& transform = surface->transform(ctx.geoContext);
+    const auto  rotation  = transform.linear().leftCols<2>();
+
+    localPositions.clear();
+    for (const auto& cluster : moduleClusters) {
+      localPositions.emplace_back(cluster.local0, cluster.local1);
+    }
+    transformToGlobal(transform, localPositions, globalPositions);
+
+    // use iterators manually so we can retrieve the cluster index
+    std::size_t iglobal = 0;
+    for (auto it = moduleClusters.begin(); it != moduleClusters.end(); ++it) {
+      const Acts::Vector3D& pos = globalPositions[iglobal++];
+      // rotate the local position covariance into the global frame
+      const Acts::ActsSymMatrixD<3> cov
+          = rotation * it->cov.topLeftCorner<2, 2>() * rotation.transpose();
+      // project onto the transverse radius and the z axis
+      const double r2 = pos.x() * pos.x() + pos.y() * pos.y();
+      const double varR
+          = (pos.x() * pos.x() * cov(0, 0) + 2 * pos.x() * pos.y() * cov(0, 1)
+             + pos.y() * pos.y() * cov(1, 1))
+          / r2;
+
+      SpacePoint sp;
+      sp.x                = pos.x();
+      sp.y                = pos.y();
+      sp.z                = pos.z();
+      sp.varianceR        = varR;
+      sp.varianceZ        = cov(2, 2);
+      sp.measurementIndex = clusters.index_of(it);
+      spacePoints.push_back(sp);
+    }
+  }
+
+  ACTS_DEBUG("Created " << spacePoints.size() << " space points from "
+                        << clusters.size() << " clusters");
+  ctx.eventStore.add(m_cfg.outputSpacePoints,
+                     SpacePointContainer(m_cfg.binning, spacePoints));
+  return ProcessCode::SUCCESS;
+}
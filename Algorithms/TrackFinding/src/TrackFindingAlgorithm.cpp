@@ -0,0 +1,175 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/TrackFinding/TrackFindingAlgorithm.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+
+namespace {
+/// Ranking information for a single track candidate.
+struct Candidate
+{
+  std::size_t trackTip;
+  std::size_t nMeasurements = 0u;
+  double      chi2          = 0.0;
+};
+
+template <typename trajectory_t>
+Candidate
+makeCandidate(const trajectory_t& trajectory, std::size_t trackTip)
+{
+  Candidate candidate{trackTip};
+  trajectory.visitBackwards(trackTip, [&](const auto& state) {
+    if (state.typeFlags().test(Acts::TrackStateFlag::MeasurementFlag)) {
+      candidate.nMeasurements += 1u;
+      candidate.chi2 += state.chi2();
+    }
+  });
+  return candidate;
+}
+}  // namespace
+
+FW::TrackFindingAlgorithm::TrackFindingAlgorithm(Config               cfg,
+                                                 Acts::Logging::Level lvl)
+  : BareAlgorithm("TrackFindingAlgorithm", lvl)
+  , m_cfg(std::move(cfg))
+  , m_perigeeSurface(Acts::Surface::makeShared<Acts::PerigeeSurface>(
+        Acts::Vector3D{0., 0., 0.}))
+{
+  if (m_cfg.inputSourceLinks.empty()) {
+    throw std::invalid_argument("Missing input source links collection");
+  }
+  if (m_cfg.inputInitialTrackParameters.empty()) {
+    throw std::invalid_argument(
+        "Missing input initial track parameters collection");
+  }
+  if (m_cfg.outputTrajectories.empty()) {
+    throw std::invalid_argument("Missing output trajectories collection");
+  }
+  if (not m_cfg.findTracks) {
+    throw std::invalid_argument("Missing track finder function");
+  }
+  if (not(0 < m_cfg.chi2Max)) {
+    throw std::invalid_argument("Non-positive chi2 limit");
+  }
+  if (m_cfg.maxBranchesPerSurface == 0u or m_cfg.maxTracksPerSeed == 0u) {
+    throw std::invalid_argument("Branching limits must be positive");
+  }
+  // the default geometry identifier applies the limits to all surfaces
+  m_sourceLinkSelectorCfg = Acts::CKFSourceLinkSelector::Config{
+      {Acts::GeometryID(), {m_cfg.chi2Max, m_cfg.maxBranchesPerSurface}}};
+}
+
+FW::ProcessCode
+FW::TrackFindingAlgorithm::execute(const AlgorithmContext& ctx) const
+{
+  // Read input data
+  const auto& sourceLinks
+      = ctx.eventStore.get<SimSourceLinkContainer>(m_cfg.inputSourceLinks);
+  const auto& initialParameters = ctx.eventStore.get<TrackParametersContainer>(
+      m_cfg.inputInitialTrackParameters);
+
+  // The input is ordered by geometry identifier. The sequence is created once
+  // per event and shared by all seeds.
+  std::vector<SimSourceLink> trackSourceLinks(sourceLinks.begin(),
+                                              sourceLinks.end());
+
+  // The options are identical for all seeds
+  Acts::CombinatorialKalmanFilterOptions<Acts::CKFSourceLinkSelector>
+      ckfOptions(ctx.geoContext,
+                 ctx.magFieldContext,
+                 ctx.calibContext,
+                 m_sourceLinkSelectorCfg,
+                 m_perigeeSurface.get());
+
+  TrajectoryContainer trajectories;
+  trajectories.reserve(initialParameters.size());
+  // candidate buffer is reused for all seeds
+  std::vector<Candidate> candidates;
+  std::size_t            nFailed     = 0u;
+  std::size_t            nCandidates = 0u;
+
+  for (std::size_t iseed = 0; iseed < initialParameters.size(); ++iseed) {
+    const auto& initialParams = initialParameters[iseed];
+
+    auto result
+        = m_cfg.findTracks(trackSourceLinks, initialParams, ckfOptions);
+    if (not result.ok()) {
+      ACTS_DEBUG("Track finding failed for seed " << iseed << " with error "
+                                                  << result.error());
+      nFailed += 1u;
+      continue;
+    }
+    auto& finderOutput = result.value();
+    nCandidates += finderOutput.trackTips.size();
+
+    // rank the candidates if only some of them are kept
+    candidates.clear();
+    for (auto trackTip : finderOutput.trackTips) {
+      candidates.push_back(makeCandidate(finderOutput.fittedStates, trackTip));
+    }
+    const auto nKept = std::min(candidates.size(), m_cfg.maxTracksPerSeed);
+    if (nKept < candidates.size()) {
+      std::partial_sort(candidates.begin(),
+                        std::next(candidates.begin(), nKept),
+                        candidates.end(),
+                        [](const Candidate& lhs, const Candidate& rhs) {
+                          if (lhs.nMeasurements != rhs.nMeasurements) {
+                            return lhs.nMeasurements > rhs.nMeasurements;
+                          }
+                          return lhs.chi2 < rhs.chi2;
+                        });
+    }
+    ACTS_VERBOSE("Found " << candidates.size() << " candidates for seed "
+                          << iseed << ", keeping " << nKept);
+
+    // All candidates of a seed share the same multi trajectory; it is moved
+    // out of the finder result once and each output track stores its tip.
+    if (nKept == 0u) { continue; }
+    auto states = std::make_shared<const Trajectory>(
+        std::move(finderOutput.fittedStates));
+    for (std::size_t icand = 0; icand < nKept; ++icand) {
+      const auto trackTip = candidates[icand].trackTip;
+      auto       params   = finderOutput.fittedParameters.find(trackTip);
+      if (params != finderOutput.fittedParameters.end()) {
+        trajectories.emplace_back(trackTip, states, params->second);
+      } else {
+        trajectories.emplace_back(trackTip, states);
+      }
+    }
+  }
+
+  ACTS_DEBUG("Found " << trajectories.size() << " tracks from "
+                      << nCandidates << " candidates for "
+                      << initialParameters.size() << " seeds and "
+                      << sourceLinks.size() << " measurements");
+  if (0u < nFailed) {
+    ACTS_DEBUG("Track finding failed for " << nFailed << " seeds");
+  }
+  if (not m_cfg.outputStatistics.empty()) {
+    TrackFindingStatistics statistics;
+    statistics.seeds        = initialParameters.size();
+    statistics.failedSeeds  = nFailed;
+    statistics.candidates   = nCandidates;
+    statistics.tracks       = trajectories.size();
+    statistics.measurements = sourceLinks.size();
+    ctx.eventStore.add(m_cfg.outputStatistics, std::move(statistics));
+  }
+  ctx.eventStore.add(m_cfg.outputTrajectories, std::move(trajectories));
+  return ProcessCode::SUCCESS;
+}
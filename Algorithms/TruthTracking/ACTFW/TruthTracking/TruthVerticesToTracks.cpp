@@ -15,6 +15,7 @@
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/EventData/SimVertex.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Utilities/HelixExtrapolation.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
 #include "Acts/Propagator/Propagator.hpp"
@@ -32,6 +33,9 @@ FW::TruthVerticesToTracksAlgorithm::TruthVerticesToTracksAlgorithm(
     throw std::invalid_argument("Missing output collection");
   } else if (m_cfg.randomNumberSvc == nullptr) {
     throw std::invalid_argument("Missing random number service");
+  } else if (m_cfg.useAnalyticHelix
+             and ((m_cfg.bField.x() != 0) or (m_cfg.bField.y() != 0))) {
+    throw std::invalid_argument("Analytic helix requires a field along z");
   }
 }
 
@@ -66,6 +70,8 @@ FW::TruthVerticesToTracksAlgorithm::execute(
 
   // Vector to store VertexAndTracks extracted from event
   std::vector<VertexAndTracks> vertexAndTracksCollection;
+  // Particles without a perigee for the analytic helix
+  std::size_t nSkipped = 0;
 
   // Start looping over all vertices in current event
   for (auto& vtx : vertexCollection) {
@@ -89,12 +95,28 @@ FW::TruthVerticesToTracksAlgorithm::execute(
                                         ptclMom,
                                         particle.charge(),
                                         particle.time());
-      // Run propagator
-      auto result = propagator.propagate(start, *perigeeSurface, pOptions);
-      if (!result.ok()) { continue; }
+      Acts::BoundVector perigeeParameters;
+      if (m_cfg.useAnalyticHelix) {
+        // the helix is undefined for particles along the beam line
+        if (Acts::VectorHelpers::perp(ptclMom) == 0) {
+          nSkipped += 1;
+          continue;
+        }
+        perigeeParameters = extrapolateHelixToPerigee(particle.position(),
+                                                      ptclMom,
+                                                      particle.charge(),
+                                                      particle.time(),
+                                                      particle.mass(),
+                                                      m_cfg.bField.z(),
+                                                      m_cfg.refPosition);
+      } else {
+        // Run propagator
+        auto result = propagator.propagate(start, *perigeeSurface, pOptions);
+        if (!result.ok()) { continue; }
 
-      // get perigee parameters
-      const auto& perigeeParameters = (*result).endParameters->parameters();
+        // get perigee parameters
+        perigeeParameters = (*result).endParameters->parameters();
+      }
 
       auto newTrackParams = perigeeParameters;
 
@@ -150,6 +172,11 @@ FW::TruthVerticesToTracksAlgorithm::execute(
 
   }  // end iteration over all vertices
 
+  if (0 < nSkipped) {
+    ACTS_DEBUG("Skipped " << nSkipped
+                          << " particles without transverse momentum");
+  }
+
   // VertexAndTracks objects to the EventStore
   context.eventStore.add(m_cfg.output, std::move(vertexAndTracksCollection));
 
@@ -182,3 +209,9 @@ FW::TruthVerticesToTracksAlgorithm::correctPhiThetaPeriodicity(
   phiIn   = tmpPhi;
   thetaIn = tmpTht;
 }
+
+std::vector<std::string>
+FW::TruthVerticesToTracksAlgorithm::inputCollections() const
+{
+  return {m_cfg.input};
+}
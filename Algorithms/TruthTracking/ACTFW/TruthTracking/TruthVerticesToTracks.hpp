@@ -51,6 +51,11 @@ public:
     /// parameters will be defined
     Acts::Vector3D refPosition = Acts::Vector3D::Zero();
 
+    /// Use the analytic helix extrapolation instead of the propagator;
+    /// requires a magnetic field along the z axis. Particles without
+    /// transverse momentum have no perigee and are skipped.
+    bool useAnalyticHelix = false;
+
     /// Do track smearing
     bool doSmearing = true;
 
@@ -81,6 +86,10 @@ public:
   ProcessCode
   execute(const AlgorithmContext& context) const final override;
 
+  /// The input truth vertices
+  std::vector<std::string>
+  inputCollections() const final override;
+
 private:
   /// Config struct
   Config m_cfg;
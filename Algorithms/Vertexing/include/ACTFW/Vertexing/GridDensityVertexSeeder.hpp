@@ -0,0 +1,100 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Vertexing/Vertex.hpp"
+#include "Acts/Vertexing/VertexFinderOptions.hpp"
+
+namespace FWE {
+
+/// Find a vertex seed from the track density along the beamline.
+///
+/// The longitudinal impact parameters of all tracks are filled into a fine
+/// histogram along z and smoothed with a Gaussian kernel. Each track is
+/// weighted by the compatibility of its transverse impact parameter with the
+/// beamline. The seed is placed at the maximum of the smoothed density,
+/// refined by a parabola through the neighbouring bins, and at the transverse
+/// position of the vertex constraint.
+///
+/// Contrary to the z-scan seed finder no track is propagated. The density is
+/// only built from scratch for the first call within an event; subsequent
+/// calls from the iterative vertex finder with a reduced set of tracks only
+/// remove or add the changed tracks. The cached density makes the seeder
+/// unsuitable for concurrent use; each thread must use its own instance.
+///
+/// Fulfills the Acts vertex finder concept and can be used as the seed finder
+/// of the iterative vertex finder.
+class GridDensityVertexSeeder
+{
+public:
+  using InputTrack_t = Acts::BoundParameters;
+
+  struct Config
+  {
+    /// Longitudinal range of the density grid; tracks outside are ignored.
+    double zMin = -250 * Acts::UnitConstants::mm;
+    double zMax = 250 * Acts::UnitConstants::mm;
+    /// Grid bin size.
+    double binSize = 0.05 * Acts::UnitConstants::mm;
+    /// Standard deviation of the Gaussian smoothing kernel.
+    double kernelWidth = 0.5 * Acts::UnitConstants::mm;
+    /// Kernel cut-off in units of its standard deviation.
+    double kernelRange = 3.0;
+    /// Maximum transverse impact parameter significance; tracks without a
+    /// covariance are always used with unit weight.
+    double maxD0Significance = 5.0;
+    /// Fraction of changed tracks above which the density is rebuilt instead
+    /// of being updated incrementally.
+    double rebuildFraction = 0.5;
+  };
+
+  /// Constructor
+  ///
+  /// @param cfg Seeder configuration
+  GridDensityVertexSeeder(const Config& cfg);
+
+  /// Find a single vertex seed.
+  ///
+  /// @param trackVector Input tracks, expressed at a perigee surface
+  /// @param vFinderOptions Vertex finder options
+  /// @return Collection with a single seed vertex
+  Acts::Result<std::vector<Acts::Vertex<InputTrack_t>>>
+  find(const std::vector<const InputTrack_t*>&        trackVector,
+       const Acts::VertexFinderOptions<InputTrack_t>& vFinderOptions) const;
+
+private:
+  /// Contribution of a single track to the density.
+  struct Contribution
+  {
+    const InputTrack_t* track;
+    std::size_t         bin;
+    double              weight;
+  };
+
+  /// Add the smoothing kernel centered at the given bin to the density.
+  void
+  addKernel(std::size_t bin, double weight) const;
+
+  Config              m_cfg;
+  std::size_t         m_numBins;
+  std::size_t         m_kernelHalfWidth;
+  std::vector<double> m_kernel;
+  // cached state from the previous call
+  mutable std::vector<double>       m_density;
+  mutable std::vector<Contribution> m_contributions;
+  mutable std::vector<Contribution> m_buffer;
+};
+
+}  // namespace FWE
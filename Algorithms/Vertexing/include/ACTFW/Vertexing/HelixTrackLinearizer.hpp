@@ -0,0 +1,234 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "ACTFW/Utilities/HelixExtrapolation.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+#include "Acts/Utilities/Result.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Vertexing/LinearizedTrack.hpp"
+#include "Acts/Vertexing/VertexingError.hpp"
+
+namespace FWE {
+
+/// Linearize tracks with the closed-form helix in a homogeneous field.
+///
+/// Drop-in replacement for the Acts helical track linearizer for a magnetic
+/// field along the z axis. The track parameters are extrapolated to the
+/// perigee at the linearization point with the analytic helix instead of the
+/// propagator. The covariance is transported with the Jacobian of the same
+/// extrapolation, computed from central differences of the closed-form
+/// parameters. The linearization itself, i.e. the position and momentum
+/// Jacobians and the constant term, follows the helical track linearizer.
+///
+/// The input parameters must be given on an unrotated perigee surface and
+/// must have a covariance. The propagator type is only exposed since the Acts
+/// vertex fitters and finders require it; no propagation is performed.
+template <typename propagator_t>
+class HelixTrackLinearizer
+{
+public:
+  using Propagator_t = propagator_t;
+
+  struct Config
+  {
+    /// Homogeneous magnetic field along the z axis
+    double bFieldInZ = 2 * Acts::UnitConstants::T;
+    /// Particle mass; only used for the time extrapolation
+    double mass = 139.57018 * Acts::UnitConstants::MeV;
+    /// Relative step size for the covariance transport Jacobian
+    double jacobianStep = 1e-6;
+  };
+
+  /// Constructor
+  ///
+  /// @param cfg Linearizer configuration
+  HelixTrackLinearizer(const Config& cfg) : m_cfg(cfg) {}
+
+  /// Linearize a track at the given point.
+  ///
+  /// @param params Track parameters on a perigee surface
+  /// @param linPoint Linearization point
+  /// @return Linearized track
+  Acts::Result<Acts::LinearizedTrack>
+  linearizeTrack(const Acts::BoundParameters*  params,
+                 const Acts::SpacePointVector& linPoint) const;
+
+private:
+  /// Global position offset of the perigee parameters from the reference.
+  static Acts::Vector3D
+  perigeeOffset(const Acts::BoundVector& params)
+  {
+    const double d0 = params[Acts::eLOC_0];
+    return Acts::Vector3D(-d0 * std::sin(params[Acts::ePHI]),
+                          d0 * std::cos(params[Acts::ePHI]),
+                          params[Acts::eLOC_1]);
+  }
+
+  Config m_cfg;
+};
+
+template <typename propagator_t>
+Acts::Result<Acts::LinearizedTrack>
+HelixTrackLinearizer<propagator_t>::linearizeTrack(
+    const Acts::BoundParameters*  params,
+    const Acts::SpacePointVector& linPoint) const
+{
+  using Jacobian = Acts::ActsMatrixD<Acts::BoundParsDim, Acts::BoundParsDim>;
+
+  const Acts::BoundVector& input = params->parameters();
+  if (not params->covariance()
+      or (std::sin(input[Acts::eTHETA]) == 0)
+      or (input[Acts::eQOP] == 0)) {
+    return Acts::VertexingError::NumericFailure;
+  }
+  const Acts::Vector3D linPointPos = linPoint.template head<3>();
+  // the input perigee reference follows from the global position
+  const Acts::Vector3D inputReference
+      = params->position() - perigeeOffset(input);
+
+  // closed-form perigee parameters at the linearization point
+  auto extrapolate = [&](const Acts::BoundVector& bound) {
+    const double phi    = bound[Acts::ePHI];
+    const double theta  = bound[Acts::eTHETA];
+    const double p      = std::abs(1 / bound[Acts::eQOP]);
+    const double charge = (bound[Acts::eQOP] < 0) ? -1.0 : 1.0;
+
+    const Acts::Vector3D position = inputReference + perigeeOffset(bound);
+    const Acts::Vector3D momentum(p * std::cos(phi) * std::sin(theta),
+                                  p * std::sin(phi) * std::sin(theta),
+                                  p * std::cos(theta));
+    return FW::extrapolateHelixToPerigee(position,
+                                         momentum,
+                                         charge,
+                                         bound[Acts::eT],
+                                         m_cfg.mass,
+                                         m_cfg.bFieldInZ,
+                                         linPointPos);
+  };
+  const Acts::BoundVector paramsAtPCA = extrapolate(input);
+
+  // transport Jacobian; the time only shifts and is exact
+  Jacobian jacobian = Jacobian::Identity();
+  for (unsigned ipar = Acts::eLOC_0; ipar < Acts::eT; ++ipar) {
+    const double step
+        = m_cfg.jacobianStep * std::max(1.0, std::abs(input[ipar]));
+    Acts::BoundVector up   = input;
+    Acts::BoundVector down = input;
+    up[ipar] += step;
+    down[ipar] -= step;
+    Acts::BoundVector diff = extrapolate(up) - extrapolate(down);
+    diff[Acts::ePHI]       = std::remainder(diff[Acts::ePHI], 2 * M_PI);
+    jacobian.col(ipar)     = diff / (2 * step);
+  }
+  const Acts::BoundSymMatrix covarianceAtPCA
+      = jacobian * (*params->covariance()) * jacobian.transpose();
+
+  Acts::SpacePointVector positionAtPCA = Acts::SpacePointVector::Zero();
+  positionAtPCA.template head<3>() = linPointPos + perigeeOffset(paramsAtPCA);
+  positionAtPCA[Acts::eTime]       = paramsAtPCA[Acts::eT];
+
+  // the linearization follows the helical track linearizer
+  const double   phiV    = paramsAtPCA[Acts::ePHI];
+  const double   sinPhiV = std::sin(phiV);
+  const double   cosPhiV = std::cos(phiV);
+  const double   th      = paramsAtPCA[Acts::eTHETA];
+  const double   tanTh   = std::tan(th);
+  const double   qOvP    = paramsAtPCA[Acts::eQOP];
+  const double   sgnH    = (qOvP < 0) ? -1.0 : 1.0;
+  Acts::Vector3D momentumAtPCA(phiV, th, qOvP);
+
+  // the curvature is infinite without a magnetic field
+  const double rho = (m_cfg.bFieldInZ == 0)
+      ? (sgnH * 1e15)
+      : (std::sin(th) * (1 / qOvP) / m_cfg.bFieldInZ);
+
+  const double X  = positionAtPCA[0] - linPointPos.x() + rho * sinPhiV;
+  const double Y  = positionAtPCA[1] - linPointPos.y() - rho * cosPhiV;
+  const double S2 = X * X + Y * Y;
+  const double S  = std::sqrt(S2);
+
+  // predicted parameters at the perigee as a function of vertex and momentum
+  const double sgnX = (X < 0) ? -1.0 : 1.0;
+  const double sgnY = (Y < 0) ? -1.0 : 1.0;
+  double       phiAtPCA;
+  if (std::abs(X) > std::abs(Y)) {
+    phiAtPCA = sgnH * sgnX * std::acos(-sgnH * Y / S);
+  } else {
+    phiAtPCA = std::asin(sgnH * X / S);
+    if ((sgnH * sgnY) > 0) { phiAtPCA = sgnH * sgnX * M_PI - phiAtPCA; }
+  }
+  Acts::BoundVector predParamsAtPCA;
+  predParamsAtPCA[Acts::eLOC_0] = rho - sgnH * S;
+  predParamsAtPCA[Acts::eLOC_1] = positionAtPCA[Acts::ePos2] - linPointPos.z()
+      + rho * (phiV - phiAtPCA) / tanTh;
+  predParamsAtPCA[Acts::ePHI]   = phiAtPCA;
+  predParamsAtPCA[Acts::eTHETA] = th;
+  predParamsAtPCA[Acts::eQOP]   = qOvP;
+  predParamsAtPCA[Acts::eT]     = 0;
+
+  // position Jacobian
+  const double S2tanTh = S2 * tanTh;
+  Acts::SpacePointToBoundMatrix positionJacobian
+      = Acts::SpacePointToBoundMatrix::Zero();
+  positionJacobian(0, 0) = -sgnH * X / S;
+  positionJacobian(0, 1) = -sgnH * Y / S;
+  positionJacobian(1, 0) = rho * Y / S2tanTh;
+  positionJacobian(1, 1) = -rho * X / S2tanTh;
+  positionJacobian(1, 2) = 1;
+  positionJacobian(2, 0) = -Y / S2;
+  positionJacobian(2, 1) = X / S2;
+  positionJacobian(5, 3) = 1;
+
+  // momentum Jacobian
+  const double R         = X * cosPhiV + Y * sinPhiV;
+  const double Q         = X * sinPhiV - Y * cosPhiV;
+  const double dPhi      = phiAtPCA - phiV;
+  const double qOvSred   = 1 - sgnH * Q / S;
+  const double rhoOverS2 = rho / S2;
+  Acts::ActsMatrixD<Acts::BoundParsDim, 3> momentumJacobian
+      = Acts::ActsMatrixD<Acts::BoundParsDim, 3>::Zero();
+  momentumJacobian(0, 0) = -sgnH * rho * R / S;
+  momentumJacobian(0, 1) = qOvSred * rho / tanTh;
+  momentumJacobian(0, 2) = -qOvSred * rho / qOvP;
+  momentumJacobian(1, 0) = (1 - rhoOverS2 * Q) * rho / tanTh;
+  momentumJacobian(1, 1) = (dPhi + rho * R / (S2tanTh * tanTh)) * rho;
+  momentumJacobian(1, 2) = (dPhi - rhoOverS2 * R) * rho / (qOvP * tanTh);
+  momentumJacobian(2, 0) = rhoOverS2 * Q;
+  momentumJacobian(2, 1) = -rho * R / S2tanTh;
+  momentumJacobian(2, 2) = rhoOverS2 * R / qOvP;
+  momentumJacobian(3, 1) = 1;
+  momentumJacobian(4, 2) = 1;
+
+  // constant term of the Taylor expansion
+  const Acts::BoundVector constTerm = predParamsAtPCA
+      - positionJacobian * positionAtPCA - momentumJacobian * momentumAtPCA;
+
+  // the weight only covers the spatial parameters
+  Acts::BoundSymMatrix weightAtPCA = Acts::BoundSymMatrix::Identity();
+  weightAtPCA.template block<5, 5>(0, 0)
+      = covarianceAtPCA.template block<5, 5>(0, 0).inverse();
+
+  return Acts::LinearizedTrack(paramsAtPCA,
+                               covarianceAtPCA,
+                               weightAtPCA,
+                               linPoint,
+                               positionJacobian,
+                               momentumJacobian,
+                               positionAtPCA,
+                               momentumAtPCA,
+                               constTerm);
+}
+
+}  // namespace FWE
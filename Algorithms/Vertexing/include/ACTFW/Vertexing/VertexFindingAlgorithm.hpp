@@ -10,10 +10,13 @@
 
 #include <memory>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include "ACTFW/EventData/SimVertex.hpp"
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "ACTFW/Framework/ProcessCode.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Vertexing/GridDensityVertexSeeder.hpp"
 
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
@@ -23,6 +26,16 @@
 
 namespace FWE {
 
+/// Find and fit all vertices from the tracks of an event.
+///
+/// The tracks of all input vertices are combined and given to the iterative
+/// vertex finder by reference, i.e. without copies. The found vertices are
+/// written to the event store and reference the input track parameters.
+///
+/// The vertex seeds are found either with the z-scan seed finder or with the
+/// grid density seeder that avoids the track propagation for each seed. The
+/// tracks are linearized either with the Acts helical track linearizer, i.e.
+/// with the propagator, or with the closed-form helix linearizer.
 class VertexFindingAlgorithm : public FW::BareAlgorithm
 {
 public:
@@ -30,14 +43,28 @@ public:
   {
     /// Input track collection
     std::string trackCollection;
+    /// Output found vertices collection
+    std::string outputVertices;
 
     /// The magnetic field
     Acts::Vector3D bField;
+    /// Linearize the tracks with the closed-form helix instead of the
+    /// propagator; requires a magnetic field along the z axis.
+    bool useHelixLinearizer = false;
+
+    /// Use the grid density seeder instead of the z-scan seed finder
+    bool useGridDensitySeeder = false;
+    /// Grid density seeder configuration
+    GridDensityVertexSeeder::Config gridDensitySeeder;
+    /// Rebuild the tool chain for every event instead of reusing it; only
+    /// intended to measure the setup overhead.
+    bool rebuildTools = false;
   };
 
   /// Constructor
   VertexFindingAlgorithm(const Config&        cfg,
                          Acts::Logging::Level level = Acts::Logging::INFO);
+  ~VertexFindingAlgorithm();
 
   /// Framework execute method
   /// @param [in] context is the Algorithm context for event consistency
@@ -45,8 +72,12 @@ public:
   execute(const FW::AlgorithmContext& context) const final override;
 
 private:
+  struct Tools;
+
   /// The config class
   Config m_cfg;
+  /// Per-thread vertex finder tools; constructed on first use
+  mutable tbb::enumerable_thread_specific<std::unique_ptr<Tools>> m_tools;
 };
 
 }  // namespace FWE
\ No newline at end of file
@@ -8,8 +8,11 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
+#include <tbb/enumerable_thread_specific.h>
+
 #include "ACTFW/EventData/SimVertex.hpp"
 #include "ACTFW/Framework/BareAlgorithm.hpp"
 #include "Acts/Utilities/Units.hpp"
@@ -18,6 +21,15 @@ using namespace Acts::UnitLiterals;
 
 namespace FWE {
 
+/// Fit one vertex for each group of tracks from a common vertex.
+///
+/// The vertex candidates are independent of each other and can be fitted in
+/// parallel within an event. Each thread uses its own fitter and linearizer.
+/// The tracks are linearized either with the Acts helical track linearizer,
+/// i.e. with the propagator, or with the closed-form helix linearizer.
+/// The fitted vertices are written in the input order; candidates with a
+/// failed fit or, for the unconstrained fit, less than two tracks are not
+/// written.
 class VertexFitAlgorithm : public FW::BareAlgorithm
 {
 public:
@@ -25,9 +37,20 @@ public:
   {
     /// Input track collection
     std::string trackCollection;
+    /// Output fitted vertices collection
+    std::string outputVertices;
+    /// Minimum number of vertices per parallel task within an event; zero
+    /// disables the intra-event parallelism and fits all vertices serially.
+    std::size_t minVerticesPerTask = 0u;
+    /// Rebuild the tool chain for every event and parallel task instead of
+    /// reusing it; only intended to measure the setup overhead.
+    bool rebuildTools = false;
 
     /// The magnetic field
     Acts::Vector3D bField;
+    /// Linearize the tracks with the closed-form helix instead of the
+    /// propagator; requires a magnetic field along the z axis.
+    bool useHelixLinearizer = false;
 
     bool doConstrainedFit = false;
 
@@ -41,6 +64,7 @@ public:
   /// Constructor
   VertexFitAlgorithm(const Config&        cfg,
                      Acts::Logging::Level level = Acts::Logging::INFO);
+  ~VertexFitAlgorithm();
 
   /// Framework execute method
   /// @param [in] context is the Algorithm context for event consistency
@@ -48,8 +72,12 @@ public:
   execute(const FW::AlgorithmContext& context) const final override;
 
 private:
+  struct Tools;
+
   /// The config class
   Config m_cfg;
+  /// Per-thread vertex fitter tools; constructed on first use
+  mutable tbb::enumerable_thread_specific<std::unique_ptr<Tools>> m_tools;
 };
 
 }  // namespace FWE
@@ -0,0 +1,169 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Vertexing/GridDensityVertexSeeder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+
+namespace {
+/// Strict ordering of track contributions by all members.
+///
+/// Identical contributions in the cached and the new state cancel and do not
+/// need to be updated. This is also correct if a track pointer is reused by
+/// a different track in a later event.
+template <typename contribution_t>
+bool
+isBefore(const contribution_t& lhs, const contribution_t& rhs)
+{
+  return std::make_tuple(lhs.track, lhs.bin, lhs.weight)
+      < std::make_tuple(rhs.track, rhs.bin, rhs.weight);
+}
+
+/// Visit contributions that are only in one of two sorted ranges.
+template <typename contribution_t, typename removed_t, typename added_t>
+void
+visitDifference(const std::vector<contribution_t>& before,
+                const std::vector<contribution_t>& after,
+                removed_t                          onRemoved,
+                added_t                            onAdded)
+{
+  auto b = before.begin();
+  auto a = after.begin();
+  while ((b != before.end()) and (a != after.end())) {
+    if (isBefore(*b, *a)) {
+      onRemoved(*(b++));
+    } else if (isBefore(*a, *b)) {
+      onAdded(*(a++));
+    } else {
+      ++b;
+      ++a;
+    }
+  }
+  std::for_each(b, before.end(), onRemoved);
+  std::for_each(a, after.end(), onAdded);
+}
+}  // namespace
+
+FWE::GridDensityVertexSeeder::GridDensityVertexSeeder(const Config& cfg)
+  : m_cfg(cfg)
+{
+  if (not(m_cfg.zMin < m_cfg.zMax)) {
+    throw std::invalid_argument("Invalid density grid range");
+  }
+  if (not(0 < m_cfg.binSize)) {
+    throw std::invalid_argument("Non-positive density grid bin size");
+  }
+  if (not(0 < m_cfg.kernelWidth) or not(0 < m_cfg.kernelRange)) {
+    throw std::invalid_argument("Invalid density smoothing kernel");
+  }
+  m_numBins = std::ceil((m_cfg.zMax - m_cfg.zMin) / m_cfg.binSize);
+  m_kernelHalfWidth
+      = std::ceil(m_cfg.kernelRange * m_cfg.kernelWidth / m_cfg.binSize);
+  // the kernel is evaluated once for all offsets within its range
+  m_kernel.resize(2 * m_kernelHalfWidth + 1);
+  for (std::size_t k = 0; k < m_kernel.size(); ++k) {
+    const double dz = (double(k) - double(m_kernelHalfWidth)) * m_cfg.binSize;
+    m_kernel[k]     = std::exp(-0.5 * dz * dz
+                           / (m_cfg.kernelWidth * m_cfg.kernelWidth));
+  }
+}
+
+void
+FWE::GridDensityVertexSeeder::addKernel(std::size_t bin, double weight) const
+{
+  // clip the kernel at the grid boundaries
+  const auto kBegin = (bin < m_kernelHalfWidth) ? (m_kernelHalfWidth - bin)
+                                                : std::size_t(0u);
+  const auto kEnd
+      = std::min(m_kernel.size(), m_numBins + m_kernelHalfWidth - bin);
+  for (auto k = kBegin; k < kEnd; ++k) {
+    m_density[bin + k - m_kernelHalfWidth] += weight * m_kernel[k];
+  }
+}
+
+Acts::Result<std::vector<Acts::Vertex<Acts::BoundParameters>>>
+FWE::GridDensityVertexSeeder::find(
+    const std::vector<const InputTrack_t*>&        trackVector,
+    const Acts::VertexFinderOptions<InputTrack_t>& vFinderOptions) const
+{
+  // compute the contributions of the current tracks
+  m_buffer.clear();
+  for (const auto* track : trackVector) {
+    const auto& params = track->parameters();
+    const double z0    = params[Acts::eLOC_1]
+        + track->referenceSurface().center(vFinderOptions.geoContext).z();
+    if (not(m_cfg.zMin <= z0 and z0 < m_cfg.zMax)) { continue; }
+    double weight = 1.0;
+    if (track->covariance()) {
+      const double sigmaD0
+          = std::sqrt((*track->covariance())(Acts::eLOC_0, Acts::eLOC_0));
+      const double significance = params[Acts::eLOC_0] / sigmaD0;
+      if (m_cfg.maxD0Significance < std::abs(significance)) { continue; }
+      weight = std::exp(-0.5 * significance * significance);
+    }
+    const std::size_t bin = (z0 - m_cfg.zMin) / m_cfg.binSize;
+    m_buffer.push_back({track, std::min(bin, m_numBins - 1), weight});
+  }
+  std::sort(m_buffer.begin(), m_buffer.end(), isBefore<Contribution>);
+
+  // count the changed tracks to decide between rebuild and update
+  std::size_t numChanged = 0u;
+  auto countChanged = [&](const Contribution&) { ++numChanged; };
+  visitDifference(m_contributions, m_buffer, countChanged, countChanged);
+
+  if (m_density.empty()
+      or (m_cfg.rebuildFraction * m_buffer.size() < numChanged)) {
+    // fill the histogram and smooth it; bins with multiple tracks are only
+    // smoothed once. Only the smoothed density is kept for later updates.
+    std::vector<double> histogram(m_numBins, 0.0);
+    m_density.assign(m_numBins, 0.0);
+    for (const auto& contribution : m_buffer) {
+      histogram[contribution.bin] += contribution.weight;
+    }
+    for (std::size_t bin = 0; bin < m_numBins; ++bin) {
+      if (histogram[bin] != 0) { addKernel(bin, histogram[bin]); }
+    }
+  } else {
+    visitDifference(
+        m_contributions,
+        m_buffer,
+        [&](const Contribution& c) { addKernel(c.bin, -c.weight); },
+        [&](const Contribution& c) { addKernel(c.bin, c.weight); });
+  }
+  std::swap(m_contributions, m_buffer);
+
+  // the seed is at the constraint position without any usable track
+  Acts::Vector3D position = vFinderOptions.vertexConstraint.position();
+  if (not m_contributions.empty()) {
+    // the first maximum is used for equal densities
+    const std::size_t max
+        = std::max_element(m_density.begin(), m_density.end())
+        - m_density.begin();
+    // interpolate the maximum with a parabola through the neighbouring bins
+    double offset = 0.0;
+    if ((0 < max) and (max + 1 < m_density.size())) {
+      const double prev      = m_density[max - 1];
+      const double curr      = m_density[max];
+      const double next      = m_density[max + 1];
+      const double curvature = prev - 2 * curr + next;
+      if (curvature < 0) { offset = 0.5 * (prev - next) / curvature; }
+    }
+    position.z() = m_cfg.zMin + (max + 0.5 + offset) * m_cfg.binSize;
+  }
+
+  std::vector<Acts::Vertex<InputTrack_t>> seeds;
+  seeds.emplace_back(position);
+  return seeds;
+}
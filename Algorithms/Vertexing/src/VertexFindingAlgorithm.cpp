@@ -9,8 +9,10 @@
 #include "ACTFW/Vertexing/VertexFindingAlgorithm.hpp"
 #include <Acts/Geometry/GeometryContext.hpp>
 #include <Acts/MagneticField/MagneticFieldContext.hpp>
+#include "ACTFW/EventData/RecVertex.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "ACTFW/TruthTracking/VertexAndTracks.hpp"
+#include "ACTFW/Vertexing/HelixTrackLinearizer.hpp"
 #include "Acts/EventData/TrackParameters.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
@@ -30,113 +32,257 @@
 #include "Acts/Vertexing/ZScanVertexFinder.hpp"
 
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+using MagneticField     = Acts::ConstantBField;
+using Stepper           = Acts::EigenStepper<MagneticField>;
+using Propagator        = Acts::Propagator<Stepper>;
+using PropagatorOptions = Acts::PropagatorOptions<>;
+using TrackParameters   = Acts::BoundParameters;
+using Linearizer        = Acts::HelicalTrackLinearizer<Propagator>;
+using VertexFitter = Acts::FullBilloirVertexFitter<TrackParameters, Linearizer>;
+using HelixLinearizer = FWE::HelixTrackLinearizer<Propagator>;
+using HelixVertexFitter
+    = Acts::FullBilloirVertexFitter<TrackParameters, HelixLinearizer>;
+using ZScanImpactPointEstimator
+    = Acts::TrackToVertexIPEstimator<TrackParameters, Propagator>;
+template <typename fitter_t>
+using ZScanSeederT = Acts::ZScanVertexFinder<fitter_t>;
+template <typename fitter_t>
+using ZScanFinderT
+    = Acts::IterativeVertexFinder<fitter_t, ZScanSeederT<fitter_t>>;
+using GridSeeder = FWE::GridDensityVertexSeeder;
+template <typename fitter_t>
+using GridFinderT = Acts::IterativeVertexFinder<fitter_t, GridSeeder>;
+using ZScanSeeder         = ZScanSeederT<VertexFitter>;
+using ZScanFinder         = ZScanFinderT<VertexFitter>;
+using GridFinder          = GridFinderT<VertexFitter>;
+using HelixZScanFinder    = ZScanFinderT<HelixVertexFitter>;
+using HelixGridFinder     = GridFinderT<HelixVertexFitter>;
+using VertexFinderOptions = Acts::VertexFinderOptions<TrackParameters>;
+
+static_assert(Acts::VertexFinderConcept<ZScanSeeder>,
+              "ZScanSeeder does not fulfill vertex finder concept.");
+static_assert(Acts::VertexFinderConcept<GridSeeder>,
+              "GridSeeder does not fulfill vertex finder concept.");
+static_assert(Acts::VertexFinderConcept<ZScanFinder>,
+              "ZScanFinder does not fulfill vertex finder concept.");
+static_assert(Acts::VertexFinderConcept<GridFinder>,
+              "GridFinder does not fulfill vertex finder concept.");
+static_assert(Acts::VertexFinderConcept<HelixZScanFinder>,
+              "HelixZScanFinder does not fulfill vertex finder concept.");
+static_assert(Acts::VertexFinderConcept<HelixGridFinder>,
+              "HelixGridFinder does not fulfill vertex finder concept.");
+
+/// Setup the iterative vertex finder configuration for the given seeder and
+/// track linearizer.
+template <typename finder_t,
+          typename fitter_t,
+          typename linearizer_t,
+          typename seeder_t>
+typename finder_t::Config
+makeFinderConfig(linearizer_t                linearizer,
+                 const MagneticField&        bField,
+                 std::shared_ptr<Propagator> propagator,
+                 const PropagatorOptions&    propagatorOpts,
+                 seeder_t                    seeder)
+{
+  // Setup the vertex fitter
+  typename fitter_t::Config vertexFitterCfg;
+  fitter_t                  vertexFitter(std::move(vertexFitterCfg));
+  // Setup the impact point estimator
+  typename finder_t::ImpactPointEstimator::Config finderIpEstCfg(
+      bField, propagator, propagatorOpts);
+  typename finder_t::ImpactPointEstimator finderIpEst(
+      std::move(finderIpEstCfg));
+  // Set up the actual vertex finder
+  typename finder_t::Config finderCfg(std::move(vertexFitter),
+                                      std::move(linearizer),
+                                      std::move(seeder),
+                                      std::move(finderIpEst));
+  finderCfg.maxVertices                 = 200;
+  finderCfg.reassignTracksAfterFirstFit = true;
+  return finderCfg;
+}
+
+/// Setup the vertex finder with the configured seeder for the given fitter.
+template <typename fitter_t, typename linearizer_t>
+void
+setupFinder(const FWE::VertexFindingAlgorithm::Config& cfg,
+            linearizer_t                               linearizer,
+            const MagneticField&                       bField,
+            std::shared_ptr<Propagator>                propagator,
+            const PropagatorOptions&                   propagatorOpts,
+            std::optional<ZScanFinderT<fitter_t>>&     zScanFinder,
+            std::optional<GridFinderT<fitter_t>>&      gridFinder)
+{
+  if (cfg.useGridDensitySeeder) {
+    GridSeeder seeder(cfg.gridDensitySeeder);
+    auto       finderCfg = makeFinderConfig<GridFinderT<fitter_t>, fitter_t>(
+        std::move(linearizer),
+        bField,
+        propagator,
+        propagatorOpts,
+        std::move(seeder));
+    gridFinder.emplace(finderCfg);
+  } else {
+    ZScanImpactPointEstimator::Config seederIpEstCfg(propagator,
+                                                     propagatorOpts);
+    ZScanImpactPointEstimator seederIpEst(std::move(seederIpEstCfg));
+    typename ZScanSeederT<fitter_t>::Config seederCfg(std::move(seederIpEst));
+    ZScanSeederT<fitter_t>                  seeder(std::move(seederCfg));
+    auto finderCfg = makeFinderConfig<ZScanFinderT<fitter_t>, fitter_t>(
+        std::move(linearizer),
+        bField,
+        propagator,
+        propagatorOpts,
+        std::move(seeder));
+    zScanFinder.emplace(finderCfg);
+  }
+}
+}  // namespace
+
+/// The complete vertex finder tool chain for one thread.
+///
+/// The propagator options stored within the tools reference the contexts
+/// owned by this object. They must be updated before each use and the object
+/// must not be moved.
+struct FWE::VertexFindingAlgorithm::Tools
+{
+  Acts::GeometryContext           geoContext;
+  Acts::MagneticFieldContext      magFieldContext;
+  // only the finder with the configured seeder and linearizer is constructed
+  std::optional<ZScanFinder>      zScanFinder;
+  std::optional<GridFinder>       gridFinder;
+  std::optional<HelixZScanFinder> helixZScanFinder;
+  std::optional<HelixGridFinder>  helixGridFinder;
+
+  Tools(const Config& cfg)
+  {
+    // Set up the magnetic field
+    MagneticField bField(cfg.bField);
+    // Set up propagator with void navigator
+    auto propagator = std::make_shared<Propagator>(Stepper(bField));
+    // the options reference the contexts owned by this object
+    PropagatorOptions propagatorOpts(geoContext, magFieldContext);
+    // Setup the linearizer, the seed finder, and the vertex finder
+    if (cfg.useHelixLinearizer) {
+      HelixLinearizer::Config linearizerCfg;
+      linearizerCfg.bFieldInZ = cfg.bField.z();
+      setupFinder<HelixVertexFitter>(cfg,
+                                     HelixLinearizer(linearizerCfg),
+                                     bField,
+                                     propagator,
+                                     propagatorOpts,
+                                     helixZScanFinder,
+                                     helixGridFinder);
+    } else {
+      Linearizer::Config linearizerCfg(bField, propagator, propagatorOpts);
+      setupFinder<VertexFitter>(cfg,
+                                Linearizer(linearizerCfg),
+                                bField,
+                                propagator,
+                                propagatorOpts,
+                                zScanFinder,
+                                gridFinder);
+    }
+  }
+  Tools(const Tools&) = delete;
+  Tools&
+  operator=(const Tools&)
+      = delete;
+};
 
 FWE::VertexFindingAlgorithm::VertexFindingAlgorithm(const Config&        cfg,
                                                     Acts::Logging::Level level)
-  : FW::BareAlgorithm("VertexFinding", level), m_cfg(cfg)
+  : FW::BareAlgorithm("VertexFinding", level)
+  , m_cfg(cfg)
+  , m_tools([this]() { return std::make_unique<Tools>(m_cfg); })
 {
+  if (m_cfg.trackCollection.empty()) {
+    throw std::invalid_argument("Missing input track collection");
+  }
+  if (m_cfg.outputVertices.empty()) {
+    throw std::invalid_argument("Missing output vertices collection");
+  }
+  if (m_cfg.useHelixLinearizer
+      and ((m_cfg.bField.x() != 0) or (m_cfg.bField.y() != 0))) {
+    throw std::invalid_argument("Helix linearizer requires a field along z");
+  }
+  // the seeder validates its configuration on construction; do it here
+  // instead of on first use within the event loop.
+  if (m_cfg.useGridDensitySeeder) { GridSeeder(m_cfg.gridDensitySeeder); }
 }
 
+FWE::VertexFindingAlgorithm::~VertexFindingAlgorithm() = default;
+
 /// @brief Algorithm that receives all selected tracks from an event
 /// and finds and fits its vertices
 FW::ProcessCode
 FWE::VertexFindingAlgorithm::execute(const FW::AlgorithmContext& ctx) const
 {
-  using MagneticField     = Acts::ConstantBField;
-  using Stepper           = Acts::EigenStepper<MagneticField>;
-  using Propagator        = Acts::Propagator<Stepper>;
-  using PropagatorOptions = Acts::PropagatorOptions<>;
-  using TrackParameters   = Acts::BoundParameters;
-  using Linearizer        = Acts::HelicalTrackLinearizer<Propagator>;
-  using VertexFitter
-      = Acts::FullBilloirVertexFitter<TrackParameters, Linearizer>;
-  using VertexSeederImpactPointEstimator
-      = Acts::TrackToVertexIPEstimator<TrackParameters, Propagator>;
-  using VertexSeeder = Acts::ZScanVertexFinder<VertexFitter>;
-  using VertexFinder = Acts::IterativeVertexFinder<VertexFitter, VertexSeeder>;
-  using VertexFinderOptions = Acts::VertexFinderOptions<TrackParameters>;
-
-  static_assert(Acts::VertexFinderConcept<VertexSeeder>,
-                "VertexSeeder does not fulfill vertex finder concept.");
-  static_assert(Acts::VertexFinderConcept<VertexFinder>,
-                "VertexFinder does not fulfill vertex finder concept.");
-
-  // Set up the magnetic field
-  MagneticField bField(m_cfg.bField);
-  // Set up propagator with void navigator
-  auto              propagator = std::make_shared<Propagator>(Stepper(bField));
-  PropagatorOptions propagatorOpts(ctx.geoContext, ctx.magFieldContext);
-  // Setup the vertex fitter
-  VertexFitter::Config vertexFitterCfg;
-  VertexFitter         vertexFitter(std::move(vertexFitterCfg));
-  // Setup the track linearizer
-  Linearizer::Config linearizerCfg(bField, propagator, propagatorOpts);
-  Linearizer         linearizer(std::move(linearizerCfg));
-  // Setup the seed finder
-  VertexSeederImpactPointEstimator::Config seederIpEstCfg(propagator,
-                                                          propagatorOpts);
-  VertexSeederImpactPointEstimator seederIpEst(std::move(seederIpEstCfg));
-  VertexSeeder::Config             seederCfg(std::move(seederIpEst));
-  VertexSeeder                     seeder(std::move(seederCfg));
-  // Setup the impact point estimator
-  VertexFinder::ImpactPointEstimator::Config finderIpEstCfg(
-      bField, propagator, propagatorOpts);
-  VertexFinder::ImpactPointEstimator finderIpEst(std::move(finderIpEstCfg));
-  // Set up the actual vertex finder
-  VertexFinder::Config finderCfg(std::move(vertexFitter),
-                                 std::move(linearizer),
-                                 std::move(seeder),
-                                 std::move(finderIpEst));
-  finderCfg.maxVertices                 = 200;
-  finderCfg.reassignTracksAfterFirstFit = true;
-  VertexFinder        finder(finderCfg);
-  VertexFinderOptions finderOpts(ctx.geoContext, ctx.magFieldContext);
+  // the tools are constructed once per thread and rebound to this event
+  auto& localTools = m_tools.local();
+  if (m_cfg.rebuildTools) { localTools = std::make_unique<Tools>(m_cfg); }
+  Tools& tools          = *localTools;
+  tools.geoContext      = ctx.geoContext;
+  tools.magFieldContext = ctx.magFieldContext;
+  VertexFinderOptions finderOpts(tools.geoContext, tools.magFieldContext);
 
   // Setup containers
   const auto& input = ctx.eventStore.get<std::vector<FW::VertexAndTracks>>(
       m_cfg.trackCollection);
-  std::vector<Acts::BoundParameters> inputTrackCollection;
-
-  int counte = 0;
-  for (auto& bla : input) { counte += bla.tracks.size(); }
-
-  ACTS_INFO("Truth vertices in event: " << input.size());
-
-  for (auto& vertexAndTracks : input) {
-    ACTS_INFO("\t True vertex at ("
-              << vertexAndTracks.vertex.position().x() << ","
-              << vertexAndTracks.vertex.position().y() << ","
-              << vertexAndTracks.vertex.position().z() << ") with "
-              << vertexAndTracks.tracks.size() << " tracks.");
-    inputTrackCollection.insert(inputTrackCollection.end(),
-                                vertexAndTracks.tracks.begin(),
-                                vertexAndTracks.tracks.end());
-  }
 
+  // The finder only needs pointers; the tracks are not copied.
+  std::size_t nTracks = 0u;
+  for (const auto& vertexAndTracks : input) {
+    nTracks += vertexAndTracks.tracks.size();
+  }
   std::vector<const Acts::BoundParameters*> inputTrackPtrCollection;
-  for (const auto& trk : inputTrackCollection) {
-    inputTrackPtrCollection.push_back(&trk);
+  inputTrackPtrCollection.reserve(nTracks);
+  for (const auto& vertexAndTracks : input) {
+    ACTS_VERBOSE("True vertex at ("
+                 << vertexAndTracks.vertex.position().x() << ","
+                 << vertexAndTracks.vertex.position().y() << ","
+                 << vertexAndTracks.vertex.position().z() << ") with "
+                 << vertexAndTracks.tracks.size() << " tracks.");
+    for (const auto& trk : vertexAndTracks.tracks) {
+      inputTrackPtrCollection.push_back(&trk);
+    }
   }
 
-  // Find vertices
-  auto res = finder.find(inputTrackPtrCollection, finderOpts);
-
-  if (res.ok()) {
-    // Retrieve vertices found by vertex finder
-    auto vertexCollection = *res;
-
-    ACTS_INFO("Found " << vertexCollection.size() << " vertices in event.");
-
-    unsigned int count = 0;
-    for (const auto& vtx : vertexCollection) {
-      ACTS_INFO("\t" << ++count << ". vertex at "
-                     << "(" << vtx.position().x() << "," << vtx.position().y()
-                     << "," << vtx.position().z() << ") with "
-                     << vtx.tracks().size() << " tracks.");
+  // Find vertices; a failure results in an empty collection for this event
+  auto findVertices = [&]() {
+    if (tools.gridFinder) {
+      return tools.gridFinder->find(inputTrackPtrCollection, finderOpts);
     }
+    if (tools.zScanFinder) {
+      return tools.zScanFinder->find(inputTrackPtrCollection, finderOpts);
+    }
+    if (tools.helixGridFinder) {
+      return tools.helixGridFinder->find(inputTrackPtrCollection, finderOpts);
+    }
+    return tools.helixZScanFinder->find(inputTrackPtrCollection, finderOpts);
+  };
+  FW::RecVertexContainer vertices;
+  auto                   res = findVertices();
+  if (res.ok()) {
+    vertices = std::move(*res);
   } else {
     ACTS_ERROR("Error in vertex finder.");
   }
 
+  for (const auto& vtx : vertices) {
+    ACTS_VERBOSE("Found vertex at (" << vtx.position().x() << ","
+                                     << vtx.position().y() << ","
+                                     << vtx.position().z() << ") with "
+                                     << vtx.tracks().size() << " tracks.");
+  }
+  ACTS_DEBUG("Found " << vertices.size() << " vertices from " << nTracks
+                      << " tracks of " << input.size() << " true vertices");
+
+  ctx.eventStore.add(m_cfg.outputVertices, std::move(vertices));
   return FW::ProcessCode::SUCCESS;
 }
@@ -8,12 +8,23 @@
 
 #include "ACTFW/Vertexing/VertexFitAlgorithm.hpp"
 #include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "ACTFW/EventData/RecVertex.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "ACTFW/TruthTracking/VertexAndTracks.hpp"
+#include "ACTFW/Vertexing/HelixTrackLinearizer.hpp"
 #include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
 #include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
 #include "Acts/Propagator/EigenStepper.hpp"
 #include "Acts/Propagator/Propagator.hpp"
 #include "Acts/Surfaces/PerigeeSurface.hpp"
@@ -24,92 +35,178 @@
 #include "Acts/Vertexing/LinearizedTrack.hpp"
 #include "Acts/Vertexing/Vertex.hpp"
 
+namespace {
+using MagneticField     = Acts::ConstantBField;
+using Stepper           = Acts::EigenStepper<MagneticField>;
+using Propagator        = Acts::Propagator<Stepper>;
+using PropagatorOptions = Acts::PropagatorOptions<>;
+using TrackParameters   = Acts::BoundParameters;
+using Linearizer        = Acts::HelicalTrackLinearizer<Propagator>;
+using VertexFitter = Acts::FullBilloirVertexFitter<TrackParameters, Linearizer>;
+using HelixLinearizer = FWE::HelixTrackLinearizer<Propagator>;
+using HelixVertexFitter
+    = Acts::FullBilloirVertexFitter<TrackParameters, HelixLinearizer>;
+using VertexFitterOptions = Acts::VertexFitterOptions<TrackParameters>;
+}  // namespace
+
+/// The vertex fitter tool chain for one thread.
+///
+/// The propagator options stored within the linearizer reference the contexts
+/// owned by this object. They must be updated before each use and the object
+/// must not be moved.
+struct FWE::VertexFitAlgorithm::Tools
+{
+  Acts::GeometryContext            geoContext;
+  Acts::MagneticFieldContext       magFieldContext;
+  // only the fitter with the configured linearizer is constructed
+  std::optional<VertexFitter>      vertexFitter;
+  std::optional<Linearizer>        linearizer;
+  std::optional<HelixVertexFitter> helixVertexFitter;
+  std::optional<HelixLinearizer>   helixLinearizer;
+
+  Tools(const Config& cfg)
+  {
+    if (cfg.useHelixLinearizer) {
+      // Setup the vertex fitter and the closed-form linearizer
+      HelixVertexFitter::Config vertexFitterCfg;
+      helixVertexFitter.emplace(vertexFitterCfg);
+      HelixLinearizer::Config ltConfig;
+      ltConfig.bFieldInZ = cfg.bField.z();
+      helixLinearizer.emplace(ltConfig);
+      return;
+    }
+    // Setup the magnetic field
+    MagneticField bField(cfg.bField);
+    // Setup the propagator with void navigator
+    auto propagator = std::make_shared<Propagator>(Stepper(bField));
+    // the options reference the contexts owned by this object
+    PropagatorOptions propagatorOpts(geoContext, magFieldContext);
+    // Setup the vertex fitter
+    VertexFitter::Config vertexFitterCfg;
+    vertexFitter.emplace(vertexFitterCfg);
+    // Setup the linearizer
+    Linearizer::Config ltConfig(bField, propagator, propagatorOpts);
+    linearizer.emplace(ltConfig);
+  }
+  Tools(const Tools&) = delete;
+  Tools&
+  operator=(const Tools&)
+      = delete;
+};
+
 FWE::VertexFitAlgorithm::VertexFitAlgorithm(const Config&        cfg,
                                             Acts::Logging::Level level)
-  : FW::BareAlgorithm("VertexFit", level), m_cfg(cfg)
+  : FW::BareAlgorithm("VertexFit", level)
+  , m_cfg(cfg)
+  , m_tools([this]() { return std::make_unique<Tools>(m_cfg); })
 {
+  if (m_cfg.trackCollection.empty()) {
+    throw std::invalid_argument("Missing input track collection");
+  }
+  if (m_cfg.outputVertices.empty()) {
+    throw std::invalid_argument("Missing output vertices collection");
+  }
+  if (m_cfg.useHelixLinearizer
+      and ((m_cfg.bField.x() != 0) or (m_cfg.bField.y() != 0))) {
+    throw std::invalid_argument("Helix linearizer requires a field along z");
+  }
 }
 
+FWE::VertexFitAlgorithm::~VertexFitAlgorithm() = default;
+
 /// @brief Algorithm that receives a set of tracks belonging to a common
 /// vertex and fits the associated vertex to it
 FW::ProcessCode
 FWE::VertexFitAlgorithm::execute(const FW::AlgorithmContext& ctx) const
 {
-  using MagneticField     = Acts::ConstantBField;
-  using Stepper           = Acts::EigenStepper<MagneticField>;
-  using Propagator        = Acts::Propagator<Stepper>;
-  using PropagatorOptions = Acts::PropagatorOptions<>;
-  using TrackParameters   = Acts::BoundParameters;
-  using Linearizer        = Acts::HelicalTrackLinearizer<Propagator>;
-  using VertexFitter
-      = Acts::FullBilloirVertexFitter<TrackParameters, Linearizer>;
-  using VertexFitterOptions = Acts::VertexFitterOptions<TrackParameters>;
-
-  // Setup the magnetic field
-  MagneticField bField(m_cfg.bField);
-  // Setup the propagator with void navigator
-  auto              propagator = std::make_shared<Propagator>(Stepper(bField));
-  PropagatorOptions propagatorOpts(ctx.geoContext, ctx.magFieldContext);
-  // Setup the vertex fitter
-  VertexFitter::Config vertexFitterCfg;
-  VertexFitter         vertexFitter(vertexFitterCfg);
-  // Setup the linearizer
-  Linearizer::Config ltConfig(bField, propagator, propagatorOpts);
-  Linearizer         linearizer(ltConfig);
-
   const auto& input = ctx.eventStore.get<std::vector<FW::VertexAndTracks>>(
       m_cfg.trackCollection);
-  for (auto& vertexAndTracks : input) {
 
-    const auto& inputTrackCollection = vertexAndTracks.tracks;
+  // Prepare the output with one slot per input vertex
+  FW::RecVertexContainer fittedVertices(input.size());
+  std::vector<char>      isFitted(input.size(), false);
 
-    std::vector<const Acts::BoundParameters*> inputTrackPtrCollection;
-    for (const auto& trk : inputTrackCollection) {
-      inputTrackPtrCollection.push_back(&trk);
+  // Fit a range of vertex candidates. Each fit only writes to its own output
+  // slot so the result does not depend on the execution order.
+  auto fitVertices = [&](std::size_t begin, std::size_t end) {
+    // the tools are constructed once per thread and rebound to this event
+    auto& localTools = m_tools.local();
+    if (m_cfg.rebuildTools) {
+      localTools = std::make_unique<Tools>(m_cfg);
     }
+    Tools& tools          = *localTools;
+    tools.geoContext      = ctx.geoContext;
+    tools.magFieldContext = ctx.magFieldContext;
 
-    Acts::Vertex<TrackParameters> fittedVertex;
-    if (!m_cfg.doConstrainedFit) {
-      if (inputTrackCollection.size() < 2) { continue; }
-      // Vertex fitter options
-      VertexFitterOptions vfOptions(ctx.geoContext, ctx.magFieldContext);
-
-      auto fitRes
-          = vertexFitter.fit(inputTrackPtrCollection, linearizer, vfOptions);
-      if (fitRes.ok()) {
-        fittedVertex = *fitRes;
-      } else {
-        ACTS_ERROR("Error in vertex fit.");
+    // Vertex constraint; only used for the constrained fit
+    Acts::Vertex<TrackParameters> theConstraint;
+    theConstraint.setCovariance(m_cfg.constraintCov);
+    theConstraint.setPosition(m_cfg.constraintPos);
+
+    std::vector<const Acts::BoundParameters*> inputTrackPtrCollection;
+    for (std::size_t ivtx = begin; ivtx < end; ++ivtx) {
+      const auto& vertexAndTracks = input[ivtx];
+      if (not m_cfg.doConstrainedFit and (vertexAndTracks.tracks.size() < 2)) {
+        continue;
       }
-    } else {
-      // Vertex constraint
-      Acts::Vertex<TrackParameters> theConstraint;
-
-      theConstraint.setCovariance(m_cfg.constraintCov);
-      theConstraint.setPosition(m_cfg.constraintPos);
-
-      // Vertex fitter options
-      VertexFitterOptions vfOptionsConstr(
-          ctx.geoContext, ctx.magFieldContext, theConstraint);
-
-      auto fitRes = vertexFitter.fit(
-          inputTrackPtrCollection, linearizer, vfOptionsConstr);
-      if (fitRes.ok()) {
-        fittedVertex = *fitRes;
-      } else {
+
+      inputTrackPtrCollection.clear();
+      for (const auto& trk : vertexAndTracks.tracks) {
+        inputTrackPtrCollection.push_back(&trk);
+      }
+
+      const auto fitterOpts = m_cfg.doConstrainedFit
+          ? VertexFitterOptions(
+              tools.geoContext, tools.magFieldContext, theConstraint)
+          : VertexFitterOptions(tools.geoContext, tools.magFieldContext);
+      auto fitRes = tools.helixLinearizer
+          ? tools.helixVertexFitter->fit(
+              inputTrackPtrCollection, *tools.helixLinearizer, fitterOpts)
+          : tools.vertexFitter->fit(
+              inputTrackPtrCollection, *tools.linearizer, fitterOpts);
+      if (not fitRes.ok()) {
         ACTS_ERROR("Error in vertex fit.");
+        continue;
       }
+      fittedVertices[ivtx] = std::move(*fitRes);
+      isFitted[ivtx]       = true;
+
+      const auto& fitted = fittedVertices[ivtx].position();
+      const auto& truth  = vertexAndTracks.vertex.position();
+      ACTS_VERBOSE("Fitted vertex: (" << fitted.x() << "," << fitted.y() << ","
+                                      << fitted.z() << ")");
+      ACTS_VERBOSE("Truth vertex: (" << truth.x() << "," << truth.y() << ","
+                                     << truth.z() << ")");
     }
+  };
+
+  if ((0u < m_cfg.minVerticesPerTask)
+      and (m_cfg.minVerticesPerTask < input.size())) {
+    // a blocked range is only split if it is larger than the grain size and
+    // then into halves, i.e. this grain size ensures the minimum task size.
+    const std::size_t grainSize = 2 * m_cfg.minVerticesPerTask - 1;
+    // isolation prevents a thread waiting for the vertices of this event from
+    // picking up a different event that would rebind its tools.
+    tbb::this_task_arena::isolate([&]() {
+      tbb::parallel_for(
+          tbb::blocked_range<std::size_t>(0, input.size(), grainSize),
+          [&](const tbb::blocked_range<std::size_t>& r) {
+            fitVertices(r.begin(), r.end());
+          });
+    });
+  } else {
+    fitVertices(0, input.size());
+  }
 
-    ACTS_INFO("Fitted Vertex: "
-              << "(" << fittedVertex.position().x() << ","
-              << fittedVertex.position().y() << ","
-              << fittedVertex.position().z() << ")");
-    ACTS_INFO("Truth Vertex: "
-              << "(" << vertexAndTracks.vertex.position().x() << ","
-              << vertexAndTracks.vertex.position().y() << ","
-              << vertexAndTracks.vertex.position().z() << ")");
+  // Keep only the successfully fitted vertices in the input order
+  FW::RecVertexContainer vertices;
+  vertices.reserve(input.size());
+  for (std::size_t ivtx = 0; ivtx < input.size(); ++ivtx) {
+    if (isFitted[ivtx]) { vertices.push_back(std::move(fittedVertices[ivtx])); }
   }
+  ACTS_DEBUG("Fitted " << vertices.size() << " of " << input.size()
+                       << " vertices");
 
+  ctx.eventStore.add(m_cfg.outputVertices, std::move(vertices));
   return FW::ProcessCode::SUCCESS;
 }
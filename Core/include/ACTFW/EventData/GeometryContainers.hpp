@@ -16,6 +16,7 @@
 #include <boost/container/flat_set.hpp>
 
 #include "ACTFW/Utilities/GroupBy.hpp"
+#include "ACTFW/Utilities/RadixSort.hpp"
 #include "ACTFW/Utilities/Range.hpp"
 #include "Acts/Geometry/GeometryID.hpp"
 
@@ -97,6 +98,33 @@ using GeometryIdMultiset
 template <typename T>
 using GeometryIdMultimap = GeometryIdMultiset<std::pair<Acts::GeometryID, T>>;
 
+/// Build a geometry container from an unordered sequence of elements.
+///
+/// @param unordered elements in arbitrary order stored in the `sequence_type`
+///                  of a `GeometryIdMultiset` or `GeometryIdMultimap`
+/// @return container with elements ordered by geometry id
+///
+/// Elements can be added to the sequence without any ordering requirements
+/// and are bulk-sorted once using a linear-time radix sort on the encoded
+/// geometry identifier. Large sequences are sorted using multiple threads.
+/// Elements with the same geometry id keep their relative input order.
+template <typename Sequence>
+inline GeometryIdMultiset<typename Sequence::value_type>
+makeGeometryIdMultiset(Sequence unordered)
+{
+  const bool parallel = (8 * kRadixSortGrainSize) < unordered.size();
+  radixSort(
+      unordered,
+      [](const auto& element) {
+        return detail::GeometryIdGetter()(element).value();
+      },
+      parallel);
+  GeometryIdMultiset<typename Sequence::value_type> container;
+  container.adopt_sequence(boost::container::ordered_range,
+                           std::move(unordered));
+  return container;
+}
+
 /// Select all elements within the given volume.
 template <typename T>
 inline Range<typename GeometryIdMultiset<T>::const_iterator>
@@ -0,0 +1,199 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/Utilities/Range.hpp"
+#include "Acts/Geometry/GeometryID.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace Acts {
+class Surface;
+}
+
+namespace FW {
+
+/// A single readout cell that contributes to a planar cluster.
+struct PlanarCell
+{
+  uint32_t channel0 = 0u;
+  uint32_t channel1 = 0u;
+  /// Deposited charge or path length depending on the digitization.
+  float value = 0.0f;
+};
+
+/// A planar cluster that references its cells and truth hits by offset.
+///
+/// The cluster does not own its constituents. Cells and simulated hit indices
+/// are stored in pooled arrays within the `PlanarClusterContainer` and must
+/// be accessed through it. The surface is stored as a plain pointer since
+/// surfaces are owned by the tracking geometry which outlives the event data.
+struct PlanarCluster
+{
+  Acts::GeometryID     geoId;
+  const Acts::Surface* surface = nullptr;
+  /// Local position and time.
+  double local0 = 0.0;
+  double local1 = 0.0;
+  double time   = 0.0;
+  /// Local position and time covariance.
+  Acts::ActsSymMatrixD<3> cov = Acts::ActsSymMatrixD<3>::Zero();
+  // offsets into the pooled arrays of the owning container
+  uint32_t cellsBegin = 0u;
+  uint32_t cellsSize  = 0u;
+  uint32_t hitsBegin  = 0u;
+  uint32_t hitsSize   = 0u;
+
+  constexpr Acts::GeometryID
+  geometryId() const
+  {
+    return geoId;
+  }
+};
+
+/// Event-level store for planar clusters ordered by geometry id.
+///
+/// In contrast to a `GeometryIdMultimap<Acts::PlanarModuleCluster>`, adding a
+/// cluster requires no per-cluster heap allocations. All cells and associated
+/// simulated hit indices are appended to shared pools. A cluster is built by
+/// first adding its cells and hit indices and then finalizing it:
+///
+///     for (...) { clusters.addCell({ch0, ch1, value}); }
+///     clusters.addHitIndex(simHitIdx);
+///     clusters.finishCluster(cluster);
+///
+/// Clusters must be finished in geometry id order. Their position in the
+/// container is stable and can be used as a hit index.
+class PlanarClusterContainer
+{
+public:
+  using Clusters       = GeometryIdMultiset<PlanarCluster>;
+  using const_iterator = Clusters::const_iterator;
+  using CellRange      = Range<std::vector<PlanarCell>::const_iterator>;
+  using HitIndexRange  = Range<std::vector<std::size_t>::const_iterator>;
+
+  /// Reserve space for the expected number of elements.
+  void
+  reserve(std::size_t nClusters, std::size_t nCells, std::size_t nHits)
+  {
+    m_clusters.reserve(nClusters);
+    m_cells.reserve(nCells);
+    m_hitIndices.reserve(nHits);
+  }
+
+  /// Add a cell to the next cluster.
+  void
+  addCell(const PlanarCell& cell)
+  {
+    m_cells.push_back(cell);
+  }
+  /// Add a simulated hit index to the next cluster.
+  void
+  addHitIndex(std::size_t hitIndex)
+  {
+    m_hitIndices.push_back(hitIndex);
+  }
+
+  /// Finalize the cluster with all cells and hit indices added since the
+  /// previous cluster.
+  ///
+  /// @param cluster cluster information; constituent offsets are overwritten
+  /// @return index of the cluster in the container
+  /// @throws std::invalid_argument if the geometry id ordering is violated
+  /// @throws std::length_error if the pools can not be addressed anymore
+  std::size_t
+  finishCluster(PlanarCluster cluster)
+  {
+    if (not m_clusters.empty()
+        and (cluster.geoId < m_clusters.rbegin()->geoId)) {
+      throw std::invalid_argument("Clusters must be added in geometry order");
+    }
+    if ((std::numeric_limits<uint32_t>::max() < m_cells.size())
+        or (std::numeric_limits<uint32_t>::max() < m_hitIndices.size())) {
+      throw std::length_error("Too many cluster constituents");
+    }
+    cluster.cellsBegin = m_pendingCells;
+    cluster.cellsSize  = m_cells.size() - m_pendingCells;
+    cluster.hitsBegin  = m_pendingHits;
+    cluster.hitsSize   = m_hitIndices.size() - m_pendingHits;
+    m_pendingCells     = m_cells.size();
+    m_pendingHits      = m_hitIndices.size();
+    auto it = m_clusters.emplace_hint(m_clusters.end(), std::move(cluster));
+    return m_clusters.index_of(it);
+  }
+
+  /// Access the clusters container e.g. for geometry selections.
+  const Clusters&
+  clusters() const
+  {
+    return m_clusters;
+  }
+  const_iterator
+  begin() const
+  {
+    return m_clusters.begin();
+  }
+  const_iterator
+  end() const
+  {
+    return m_clusters.end();
+  }
+  const_iterator
+  nth(std::size_t index) const
+  {
+    return m_clusters.nth(index);
+  }
+  std::size_t
+  index_of(const_iterator it) const
+  {
+    return m_clusters.index_of(it);
+  }
+  std::size_t
+  size() const
+  {
+    return m_clusters.size();
+  }
+  bool
+  empty() const
+  {
+    return m_clusters.empty();
+  }
+
+  /// Access the cells of a cluster from this container.
+  CellRange
+  cells(const PlanarCluster& cluster) const
+  {
+    auto b = std::next(m_cells.begin(), cluster.cellsBegin);
+    return makeRange(b, std::next(b, cluster.cellsSize));
+  }
+  /// Access the simulated hit indices of a cluster from this container.
+  HitIndexRange
+  hitIndices(const PlanarCluster& cluster) const
+  {
+    auto b = std::next(m_hitIndices.begin(), cluster.hitsBegin);
+    return makeRange(b, std::next(b, cluster.hitsSize));
+  }
+
+private:
+  Clusters                 m_clusters;
+  std::vector<PlanarCell>  m_cells;
+  std::vector<std::size_t> m_hitIndices;
+  // start of the constituents for the next cluster
+  uint32_t m_pendingCells = 0u;
+  uint32_t m_pendingHits  = 0u;
+};
+
+}  // namespace FW
@@ -0,0 +1,29 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/// @file
+/// @brief All reconstructed vertex-related shared types.
+
+#pragma once
+
+#include <vector>
+
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Vertexing/Vertex.hpp"
+
+namespace FW {
+
+/// Reconstructed vertex with its associated tracks.
+///
+/// The tracks at the vertex reference the original input track parameters.
+/// These must be stored in the event store and outlive the vertex.
+using RecVertex = Acts::Vertex<Acts::BoundParameters>;
+/// Container of reconstructed vertices.
+using RecVertexContainer = std::vector<RecVertex>;
+
+}  // namespace FW
@@ -0,0 +1,128 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "ACTFW/EventData/SimParticle.hpp"
+#include "ActsFatras/EventData/Barcode.hpp"
+
+namespace FW {
+
+/// Hash index for fast particle lookup by barcode.
+///
+/// The `SimParticleContainer` is ordered by barcode and supports lookup via
+/// binary search. For large events with many lookups, e.g. in truth matching,
+/// this is a cache-unfriendly access pattern. This index is built once per
+/// event for a given container and provides constant-time lookup using open
+/// addressing with linear probing.
+///
+/// The index only stores positions into the container and does not own the
+/// particles. It must not outlive the container and is invalidated if the
+/// container is modified.
+class SimParticleIndex
+{
+public:
+  using const_iterator = SimParticleContainer::const_iterator;
+
+  /// Construct an empty index that is not attached to any container.
+  SimParticleIndex() = default;
+  /// Build the index for all particles in the container.
+  ///
+  /// @throws std::length_error if the container is too large to be indexed
+  explicit SimParticleIndex(const SimParticleContainer& particles);
+
+  /// Find the particle with the given barcode.
+  ///
+  /// @return iterator to the particle or the container end if not found
+  const_iterator
+  find(ActsFatras::Barcode particleId) const;
+
+  /// Find the container position of the particle with the given barcode.
+  ///
+  /// @return position in the container or SIZE_MAX if not found
+  std::size_t
+  indexOf(ActsFatras::Barcode particleId) const;
+
+private:
+  // position 0 marks an empty slot; stored positions are shifted by one
+  struct Slot
+  {
+    ActsFatras::Barcode::Value key = 0u;
+    uint32_t                   pos = 0u;
+  };
+
+  const SimParticleContainer* m_particles = nullptr;
+  std::vector<Slot>           m_slots;
+  std::size_t                 m_mask = 0u;
+
+  static constexpr std::size_t
+  hash(ActsFatras::Barcode::Value key)
+  {
+    // 64bit finalizer from splitmix64 to spread the structured barcode bits
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9u;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebu;
+    key ^= key >> 31;
+    return static_cast<std::size_t>(key);
+  }
+};
+
+}  // namespace FW
+
+inline FW::SimParticleIndex::SimParticleIndex(
+    const SimParticleContainer& particles)
+  : m_particles(&particles)
+{
+  if (std::numeric_limits<uint32_t>::max() <= particles.size()) {
+    throw std::length_error("Too many particles to build a barcode index");
+  }
+  // keep the load factor at or below 0.5 to guarantee short probe sequences
+  std::size_t capacity = 16u;
+  while (capacity < 2 * particles.size()) { capacity *= 2; }
+  m_slots.resize(capacity);
+  m_mask = capacity - 1;
+
+  uint32_t pos = 0u;
+  for (const auto& particle : particles) {
+    const auto key = particle.particleId().value();
+    auto       i   = hash(key) & m_mask;
+    // container elements are unique; no need to check for existing keys
+    while (m_slots[i].pos != 0u) { i = (i + 1) & m_mask; }
+    m_slots[i].key = key;
+    m_slots[i].pos = ++pos;
+  }
+}
+
+inline std::size_t
+FW::SimParticleIndex::indexOf(ActsFatras::Barcode particleId) const
+{
+  if (m_slots.empty()) { return SIZE_MAX; }
+  const auto key = particleId.value();
+  for (auto i = hash(key) & m_mask; m_slots[i].pos != 0u;
+       i      = (i + 1) & m_mask) {
+    if (m_slots[i].key == key) { return m_slots[i].pos - 1u; }
+  }
+  return SIZE_MAX;
+}
+
+inline FW::SimParticleIndex::const_iterator
+FW::SimParticleIndex::find(ActsFatras::Barcode particleId) const
+{
+  if (not m_particles) {
+    throw std::logic_error("Particle index is not attached to a container");
+  }
+  const auto pos = indexOf(particleId);
+  return (pos != SIZE_MAX) ? m_particles->nth(pos) : m_particles->end();
+}
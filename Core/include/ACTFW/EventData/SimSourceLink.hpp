@@ -65,6 +65,24 @@ public:
   {
     return *m_truthHit;
   }
+  /// Number of measured local parameters, starting with eLOC_0.
+  constexpr size_t
+  dimension() const
+  {
+    return m_dim;
+  }
+  /// Measured values; only the first `dimension()` entries are valid.
+  const Acts::BoundVector&
+  values() const
+  {
+    return m_values;
+  }
+  /// Measurement covariance; only the leading `dimension()` block is valid.
+  const Acts::BoundMatrix&
+  covariance() const
+  {
+    return m_cov;
+  }
 
   Acts::FittableMeasurement<SimSourceLink> operator*() const
   {
@@ -0,0 +1,159 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Acts/Utilities/Units.hpp"
+
+namespace FW {
+
+/// A single space point as input to the space point container.
+struct SpacePoint
+{
+  float x = 0.0f;
+  float y = 0.0f;
+  float z = 0.0f;
+  /// Variance of the position in the transverse radius and along z.
+  float varianceR = 0.0f;
+  float varianceZ = 0.0f;
+  /// Index of the underlying measurement, e.g. the cluster index.
+  uint32_t measurementIndex = 0u;
+};
+
+/// Uniform binning of space points in phi and z.
+///
+/// Positions outside the z range are assigned to the first or last bin.
+struct SpacePointBinning
+{
+  std::size_t numPhiBins = 64u;
+  std::size_t numZBins   = 16u;
+  double      zMin       = -3000 * Acts::UnitConstants::mm;
+  double      zMax       = 3000 * Acts::UnitConstants::mm;
+
+  /// Total number of bins.
+  std::size_t
+  size() const
+  {
+    return numPhiBins * numZBins;
+  }
+  /// Bin index along phi for an angle in [-pi,pi).
+  std::size_t
+  phiBin(double phi) const;
+  /// Bin index along z.
+  std::size_t
+  zBin(double z) const;
+  /// Global bin index.
+  std::size_t
+  bin(std::size_t iphi, std::size_t iz) const
+  {
+    return iphi * numZBins + iz;
+  }
+};
+
+/// Space points in structure-of-arrays layout sorted into phi/z bins.
+///
+/// All properties of the space points are stored in separate, contiguous
+/// arrays and can be accessed by the space point index. The space points are
+/// sorted by phi bin, then by z bin, and then by transverse radius, i.e. the
+/// points of each bin are stored contiguously and in increasing radius.
+class SpacePointContainer
+{
+public:
+  /// Construct an empty container.
+  SpacePointContainer() = default;
+  /// Construct the container by sorting the space points into bins.
+  ///
+  /// @throws std::invalid_argument for an invalid binning configuration
+  SpacePointContainer(const SpacePointBinning&       binning,
+                      const std::vector<SpacePoint>& spacePoints);
+
+  const SpacePointBinning&
+  binning() const
+  {
+    return m_binning;
+  }
+  std::size_t
+  size() const
+  {
+    return m_x.size();
+  }
+  bool
+  empty() const
+  {
+    return m_x.empty();
+  }
+
+  /// Index range [begin,end) of the space points in the given bin.
+  std::pair<std::size_t, std::size_t>
+  binRange(std::size_t iphi, std::size_t iz) const
+  {
+    const auto ibin = m_binning.bin(iphi, iz);
+    return {m_binOffsets[ibin], m_binOffsets[ibin + 1]};
+  }
+
+  // per-space point properties
+  const std::vector<float>&
+  x() const
+  {
+    return m_x;
+  }
+  const std::vector<float>&
+  y() const
+  {
+    return m_y;
+  }
+  const std::vector<float>&
+  z() const
+  {
+    return m_z;
+  }
+  const std::vector<float>&
+  r() const
+  {
+    return m_r;
+  }
+  const std::vector<float>&
+  phi() const
+  {
+    return m_phi;
+  }
+  const std::vector<float>&
+  varianceR() const
+  {
+    return m_varianceR;
+  }
+  const std::vector<float>&
+  varianceZ() const
+  {
+    return m_varianceZ;
+  }
+  const std::vector<uint32_t>&
+  measurementIndex() const
+  {
+    return m_measurementIndex;
+  }
+
+private:
+  SpacePointBinning        m_binning;
+  std::vector<std::size_t> m_binOffsets = std::vector<std::size_t>(1u, 0u);
+  std::vector<float>       m_x;
+  std::vector<float>       m_y;
+  std::vector<float>       m_z;
+  std::vector<float>       m_r;
+  std::vector<float>       m_phi;
+  std::vector<float>       m_varianceR;
+  std::vector<float>       m_varianceZ;
+  std::vector<uint32_t>    m_measurementIndex;
+};
+
+}  // namespace FW
@@ -0,0 +1,30 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cstddef>
+
+namespace FW {
+
+/// Per-event counts of the track finding.
+struct TrackFindingStatistics
+{
+  /// Number of initial track parameters, i.e. seeds.
+  std::size_t seeds = 0u;
+  /// Number of seeds for which the track finding failed.
+  std::size_t failedSeeds = 0u;
+  /// Number of track candidates found for all seeds.
+  std::size_t candidates = 0u;
+  /// Number of output tracks, i.e. kept candidates.
+  std::size_t tracks = 0u;
+  /// Number of input measurements.
+  std::size_t measurements = 0u;
+};
+
+}  // namespace FW
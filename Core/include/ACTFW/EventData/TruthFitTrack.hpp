@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -23,6 +24,11 @@ namespace FW {
 
 /// @brief struct for truth fitting result
 ///
+/// The fitted multiTrajectory is shared and immutable, i.e. several tracks
+/// with different entry points can refer to the same trajectory, e.g. all
+/// candidates found from one seed, and copying a track does not copy the
+/// trajectory.
+///
 /// @Todo Use a track proxy or helper to retrieve the detailed info, such as
 /// number of measurments, holes, truth info etc.
 struct TruthFitTrack
@@ -37,7 +43,20 @@ public:
   /// @param trajectory The fitted multiTrajectory
   TruthFitTrack(size_t                                      tTip,
                 const Acts::MultiTrajectory<SimSourceLink>& trajectory)
-    : m_trackTip(tTip), m_trajectory(trajectory)
+    : m_trackTip(tTip)
+    , m_trajectory(
+          std::make_shared<Acts::MultiTrajectory<SimSourceLink>>(trajectory))
+  {
+  }
+
+  /// Constructor from shared fitted trajectory
+  ///
+  /// @param tTip The fitted multiTrajectory entry point
+  /// @param trajectory The shared fitted multiTrajectory
+  TruthFitTrack(
+      size_t tTip,
+      std::shared_ptr<const Acts::MultiTrajectory<SimSourceLink>> trajectory)
+    : m_trackTip(tTip), m_trajectory(std::move(trajectory))
   {
   }
 
@@ -57,16 +76,37 @@ public:
   TruthFitTrack(size_t                                      tTip,
                 const Acts::MultiTrajectory<SimSourceLink>& trajectory,
                 const Acts::BoundParameters&                parameter)
-    : m_trackTip(tTip), m_trajectory(trajectory), m_trackParameters(parameter)
+    : m_trackTip(tTip)
+    , m_trajectory(
+          std::make_shared<Acts::MultiTrajectory<SimSourceLink>>(trajectory))
+    , m_trackParameters(parameter)
+  {
+  }
+
+  /// Constructor from shared fitted trajectory and fitted track parameter
+  ///
+  /// @param tTip The fitted multiTrajectory entry point
+  /// @param trajectory The shared fitted multiTrajectory
+  /// @param parameter The fitted track parameter
+  TruthFitTrack(
+      size_t tTip,
+      std::shared_ptr<const Acts::MultiTrajectory<SimSourceLink>> trajectory,
+      const Acts::BoundParameters& parameter)
+    : m_trackTip(tTip)
+    , m_trajectory(std::move(trajectory))
+    , m_trackParameters(parameter)
   {
   }
 
   /// Get trajectory along with the entry point
-  const std::pair<size_t, Acts::MultiTrajectory<SimSourceLink>>
+  ///
+  /// The trajectory is returned by reference and is only valid as long as
+  /// this track or one of its copies exists.
+  std::pair<size_t, const Acts::MultiTrajectory<SimSourceLink>&>
   trajectory() const
   {
     if (m_trajectory) {
-      return std::make_pair(m_trackTip, *m_trajectory);
+      return {m_trackTip, *m_trajectory};
     } else {
       throw std::runtime_error("No fitted states on this trajectory!");
     };
@@ -170,8 +210,8 @@ public:
   }
 
 private:
-  // The optional fitted multitrajectory
-  std::optional<Acts::MultiTrajectory<SimSourceLink>> m_trajectory;
+  // The optional fitted multitrajectory; shared with other tracks
+  std::shared_ptr<const Acts::MultiTrajectory<SimSourceLink>> m_trajectory;
 
   // This is the index of the 'tip' of the track stored in multitrajectory.
   size_t m_trackTip = SIZE_MAX;
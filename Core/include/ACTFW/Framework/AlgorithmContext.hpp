@@ -9,11 +9,14 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <Acts/Geometry/GeometryContext.hpp>
 #include <Acts/MagneticField/MagneticFieldContext.hpp>
 #include <Acts/Utilities/CalibrationContext.hpp>
 
+#include "ACTFW/Framework/CapacityHints.hpp"
+
 namespace FW {
 
 class WhiteBoard;
@@ -43,6 +46,17 @@ struct AlgorithmContext
     return (*this);
   }
 
+  /// @brief capacity hint to reserve memory for an output collection
+  ///
+  /// @param collection is the name of the collection in the event store
+  /// @param fallback is the static estimate used if no hint is available
+  std::size_t
+  capacityHint(const std::string& collection, std::size_t fallback) const
+  {
+    return capacityHints ? capacityHints->hint(collection, fallback)
+                         : fallback;
+  }
+
   size_t                algorithmNumber;  ///< Unique algorithm identifier
   size_t                eventNumber;      ///< Unique event identifier
   WhiteBoard&           eventStore;       ///< Per-event data store
@@ -50,6 +64,7 @@ struct AlgorithmContext
   Acts::MagneticFieldContext
                            magFieldContext;  ///< Per-event magnetic Field context
   Acts::CalibrationContext calibContext;     ///< Per-event calbiration context
+  const CapacityHints*     capacityHints = nullptr;  ///< Collection size hints
 };
 
 }  // namespace FW
@@ -0,0 +1,117 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace FW {
+
+/// Adaptive capacity hints for per-event output collections.
+///
+/// Records the final size of event store collections over a window of recent
+/// events and provides a capacity hint, i.e. a high percentile of the recorded
+/// sizes, that can be used to reserve memory for the next event. This avoids
+/// repeated reallocations for events that are larger than a static estimate.
+///
+/// Recording and querying is thread-safe and can be used concurrently from
+/// multiple events. Each collection has its own lock, i.e. only events that
+/// add the same collection at the same time wait for each other, and the
+/// hint is only recomputed every few recorded events. Queries do not wait
+/// for recordings.
+///
+/// To check the effect of the hints, the number of reallocations is estimated
+/// for each collection that is reserved using the hints. The estimate assumes
+/// a vector that doubles its capacity on growth and that is either reserved
+/// with the hint available when the size is recorded or with the static
+/// fallback that the algorithm provides to the query.
+class CapacityHints
+{
+public:
+  struct Config
+  {
+    /// Number of recent events that are considered for each collection.
+    std::size_t window = 64u;
+    /// Which percentile of the recorded sizes to use as the hint.
+    double percentile = 0.9;
+    /// Recompute the hint after this number of recorded events.
+    std::size_t updateInterval = 8u;
+  };
+
+  /// Reallocation statistics for a collection.
+  struct Statistics
+  {
+    std::string collection;
+    /// Number of recorded events.
+    std::size_t events = 0u;
+    /// Number of events where the size exceeded the available hint.
+    std::size_t exceeded = 0u;
+    /// Estimated number of reallocations with the hints.
+    std::size_t reallocations = 0u;
+    /// Estimated number of reallocations with the static fallback. The
+    /// fallback of the most recent query is used, which can belong to a
+    /// concurrent event if the fallback depends on the event.
+    std::size_t reallocationsWithFallback = 0u;
+  };
+
+  /// @throws std::invalid_argument on invalid configuration
+  CapacityHints(const Config& cfg);
+
+  /// Record the final size of a collection for one event.
+  void
+  record(const std::string& collection, std::size_t size);
+
+  /// Capacity hint for a collection.
+  ///
+  /// @param collection name of the collection in the event store
+  /// @param fallback value to be used if no sizes have been recorded yet
+  std::size_t
+  hint(const std::string& collection, std::size_t fallback) const;
+
+  /// Reallocation statistics of all collections that were queried for hints,
+  /// ordered by collection name.
+  std::vector<Statistics>
+  statistics() const;
+
+private:
+  struct Entry
+  {
+    // the lock protects the recorded sizes and the statistics
+    std::mutex mutex;
+    // ring buffer of recorded sizes and scratch space for the percentile
+    std::vector<std::size_t> sizes;
+    std::vector<std::size_t> sorted;
+    std::size_t              next      = 0u;
+    std::size_t              sinceHint = 0u;
+    Statistics               statistics;
+    // read by queries without the lock
+    std::atomic<bool>        hasHint{false};
+    std::atomic<std::size_t> hint{0u};
+    std::atomic<bool>        queried{false};
+    std::atomic<std::size_t> fallback{0u};
+  };
+
+  /// Find the entry for a collection or create it if it does not exist.
+  ///
+  /// Entries are never removed and references to them stay valid.
+  Entry&
+  entry(const std::string& collection) const;
+
+  Config m_cfg;
+  // the lock only protects the collection lookup, not the entries
+  mutable std::shared_mutex                      m_entriesMutex;
+  mutable std::unordered_map<std::string, Entry> m_entries;
+};
+
+}  // namespace FW
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "ACTFW/Framework/AlgorithmContext.hpp"
 #include "ACTFW/Framework/ProcessCode.hpp"
@@ -31,6 +32,21 @@ public:
   /// Execute the algorithm for one event.
   virtual ProcessCode
   execute(const AlgorithmContext& context) const = 0;
+
+  /// Collections read from the event store; empty if not declared.
+  virtual std::vector<std::string>
+  inputCollections() const
+  {
+    return {};
+  }
+
+  /// Collections consumed from the event store, i.e. not available anymore
+  /// to subsequent algorithms and writers.
+  virtual std::vector<std::string>
+  consumedCollections() const
+  {
+    return {};
+  }
 };
 
 }  // namespace FW
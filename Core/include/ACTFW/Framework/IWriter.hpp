@@ -13,6 +13,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "ACTFW/Framework/AlgorithmContext.hpp"
 #include "ACTFW/Framework/ProcessCode.hpp"
@@ -42,6 +43,13 @@ public:
   virtual ProcessCode
   endRun()
       = 0;
+
+  /// Collections read from the event store; empty if not declared.
+  virtual std::vector<std::string>
+  inputCollections() const
+  {
+    return {};
+  }
 };
 
 }  // namespace FW
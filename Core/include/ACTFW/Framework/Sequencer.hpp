@@ -16,6 +16,7 @@
 
 #include <Acts/Utilities/Logger.hpp>
 
+#include "ACTFW/Framework/CapacityHints.hpp"
 #include "ACTFW/Framework/IAlgorithm.hpp"
 #include "ACTFW/Framework/IContextDecorator.hpp"
 #include "ACTFW/Framework/IReader.hpp"
@@ -44,6 +45,8 @@ public:
     int numThreads = -1;
     /// output directory for timing information, empty for working directory
     std::string outputDir;
+    /// collection size tracking for the per-event capacity hints
+    CapacityHints::Config capacityHints;
   };
 
   Sequencer(const Config& cfg);
@@ -100,6 +103,10 @@ public:
   /// This will run the start-of-run hook for all configured services, run all
   /// configured readers, algorithms, and writers for each event, then invoke
   /// the end-of-run hook for all configured writers.
+  ///
+  /// Before the event loop, the declared inputs of all algorithms and writers
+  /// are checked against the collections consumed by previous algorithms.
+  /// Undeclared accesses to consumed collections fail during the event loop.
   int
   run();
 
@@ -110,6 +117,9 @@ private:
   /// Determine range of (requested) events; [SIZE_MAX, SIZE_MAX) for error.
   std::pair<size_t, size_t>
   determineEventsRange() const;
+  /// Check that no declared input is consumed by a previous algorithm.
+  bool
+  checkConsumedCollections() const;
 
   Config                                          m_cfg;
   std::vector<std::shared_ptr<IService>>          m_services;
@@ -117,6 +127,7 @@ private:
   std::vector<std::shared_ptr<IReader>>           m_readers;
   std::vector<std::shared_ptr<IAlgorithm>>        m_algorithms;
   std::vector<std::shared_ptr<IWriter>>           m_writers;
+  std::unique_ptr<CapacityHints>                  m_capacityHints;
   std::unique_ptr<const Acts::Logger>             m_logger;
 
   const Acts::Logger&
@@ -14,11 +14,26 @@
 #include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <Acts/Utilities/Logger.hpp>
 
+#include "ACTFW/Framework/CapacityHints.hpp"
+
 namespace FW {
+namespace detail {
+  // detect collections with a `.size()` method
+  template <typename T, typename = void>
+  struct HasSize : std::false_type
+  {
+  };
+  template <typename T>
+  struct HasSize<T, std::void_t<decltype(std::declval<const T&>().size())>>
+    : std::true_type
+  {
+  };
+}  // namespace detail
 
 /// A container to store arbitrary objects with ownership transfer.
 ///
@@ -26,11 +41,23 @@ namespace FW {
 /// added to it. Once an object has been added, it can only be read but not
 /// be modified. Trying to replace an existing object is considered an error.
 /// Its lifetime is bound to the liftime of the white board.
+///
+/// To avoid copies of whole collections, an object can be made available
+/// under an additional name without copying it and the last user of an
+/// object can consume it, i.e. take back ownership. A consumed object can not
+/// be accessed anymore and any later access is considered an error. Stages
+/// that declare their inputs are checked against consumed objects by the
+/// sequencer before the event loop; all other accesses are only checked at
+/// runtime.
+///
+/// If capacity hints are provided, the size of every added collection is
+/// recorded to improve memory reservations in subsequent events.
 class WhiteBoard
 {
 public:
   WhiteBoard(std::unique_ptr<const Acts::Logger> logger
-             = Acts::getDefaultLogger("WhiteBoard", Acts::Logging::INFO));
+             = Acts::getDefaultLogger("WhiteBoard", Acts::Logging::INFO),
+             CapacityHints* capacityHints = nullptr);
 
   // A WhiteBoard holds unique elements and can not be copied
   WhiteBoard(const WhiteBoard& other) = delete;
@@ -56,6 +83,33 @@ public:
   const T&
   get(const std::string& name) const;
 
+  /// Make an existing object available under an additional name.
+  ///
+  /// @param name Identifier of the existing object
+  /// @param aliasName Non-empty additional identifier for the same object
+  /// @throws std::out_of_range if no object is stored under the name
+  /// @throws std::invalid_argument on empty or existing alias
+  ///
+  /// The object is not copied; both names refer to the same object. The
+  /// alias can reuse the name of a consumed object. This allows a stage to
+  /// consume a collection, modify it, and forward it under its new and its
+  /// original name.
+  void
+  alias(const std::string& name, const std::string& aliasName);
+
+  /// Consume a stored object and take back its ownership.
+  ///
+  /// @param[in] name Identifier for the object
+  /// @return the stored object
+  /// @throws std::out_of_range if no object is stored under the requested name
+  /// @throws std::invalid_argument if the object is also stored under an alias
+  ///
+  /// After an object is consumed, it can not be accessed anymore. Any later
+  /// read access under the same name fails and the name can not be reused.
+  template <typename T>
+  T
+  pop(const std::string& name);
+
 private:
   // type-erased value holder for move-constructible types
   struct IHolder
@@ -79,8 +133,15 @@ private:
     }
   };
 
+  // holders are shared to allow storing the same object under multiple names
   std::unique_ptr<const Acts::Logger>                       m_logger;
-  std::unordered_map<std::string, std::unique_ptr<IHolder>> m_store;
+  std::unordered_map<std::string, std::shared_ptr<IHolder>> m_store;
+  std::unordered_set<std::string>                           m_consumed;
+  CapacityHints*                                            m_capacityHints;
+
+  /// Find the holder for an object or throw an informative error.
+  const std::shared_ptr<IHolder>&
+  find(const std::string& name) const;
 
   const Acts::Logger&
   logger() const
@@ -91,8 +152,9 @@ private:
 
 }  // namespace FW
 
-inline FW::WhiteBoard::WhiteBoard(std::unique_ptr<const Acts::Logger> logger)
-  : m_logger(std::move(logger))
+inline FW::WhiteBoard::WhiteBoard(std::unique_ptr<const Acts::Logger> logger,
+                                  CapacityHints* capacityHints)
+  : m_logger(std::move(logger)), m_capacityHints(capacityHints)
 {
 }
 
@@ -103,25 +165,75 @@ FW::WhiteBoard::add(const std::string& name, T&& object)
   if (name.empty()) {
     throw std::invalid_argument("Object can not have an empty name");
   }
-  if (0 < m_store.count(name)) {
+  if ((0 < m_store.count(name)) or (0 < m_consumed.count(name))) {
     throw std::invalid_argument("Object '" + name + "' already exists");
   }
-  m_store.emplace(name, std::make_unique<HolderT<T>>(std::forward<T>(object)));
+  if constexpr (detail::HasSize<std::decay_t<T>>::value) {
+    if (m_capacityHints) { m_capacityHints->record(name, object.size()); }
+  }
+  m_store.emplace(name, std::make_shared<HolderT<T>>(std::forward<T>(object)));
   ACTS_VERBOSE("Added object '" << name << "'");
 }
 
-template <typename T>
-inline const T&
-FW::WhiteBoard::get(const std::string& name) const
+inline const std::shared_ptr<FW::WhiteBoard::IHolder>&
+FW::WhiteBoard::find(const std::string& name) const
 {
   auto it = m_store.find(name);
   if (it == m_store.end()) {
+    if (0 < m_consumed.count(name)) {
+      throw std::out_of_range("Object '" + name
+                              + "' was already consumed by a previous stage");
+    }
     throw std::out_of_range("Object '" + name + "' does not exists");
   }
-  const IHolder* holder = it->second.get();
+  return it->second;
+}
+
+template <typename T>
+inline const T&
+FW::WhiteBoard::get(const std::string& name) const
+{
+  const IHolder* holder = find(name).get();
   if (typeid(T) != holder->type()) {
     throw std::out_of_range("Type missmatch for object '" + name + "'");
   }
   ACTS_VERBOSE("Retrieved object '" << name << "'");
   return reinterpret_cast<const HolderT<T>*>(holder)->value;
 }
+
+inline void
+FW::WhiteBoard::alias(const std::string& name, const std::string& aliasName)
+{
+  if (aliasName.empty()) {
+    throw std::invalid_argument("Object can not have an empty alias");
+  }
+  if (0 < m_store.count(aliasName)) {
+    throw std::invalid_argument("Object '" + aliasName + "' already exists");
+  }
+  // copy the holder pointer before inserting to not invalidate the reference
+  std::shared_ptr<IHolder> holder = find(name);
+  m_store.emplace(aliasName, std::move(holder));
+  m_consumed.erase(aliasName);
+  ACTS_VERBOSE("Added alias '" << aliasName << "' for object '" << name
+                               << "'");
+}
+
+template <typename T>
+inline T
+FW::WhiteBoard::pop(const std::string& name)
+{
+  const auto& holder = find(name);
+  if (typeid(T) != holder->type()) {
+    throw std::out_of_range("Type missmatch for object '" + name + "'");
+  }
+  // other names would silently refer to a moved-from object otherwise
+  if (1 < holder.use_count()) {
+    throw std::invalid_argument("Object '" + name
+                                + "' is aliased and can not be consumed");
+  }
+  T object = std::move(reinterpret_cast<HolderT<T>*>(holder.get())->value);
+  m_store.erase(name);
+  m_consumed.insert(name);
+  ACTS_VERBOSE("Consumed object '" << name << "'");
+  return object;
+}
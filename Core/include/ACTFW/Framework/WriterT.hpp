@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <Acts/Utilities/Logger.hpp>
 
@@ -60,6 +61,10 @@ public:
   ProcessCode
   endRun() override;
 
+  /// The object read from the event store.
+  std::vector<std::string>
+  inputCollections() const final override;
+
 protected:
   /// Type-specific write function implementation
   /// this method is implemented in the user implementation
@@ -113,6 +118,13 @@ FW::WriterT<write_data_t>::endRun()
   return ProcessCode::SUCCESS;
 }
 
+template <typename write_data_t>
+inline std::vector<std::string>
+FW::WriterT<write_data_t>::inputCollections() const
+{
+  return {m_objectName};
+}
+
 template <typename write_data_t>
 inline FW::ProcessCode
 FW::WriterT<write_data_t>::write(const AlgorithmContext& context)
@@ -0,0 +1,86 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include "Acts/Utilities/Definitions.hpp"
+
+namespace FW {
+
+/// Transform a batch of global positions into a local planar frame.
+///
+/// @param toLocal is the global-to-local transform, i.e. the inverse of the
+///                surface transform
+/// @param global  positions in the global frame
+/// @param local   local positions output; resized to the input size
+///
+/// All positions are transformed in a single matrix product that Eigen can
+/// vectorize. The arithmetic is identical to the per-position transform used
+/// by `PlaneSurface::globalToLocal`. This is only valid for planar surfaces
+/// where the local coordinates are the first two frame coordinates.
+inline void
+transformToLocal(const Acts::Transform3D&           toLocal,
+                 const std::vector<Acts::Vector3D>& global,
+                 std::vector<Acts::Vector2D>&       local)
+{
+  using Global = Eigen::Matrix<double, 3, Eigen::Dynamic>;
+  using Local  = Eigen::Matrix<double, 2, Eigen::Dynamic>;
+
+  local.resize(global.size());
+  if (global.empty()) { return; }
+  Eigen::Map<const Global> in(global.front().data(), 3, global.size());
+  Eigen::Map<Local>        out(local.front().data(), 2, local.size());
+  out.noalias() = toLocal.linear().topRows<2>() * in;
+  out.colwise() += toLocal.translation().head<2>();
+}
+
+/// Rotate a batch of global directions into a local frame.
+///
+/// @param toLocal is the global-to-local transform
+/// @param global  directions in the global frame
+/// @param local   local directions output; resized to the input size
+inline void
+rotateToLocal(const Acts::Transform3D&           toLocal,
+              const std::vector<Acts::Vector3D>& global,
+              std::vector<Acts::Vector3D>&       local)
+{
+  using Directions = Eigen::Matrix<double, 3, Eigen::Dynamic>;
+
+  local.resize(global.size());
+  if (global.empty()) { return; }
+  Eigen::Map<const Directions> in(global.front().data(), 3, global.size());
+  Eigen::Map<Directions>       out(local.front().data(), 3, local.size());
+  out.noalias() = toLocal.linear() * in;
+}
+
+/// Transform a batch of local planar positions into the global frame.
+///
+/// @param toGlobal is the local-to-global transform, i.e. the surface transform
+/// @param local    local positions on the surface
+/// @param global   global positions output; resized to the input size
+inline void
+transformToGlobal(const Acts::Transform3D&           toGlobal,
+                  const std::vector<Acts::Vector2D>& local,
+                  std::vector<Acts::Vector3D>&       global)
+{
+  using Local  = Eigen::Matrix<double, 2, Eigen::Dynamic>;
+  using Global = Eigen::Matrix<double, 3, Eigen::Dynamic>;
+
+  global.resize(local.size());
+  if (local.empty()) { return; }
+  Eigen::Map<const Local> in(local.front().data(), 2, local.size());
+  Eigen::Map<Global>      out(global.front().data(), 3, global.size());
+  out.noalias() = toGlobal.linear().leftCols<2>() * in;
+  out.colwise() += toGlobal.translation();
+}
+
+}  // namespace FW
@@ -0,0 +1,129 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Acts/Geometry/GeometryID.hpp"
+
+namespace FW {
+
+/// Store values for geometry hierarchy levels with fallback lookup.
+///
+/// @tparam value_t stored value type
+///
+/// Each value is stored for a geometry identifier that defines a level in the
+/// geometry hierarchy: a module if the sensitive id is set, a layer if only
+/// the volume and layer ids are set, a volume if only the volume id is set,
+/// or the global default for the zero identifier. The lookup for a module
+/// returns the most specific value available, i.e. it checks the module, its
+/// layer, its volume, and the global default in this order.
+///
+/// The lookup requires a binary search for each level and is intended to be
+/// used during initialization to compile per-module lookup tables and not
+/// for per-hit lookups.
+template <typename value_t>
+class GeometryHierarchyMap
+{
+public:
+  using Value        = value_t;
+  using InputElement = std::pair<Acts::GeometryID, Value>;
+
+  /// Construct an empty map without any values.
+  GeometryHierarchyMap() = default;
+  /// Construct the map from a list of identifier-value pairs.
+  ///
+  /// @throws std::invalid_argument on duplicate identifiers
+  GeometryHierarchyMap(std::vector<InputElement> elements);
+
+  /// Find the most specific value for the given geometry identifier.
+  ///
+  /// @return pointer to the value or nullptr if no value is defined
+  const Value*
+  find(Acts::GeometryID id) const;
+
+  /// Number of stored values.
+  std::size_t
+  size() const
+  {
+    return m_ids.size();
+  }
+  bool
+  empty() const
+  {
+    return m_ids.empty();
+  }
+
+private:
+  // identifiers and values are stored separately, sorted by identifier
+  std::vector<Acts::GeometryID::Value> m_ids;
+  std::vector<Value>                   m_values;
+
+  const Value*
+  findExact(Acts::GeometryID id) const;
+};
+
+}  // namespace FW
+
+template <typename value_t>
+inline FW::GeometryHierarchyMap<value_t>::GeometryHierarchyMap(
+    std::vector<InputElement> elements)
+{
+  std::sort(elements.begin(), elements.end(), [](const auto& a, const auto& b) {
+    return a.first.value() < b.first.value();
+  });
+  auto duplicate = std::adjacent_find(
+      elements.begin(), elements.end(), [](const auto& a, const auto& b) {
+        return a.first.value() == b.first.value();
+      });
+  if (duplicate != elements.end()) {
+    throw std::invalid_argument("Duplicate geometry identifier in hierarchy");
+  }
+  m_ids.reserve(elements.size());
+  m_values.reserve(elements.size());
+  for (auto& element : elements) {
+    m_ids.push_back(element.first.value());
+    m_values.push_back(std::move(element.second));
+  }
+}
+
+template <typename value_t>
+inline const value_t*
+FW::GeometryHierarchyMap<value_t>::findExact(Acts::GeometryID id) const
+{
+  auto it = std::lower_bound(m_ids.begin(), m_ids.end(), id.value());
+  if ((it == m_ids.end()) or (*it != id.value())) { return nullptr; }
+  return &m_values[std::distance(m_ids.begin(), it)];
+}
+
+template <typename value_t>
+inline const value_t*
+FW::GeometryHierarchyMap<value_t>::find(Acts::GeometryID id) const
+{
+  // check from the most specific to the most generic hierarchy level
+  const Acts::GeometryID candidates[] = {
+      Acts::GeometryID()
+          .setVolume(id.volume())
+          .setLayer(id.layer())
+          .setSensitive(id.sensitive()),
+      Acts::GeometryID().setVolume(id.volume()).setLayer(id.layer()),
+      Acts::GeometryID().setVolume(id.volume()),
+      Acts::GeometryID(),
+  };
+  for (auto candidate : candidates) {
+    const Value* value = findExact(candidate);
+    if (value) { return value; }
+  }
+  return nullptr;
+}
@@ -0,0 +1,99 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cmath>
+
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+
+namespace FW {
+
+/// Extrapolate a track analytically to the perigee of a reference position.
+///
+/// @param position    start position
+/// @param momentum    start momentum
+/// @param charge      particle charge
+/// @param time        start time
+/// @param mass        particle mass, only used for the time extrapolation
+/// @param bFieldInZ   homogeneous magnetic field along the z axis
+/// @param reference   perigee reference position
+/// @return bound parameters on the perigee surface at the reference position
+///
+/// The track is a helix with its axis along z or a straight line for neutral
+/// particles or a vanishing field. The perigee is the point of closest
+/// approach in the transverse plane; if the circle passes the reference
+/// twice the one closer along the track to the start position is used. The
+/// parameters follow the perigee surface conventions, i.e. the transverse
+/// impact parameter is signed with respect to the momentum direction. The
+/// transverse momentum must be non-zero; callers must skip such particles.
+inline Acts::BoundVector
+extrapolateHelixToPerigee(const Acts::Vector3D& position,
+                          const Acts::Vector3D& momentum,
+                          double                charge,
+                          double                time,
+                          double                mass,
+                          double                bFieldInZ,
+                          const Acts::Vector3D& reference)
+{
+  const double pT    = std::hypot(momentum.x(), momentum.y());
+  const double p     = std::hypot(pT, momentum.z());
+  const double phi0  = std::atan2(momentum.y(), momentum.x());
+  const double theta = std::atan2(pT, momentum.z());
+  // signed curvature of the transverse projection, i.e. dphi/ds
+  const double rho = ((charge != 0) and (0 < pT)) ? (-charge * bFieldInZ / pT)
+                                                  : 0.0;
+  // start position relative to the reference
+  const double dx = position.x() - reference.x();
+  const double dy = position.y() - reference.y();
+
+  // transverse position and direction at the perigee and the signed
+  // transverse path length from the start position
+  double pcaX, pcaY, phi, ds;
+  if (rho == 0) {
+    ds   = -(dx * std::cos(phi0) + dy * std::sin(phi0));
+    pcaX = dx + ds * std::cos(phi0);
+    pcaY = dy + ds * std::sin(phi0);
+    phi  = phi0;
+  } else {
+    const double radius = 1 / std::abs(rho);
+    const double sign   = (0 < rho) ? 1.0 : -1.0;
+    // circle center relative to the reference
+    const double centerX  = dx - std::sin(phi0) / rho;
+    const double centerY  = dy + std::cos(phi0) / rho;
+    const double distance = std::hypot(centerX, centerY);
+    // unit vector from the center towards the perigee. if the reference is
+    // at the center every point is a perigee and the start is used.
+    const double ux = (0 < distance) ? (-centerX / distance)
+                                     : ((dx - centerX) / radius);
+    const double uy = (0 < distance) ? (-centerY / distance)
+                                     : ((dy - centerY) / radius);
+    pcaX = centerX + radius * ux;
+    pcaY = centerY + radius * uy;
+    // the position relative to the center is (sin(phi), -cos(phi)) / rho
+    phi = std::atan2(sign * ux, -sign * uy);
+    // use the perigee closest to the start position along the track
+    const double dphi = std::remainder(phi - phi0, 2 * M_PI);
+    ds                = dphi / rho;
+  }
+  const double path = ds * p / pT;
+
+  Acts::BoundVector params = Acts::BoundVector::Zero();
+  params[Acts::eLOC_0]     = pcaY * std::cos(phi) - pcaX * std::sin(phi);
+  params[Acts::eLOC_1]
+      = position.z() + ds * momentum.z() / pT - reference.z();
+  params[Acts::ePHI]   = phi;
+  params[Acts::eTHETA] = theta;
+  params[Acts::eQOP]   = (charge != 0) ? (charge / p) : (1 / p);
+  // the velocity is p/E in native units
+  params[Acts::eT] = time + path * std::hypot(p, mass) / p;
+  return params;
+}
+
+}  // namespace FW
@@ -0,0 +1,170 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <tbb/parallel_for.h>
+
+namespace FW {
+namespace detail {
+  // radix sort with 8bit digits on 64bit keys
+  constexpr unsigned    kRadixBits   = 8u;
+  constexpr std::size_t kRadixSize   = 1u << kRadixBits;
+  constexpr unsigned    kRadixPasses = 64u / kRadixBits;
+
+  struct RadixItem
+  {
+    uint64_t    key;
+    std::size_t index;
+  };
+  using RadixCounts = std::array<std::size_t, kRadixSize>;
+
+  constexpr std::size_t
+  radixDigit(uint64_t key, unsigned pass)
+  {
+    return (key >> (pass * kRadixBits)) & (kRadixSize - 1u);
+  }
+
+  /// Stable LSD radix sort of key-index items using a single thread.
+  ///
+  /// Passes where all keys share the same digit are skipped. This is the
+  /// common case for structured keys, e.g. geometry identifiers, where large
+  /// parts of the bits are unused.
+  inline void
+  radixSortItems(std::vector<RadixItem>& items)
+  {
+    // compute the digit histograms for all passes in a single sweep
+    std::array<RadixCounts, kRadixPasses> counts = {};
+    for (const auto& item : items) {
+      for (unsigned pass = 0; pass < kRadixPasses; ++pass) {
+        counts[pass][radixDigit(item.key, pass)] += 1;
+      }
+    }
+
+    std::vector<RadixItem> buffer(items.size());
+    for (unsigned pass = 0; pass < kRadixPasses; ++pass) {
+      auto& offsets = counts[pass];
+      if (offsets[radixDigit(items.front().key, pass)] == items.size()) {
+        continue;
+      }
+      // convert counts into output offsets
+      std::size_t sum = 0u;
+      for (auto& offset : offsets) { sum += std::exchange(offset, sum); }
+      for (const auto& item : items) {
+        buffer[offsets[radixDigit(item.key, pass)]++] = item;
+      }
+      std::swap(items, buffer);
+    }
+  }
+
+  /// Stable LSD radix sort of key-index items using multiple threads.
+  ///
+  /// The items are split into a fixed number of contiguous chunks. Each pass
+  /// computes per-chunk histograms and scatters each chunk independently into
+  /// its precomputed output locations. The result is identical to the
+  /// single-threaded version.
+  inline void
+  radixSortItemsParallel(std::vector<RadixItem>& items, std::size_t grainSize)
+  {
+    const std::size_t n         = items.size();
+    const std::size_t numChunks = (n + grainSize - 1) / grainSize;
+    auto              chunkBeg  = [=](std::size_t c) { return c * grainSize; };
+    auto              chunkEnd  = [=](std::size_t c) {
+      return std::min(n, (c + 1) * grainSize);
+    };
+
+    std::vector<RadixItem>   buffer(n);
+    std::vector<RadixCounts> counts(numChunks);
+    for (unsigned pass = 0; pass < kRadixPasses; ++pass) {
+      // per-chunk histograms
+      tbb::parallel_for(std::size_t(0), numChunks, [&](std::size_t c) {
+        counts[c].fill(0u);
+        for (auto i = chunkBeg(c); i < chunkEnd(c); ++i) {
+          counts[c][radixDigit(items[i].key, pass)] += 1;
+        }
+      });
+      // skip pass if all items share the same digit
+      const auto  digit0 = radixDigit(items.front().key, pass);
+      std::size_t total0 = 0u;
+      for (const auto& chunkCounts : counts) { total0 += chunkCounts[digit0]; }
+      if (total0 == n) { continue; }
+      // convert counts into per-chunk output offsets, digit-major
+      std::size_t sum = 0u;
+      for (std::size_t d = 0; d < kRadixSize; ++d) {
+        for (auto& chunkCounts : counts) {
+          sum += std::exchange(chunkCounts[d], sum);
+        }
+      }
+      // scatter each chunk into its own output slots
+      tbb::parallel_for(std::size_t(0), numChunks, [&](std::size_t c) {
+        auto& offsets = counts[c];
+        for (auto i = chunkBeg(c); i < chunkEnd(c); ++i) {
+          buffer[offsets[radixDigit(items[i].key, pass)]++] = items[i];
+        }
+      });
+      std::swap(items, buffer);
+    }
+  }
+}  // namespace detail
+
+/// Default minimum number of elements per task for the parallel radix sort.
+constexpr std::size_t kRadixSortGrainSize = 1u << 16;
+
+/// Sort a sequence by an unsigned 64bit key using a stable LSD radix sort.
+///
+/// @param elements random-access sequence with `size()`, `reserve()`,
+///                 `push_back()`, and swap support, e.g. `std::vector`
+/// @param getKey   callable that returns the integer key for an element
+/// @param parallel use multiple threads for the sorting passes
+/// @param grainSize minimum number of elements per parallel task
+///
+/// Sorting is done on compact key-index pairs and the elements are moved
+/// only once into their final position. The relative order of elements with
+/// equal keys is preserved.
+template <typename Sequence, typename KeyGetter>
+inline void
+radixSort(Sequence&   elements,
+          KeyGetter&& getKey,
+          bool        parallel  = false,
+          std::size_t grainSize = kRadixSortGrainSize)
+{
+  if (elements.size() < 2u) { return; }
+
+  std::vector<detail::RadixItem> items;
+  items.reserve(elements.size());
+  bool isSorted = true;
+  for (std::size_t i = 0; i < elements.size(); ++i) {
+    items.push_back({static_cast<uint64_t>(getKey(elements[i])), i});
+    isSorted = isSorted and ((i == 0) or (items[i - 1].key <= items[i].key));
+  }
+  // input is often (partially) ordered already. nothing to do in that case.
+  if (isSorted) { return; }
+
+  if (parallel and (grainSize < items.size())) {
+    detail::radixSortItemsParallel(items, grainSize);
+  } else {
+    detail::radixSortItems(items);
+  }
+
+  // apply the permutation
+  Sequence sorted;
+  sorted.reserve(elements.size());
+  for (const auto& item : items) {
+    sorted.push_back(std::move(elements[item.index]));
+  }
+  std::swap(elements, sorted);
+}
+
+}  // namespace FW
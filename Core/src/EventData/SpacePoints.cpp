@@ -0,0 +1,93 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/EventData/SpacePoints.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#include "ACTFW/Utilities/RadixSort.hpp"
+
+std::size_t
+FW::SpacePointBinning::phiBin(double phi) const
+{
+  const double pos = (phi + M_PI) / (2 * M_PI);
+  const auto   bin = static_cast<std::ptrdiff_t>(pos * numPhiBins);
+  return std::clamp<std::ptrdiff_t>(bin, 0, numPhiBins - 1);
+}
+
+std::size_t
+FW::SpacePointBinning::zBin(double z) const
+{
+  const double pos = (z - zMin) / (zMax - zMin);
+  const auto   bin = static_cast<std::ptrdiff_t>(std::floor(pos * numZBins));
+  return std::clamp<std::ptrdiff_t>(bin, 0, numZBins - 1);
+}
+
+FW::SpacePointContainer::SpacePointContainer(
+    const SpacePointBinning&       binning,
+    const std::vector<SpacePoint>& spacePoints)
+  : m_binning(binning)
+{
+  if ((m_binning.numPhiBins == 0u) or (m_binning.numZBins == 0u)) {
+    throw std::invalid_argument("Space point binning must not be empty");
+  }
+  if (not(m_binning.zMin < m_binning.zMax)) {
+    throw std::invalid_argument("Invalid space point z range");
+  }
+
+  // compute the derived quantities once and sort by bin and radius. the radius
+  // is non-negative, i.e. its bit pattern has the same ordering as its value.
+  const auto               n = spacePoints.size();
+  std::vector<float>       r(n);
+  std::vector<float>       phi(n);
+  std::vector<std::size_t> bins(n);
+  std::vector<std::size_t> order(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto& sp = spacePoints[i];
+    const auto  iz = m_binning.zBin(sp.z);
+    r[i]           = std::hypot(sp.x, sp.y);
+    phi[i]         = std::atan2(sp.y, sp.x);
+    bins[i]        = m_binning.bin(m_binning.phiBin(phi[i]), iz);
+  }
+  std::iota(order.begin(), order.end(), 0u);
+  radixSort(order, [&](std::size_t i) {
+    uint32_t rBits = 0u;
+    std::memcpy(&rBits, &r[i], sizeof(rBits));
+    return (static_cast<uint64_t>(bins[i]) << 32) | rBits;
+  });
+
+  // fill the per-property arrays in sorted order
+  m_x.reserve(n);
+  m_y.reserve(n);
+  m_z.reserve(n);
+  m_r.reserve(n);
+  m_phi.reserve(n);
+  m_varianceR.reserve(n);
+  m_varianceZ.reserve(n);
+  m_measurementIndex.reserve(n);
+  m_binOffsets.assign(m_binning.size() + 1, 0u);
+  for (auto i : order) {
+    const auto& sp = spacePoints[i];
+    m_x.push_back(sp.x);
+    m_y.push_back(sp.y);
+    m_z.push_back(sp.z);
+    m_r.push_back(r[i]);
+    m_phi.push_back(phi[i]);
+    m_varianceR.push_back(sp.varianceR);
+    m_varianceZ.push_back(sp.varianceZ);
+    m_measurementIndex.push_back(sp.measurementIndex);
+    m_binOffsets[bins[i] + 1] += 1;
+  }
+  // convert bin counts into offsets
+  std::partial_sum(
+      m_binOffsets.begin(), m_binOffsets.end(), m_binOffsets.begin());
+}
@@ -0,0 +1,118 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Framework/CapacityHints.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+/// Number of reallocations of a vector that doubles its capacity on growth.
+std::size_t
+countReallocations(std::size_t capacity, std::size_t size)
+{
+  std::size_t count = 0u;
+  while (capacity < size) {
+    capacity = std::max<std::size_t>(2u * capacity, 1u);
+    ++count;
+  }
+  return count;
+}
+}  // namespace
+
+FW::CapacityHints::CapacityHints(const FW::CapacityHints::Config& cfg)
+  : m_cfg(cfg)
+{
+  if (m_cfg.window == 0u) {
+    throw std::invalid_argument("Capacity hints window must not be empty");
+  }
+  if (not(0.0 <= m_cfg.percentile and m_cfg.percentile <= 1.0)) {
+    throw std::invalid_argument("Capacity hints percentile must be in [0,1]");
+  }
+  if (m_cfg.updateInterval == 0u) {
+    throw std::invalid_argument("Capacity hints update interval must be > 0");
+  }
+}
+
+FW::CapacityHints::Entry&
+FW::CapacityHints::entry(const std::string& collection) const
+{
+  {
+    std::shared_lock<std::shared_mutex> lock(m_entriesMutex);
+    auto it = m_entries.find(collection);
+    if (it != m_entries.end()) { return it->second; }
+  }
+  // the entry might have been created in between; try_emplace handles it
+  std::unique_lock<std::shared_mutex> lock(m_entriesMutex);
+  return m_entries.try_emplace(collection).first->second;
+}
+
+void
+FW::CapacityHints::record(const std::string& collection, std::size_t size)
+{
+  Entry&                      e = entry(collection);
+  std::lock_guard<std::mutex> lock(e.mutex);
+
+  // the statistics use the reservation that was available during the event
+  const std::size_t fallback = e.fallback.load();
+  const std::size_t reserved = e.hasHint.load() ? e.hint.load() : fallback;
+  auto&             stats    = e.statistics;
+  stats.events += 1u;
+  stats.exceeded += (reserved < size) ? 1u : 0u;
+  stats.reallocations += countReallocations(reserved, size);
+  stats.reallocationsWithFallback += countReallocations(fallback, size);
+
+  if (e.sizes.size() < m_cfg.window) {
+    e.sizes.push_back(size);
+  } else {
+    e.sizes[e.next] = size;
+  }
+  e.next = (e.next + 1) % m_cfg.window;
+
+  // the percentile is only recomputed every few events
+  if ((e.sinceHint++ % m_cfg.updateInterval) != 0u) { return; }
+  e.sorted.assign(e.sizes.begin(), e.sizes.end());
+  std::size_t pos = static_cast<std::size_t>(
+      m_cfg.percentile * (e.sorted.size() - 1) + 0.5);
+  auto nth = std::next(e.sorted.begin(), pos);
+  std::nth_element(e.sorted.begin(), nth, e.sorted.end());
+  e.hint.store(*nth);
+  e.hasHint.store(true);
+}
+
+std::size_t
+FW::CapacityHints::hint(const std::string& collection,
+                        std::size_t        fallback) const
+{
+  Entry& e = entry(collection);
+  e.fallback.store(fallback);
+  e.queried.store(true);
+  return e.hasHint.load() ? e.hint.load() : fallback;
+}
+
+std::vector<FW::CapacityHints::Statistics>
+FW::CapacityHints::statistics() const
+{
+  std::shared_lock<std::shared_mutex> entriesLock(m_entriesMutex);
+
+  std::vector<Statistics> statistics;
+  for (auto& [collection, e] : m_entries) {
+    if (not e.queried.load()) { continue; }
+    std::lock_guard<std::mutex> lock(e.mutex);
+    if (e.statistics.events == 0u) { continue; }
+    statistics.push_back(e.statistics);
+    statistics.back().collection = collection;
+  }
+  std::sort(statistics.begin(),
+            statistics.end(),
+            [](const Statistics& lhs, const Statistics& rhs) {
+              return lhs.collection < rhs.collection;
+            });
+  return statistics;
+}
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <chrono>
 #include <exception>
+#include <iterator>
 #include <numeric>
 
 #include <TROOT.h>
@@ -23,7 +24,9 @@
 #include "ACTFW/Utilities/Paths.hpp"
 
 FW::Sequencer::Sequencer(const Sequencer::Config& cfg)
-  : m_cfg(cfg), m_logger(Acts::getDefaultLogger("Sequencer", m_cfg.logLevel))
+  : m_cfg(cfg)
+  , m_capacityHints(std::make_unique<CapacityHints>(m_cfg.capacityHints))
+  , m_logger(Acts::getDefaultLogger("Sequencer", m_cfg.logLevel))
 {
   // automatically determine the number of concurrent threads to use
   if (m_cfg.numThreads < 0) {
@@ -247,6 +250,39 @@ storeTiming(const std::vector<std::string>& identifiers,
 }
 }  // namespace
 
+bool
+FW::Sequencer::checkConsumedCollections() const
+{
+  bool valid = true;
+  auto check = [&](const std::string&              consumer,
+                   const std::string&              collection,
+                   const std::string&              reader,
+                   const std::vector<std::string>& inputs) {
+    if (std::find(inputs.begin(), inputs.end(), collection) != inputs.end()) {
+      ACTS_ERROR("Collection '" << collection << "' consumed by '" << consumer
+                                << "' is read later by '" << reader << "'");
+      valid = false;
+    }
+  };
+  for (auto it = m_algorithms.begin(); it != m_algorithms.end(); ++it) {
+    for (const auto& collection : (*it)->consumedCollections()) {
+      for (auto later = std::next(it); later != m_algorithms.end(); ++later) {
+        check((*it)->name(),
+              collection,
+              (*later)->name(),
+              (*later)->inputCollections());
+      }
+      for (const auto& writer : m_writers) {
+        check((*it)->name(),
+              collection,
+              writer->name(),
+              writer->inputCollections());
+      }
+    }
+  }
+  return valid;
+}
+
 int
 FW::Sequencer::run()
 {
@@ -263,6 +299,8 @@ FW::Sequencer::run()
   if ((eventsRange.first == SIZE_MAX) and (eventsRange.second == SIZE_MAX)) {
     return EXIT_FAILURE;
   }
+  // consumed collections are not available to subsequent stages
+  if (not checkConsumedCollections()) { return EXIT_FAILURE; }
 
   ACTS_INFO("Processing events [" << eventsRange.first << ", "
                                   << eventsRange.second << ")");
@@ -291,11 +329,14 @@ FW::Sequencer::run()
 
         for (size_t event = r.begin(); event != r.end(); ++event) {
           // Use per-event store
-          WhiteBoard eventStore(Acts::getDefaultLogger(
-              "EventStore#" + std::to_string(event), m_cfg.logLevel));
+          WhiteBoard eventStore(
+              Acts::getDefaultLogger("EventStore#" + std::to_string(event),
+                                     m_cfg.logLevel),
+              m_capacityHints.get());
           // If we ever wanted to run algorithms in parallel, this needs to be
           // changed to Algorithm context copies
           AlgorithmContext context(0, event, eventStore);
+          context.capacityHints = m_capacityHints.get();
           size_t           ialgo = 0;
 
           // Prepare event store w/ service information
@@ -369,5 +410,14 @@ FW::Sequencer::run()
               numEvents,
               joinPaths(m_cfg.outputDir, "timing.tsv"));
 
+  // summarize the effect of the capacity hints
+  ACTS_DEBUG("Estimated reallocations with capacity hints/static fallback:");
+  for (const auto& stats : m_capacityHints->statistics()) {
+    ACTS_DEBUG("  " << stats.collection << ": " << stats.reallocations << "/"
+                    << stats.reallocationsWithFallback << " in "
+                    << stats.events << " events, hint exceeded in "
+                    << stats.exceeded << " events");
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,193 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/TrackFinding/AmbiguityResolutionAlgorithm.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Utilities/Logger.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Track candidates with duplicates that share some of their hits.
+///
+/// Each original track has its own hits. A duplicate copies a random subset
+/// of the hits of a random original track and completes it with its own
+/// hits; all candidates have the same number of hits. The candidates are
+/// shuffled, i.e. duplicates are not adjacent to their originals.
+FW::ProtoTrackContainer
+makeTracks(size_t            numTracks,
+           size_t            hitsPerTrack,
+           double            duplicateFraction,
+           size_t            sharedHits,
+           FW::RandomEngine& rng)
+{
+  const auto numOriginals
+      = std::max<size_t>(1u, size_t((1 - duplicateFraction) * numTracks));
+
+  FW::ProtoTrackContainer tracks;
+  tracks.reserve(numTracks);
+  size_t nextHit = 0;
+  for (size_t itrack = 0; itrack < numTracks; ++itrack) {
+    FW::ProtoTrack track;
+    if (numOriginals <= itrack) {
+      std::uniform_int_distribution<size_t> originalDist(0, numOriginals - 1);
+      track = tracks[originalDist(rng)];
+      std::shuffle(track.begin(), track.end(), rng);
+      track.resize(sharedHits);
+    }
+    while (track.size() < hitsPerTrack) { track.push_back(nextHit++); }
+    tracks.push_back(std::move(track));
+  }
+  std::shuffle(tracks.begin(), tracks.end(), rng);
+  return tracks;
+}
+
+/// Check that no surviving track shares more than the allowed hit fraction.
+bool
+isResolved(const FW::ProtoTrackContainer& tracks, double maxSharedFraction)
+{
+  size_t numHits = 0;
+  for (const auto& track : tracks) {
+    for (auto hit : track) { numHits = std::max(numHits, hit + 1); }
+  }
+  std::vector<size_t> occupancy(numHits, 0u);
+  for (const auto& track : tracks) {
+    for (auto hit : track) { occupancy[hit] += 1u; }
+  }
+  for (const auto& track : tracks) {
+    size_t nShared = 0;
+    for (auto hit : track) { nShared += (1u < occupancy[hit]) ? 1u : 0u; }
+    if (maxSharedFraction < double(nShared) / track.size()) { return false; }
+  }
+  return true;
+}
+
+}  // namespace
+
+/// Ambiguity resolution benchmark executable
+///
+/// Synthetic track candidates with a given fraction of duplicates, which
+/// share some of their hits with an original track, are resolved for each
+/// requested track multiplicity. The proto track input is used since it needs
+/// no fitted trajectories; the resolution itself is identical for both input
+/// types. Only the execution of the algorithm is timed; the candidate
+/// creation and the event store setup are not part of the measurement. The
+/// surviving tracks are checked against the maximum shared fraction.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-tracks",
+      value<read_series>()->multitoken()->default_value(
+          {1000, 10000, 100000}),
+      "Number of track candidates per event")(
+      "bench-events",
+      value<size_t>()->default_value(10),
+      "Number of resolved events per track multiplicity")(
+      "bench-hits-per-track",
+      value<size_t>()->default_value(10),
+      "Number of hits per track candidate")(
+      "bench-duplicate-fraction",
+      value<double>()->default_value(0.5),
+      "Fraction of the candidates that are duplicates")(
+      "bench-shared-hits",
+      value<size_t>()->default_value(5),
+      "Number of hits a duplicate shares with its original track")(
+      "bench-max-shared-fraction",
+      value<double>()->default_value(0.0),
+      "Maximum fraction of shared hits for a surviving track");
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto sizes      = vm["bench-tracks"].as<read_series>();
+  auto nEvents    = vm["bench-events"].as<size_t>();
+  auto perTrack   = vm["bench-hits-per-track"].as<size_t>();
+  auto duplicates = vm["bench-duplicate-fraction"].as<double>();
+  auto sharedHits = vm["bench-shared-hits"].as<size_t>();
+  auto maxShared  = vm["bench-max-shared-fraction"].as<double>();
+  auto logLevel   = FW::Options::readLogLevel(vm);
+  auto rndConfig  = FW::Options::readRandomNumbersConfig(vm);
+  if ((nEvents == 0) or (perTrack == 0) or (perTrack < sharedHits)
+      or not(0 <= duplicates and duplicates < 1)) {
+    std::fprintf(stderr, "Invalid events, hits, or duplicate fraction\n");
+    return EXIT_FAILURE;
+  }
+
+  FW::AmbiguityResolutionAlgorithm::Config ambiguityCfg;
+  ambiguityCfg.inputProtoTracks  = "candidates";
+  ambiguityCfg.outputProtoTracks = "resolved";
+  ambiguityCfg.maxSharedFraction = maxShared;
+  FW::AmbiguityResolutionAlgorithm ambiguity(ambiguityCfg, logLevel);
+
+  std::printf("%10s %12s %12s %12s\n",
+              "tracks",
+              "ms/event",
+              "us/track",
+              "kept/event");
+  for (auto size : sizes) {
+    if (size <= 0) {
+      std::fprintf(stderr, "Invalid number of tracks %d\n", size);
+      return EXIT_FAILURE;
+    }
+    FW::RandomEngine rng(rndConfig.seed);
+
+    double seconds = 0;
+    size_t kept    = 0;
+    for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+      FW::WhiteBoard store(
+          Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+      store.add(ambiguityCfg.inputProtoTracks,
+                makeTracks(size, perTrack, duplicates, sharedHits, rng));
+      FW::AlgorithmContext ctx(0, ievent, store);
+
+      const auto start = Clock::now();
+      if (ambiguity.execute(ctx) != FW::ProcessCode::SUCCESS) {
+        throw std::runtime_error("Ambiguity resolution failed");
+      }
+      seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+      const auto& resolved
+          = store.get<FW::ProtoTrackContainer>(ambiguityCfg.outputProtoTracks);
+      if (not isResolved(resolved, maxShared)) {
+        std::fprintf(stderr, "Unresolved tracks for %d candidates\n", size);
+        return EXIT_FAILURE;
+      }
+      kept += resolved.size();
+    }
+    std::printf("%10d %12.3f %12.3f %12.1f\n",
+                size,
+                1e3 * seconds / nEvents,
+                1e6 * seconds / (nEvents * size),
+                double(kept) / nEvents);
+  }
+  return EXIT_SUCCESS;
+}
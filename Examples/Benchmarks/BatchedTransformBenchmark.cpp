@@ -0,0 +1,278 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Utilities/BatchedTransform.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Surfaces/Surface.hpp"
+#include "Acts/Utilities/Definitions.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Hits on one planar module and the outputs of all transform methods.
+struct ModuleHits
+{
+  const Acts::Surface*        surface = nullptr;
+  std::vector<Acts::Vector2D> localTruth;
+  std::vector<Acts::Vector3D> positions;
+  std::vector<Acts::Vector3D> directions;
+  // outputs of the per-hit and batched transforms
+  std::vector<Acts::Vector2D> localSurface;
+  std::vector<Acts::Vector2D> localInverse;
+  std::vector<Acts::Vector2D> localBatched;
+  std::vector<Acts::Vector3D> directionsInverse;
+  std::vector<Acts::Vector3D> directionsBatched;
+  std::vector<Acts::Vector3D> globalSurface;
+  std::vector<Acts::Vector3D> globalBatched;
+};
+
+/// Random hits on all planar modules.
+///
+/// The local positions are uniformly distributed within a fixed square that
+/// is of the order of the module size; the transforms do not depend on the
+/// surface bounds.
+std::vector<ModuleHits>
+makeHits(const std::vector<const Acts::Surface*>& surfaces,
+         const Acts::GeometryContext&             geoContext,
+         size_t                                   hitsPerModule,
+         FW::RandomEngine&                        rng)
+{
+  std::uniform_real_distribution<double> locDist(-20_mm, 20_mm);
+  std::normal_distribution<double>       dirDist(0, 1);
+
+  std::vector<ModuleHits> modules(surfaces.size());
+  for (size_t imodule = 0; imodule < surfaces.size(); ++imodule) {
+    auto& module   = modules[imodule];
+    module.surface = surfaces[imodule];
+    for (size_t ihit = 0; ihit < hitsPerModule; ++ihit) {
+      const Acts::Vector2D loc(locDist(rng), locDist(rng));
+      const Acts::Vector3D dir
+          = Acts::Vector3D(dirDist(rng), dirDist(rng), dirDist(rng))
+                .normalized();
+      Acts::Vector3D pos(0, 0, 0);
+      module.surface->localToGlobal(geoContext, loc, dir, pos);
+      module.localTruth.push_back(loc);
+      module.positions.push_back(pos);
+      module.directions.push_back(dir);
+    }
+  }
+  return modules;
+}
+
+/// Measure the average time per hit to transform all modules.
+template <typename transform_t>
+double
+timeTransform(std::vector<ModuleHits>& modules,
+              size_t                   repetitions,
+              transform_t&&            transform)
+{
+  size_t     nHits = 0;
+  const auto start = Clock::now();
+  for (size_t i = 0; i < repetitions; ++i) {
+    for (auto& module : modules) {
+      transform(module);
+      nHits += module.positions.size();
+    }
+  }
+  const auto seconds
+      = std::chrono::duration<double>(Clock::now() - start).count();
+  return seconds / std::max<size_t>(nHits, 1u);
+}
+
+/// Largest component-wise deviation between two sets of vectors.
+template <typename vector_t>
+double
+maxDeviation(const std::vector<vector_t>& a, const std::vector<vector_t>& b)
+{
+  double deviation = 0;
+  for (size_t i = 0; i < a.size(); ++i) {
+    deviation = std::max(deviation, (a[i] - b[i]).cwiseAbs().maxCoeff());
+  }
+  return deviation;
+}
+
+}  // namespace
+
+/// Batched transform benchmark and validation executable
+///
+/// Random hits are placed on all planar modules of the generic detector. The
+/// batched global-to-local transforms of positions and directions, as used in
+/// the digitization and the hit smearing, are compared with the per-hit
+/// transforms they replace: `Surface::globalToLocal` and the per-hit product
+/// with the inverse surface transform. The batched local-to-global transform
+/// used in the space point making is compared with `Surface::localToGlobal`.
+///
+/// All methods must agree within the given tolerance, by default 1e-9 mm for
+/// positions and 1e-9 for unit directions; the executable fails otherwise.
+/// The per-hit and the batched paths perform the same arithmetic and only
+/// differ by rounding. The inverse transform is computed once per module in
+/// the batched and the inverse paths, as in the algorithms. The average time
+/// per hit is printed for each number of hits per module.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-hits-per-module",
+      value<read_series>()->multitoken()->default_value({1, 4, 16, 64}),
+      "Number of hits per module")(
+      "bench-repetitions",
+      value<size_t>()->default_value(20),
+      "Number of transforms of all hits per method")(
+      "bench-tolerance",
+      value<double>()->default_value(1e-9),
+      "Maximum allowed deviation between the methods [in mm]");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto sizes       = vm["bench-hits-per-module"].as<read_series>();
+  auto repetitions = vm["bench-repetitions"].as<size_t>();
+  auto tolerance   = vm["bench-tolerance"].as<double>() * 1_mm;
+  auto rndConfig   = FW::Options::readRandomNumbersConfig(vm);
+  if (repetitions == 0) {
+    std::fprintf(stderr, "At least one repetition needed\n");
+    return EXIT_FAILURE;
+  }
+
+  auto trackingGeometry = FW::Geometry::build(vm, detector).first;
+
+  Acts::GeometryContext             geoContext;
+  std::vector<const Acts::Surface*> surfaces;
+  trackingGeometry->visitSurfaces([&](const Acts::Surface* surface) {
+    if (surface and (surface->type() == Acts::Surface::Plane)) {
+      surfaces.push_back(surface);
+    }
+  });
+
+  // per-hit transforms
+  auto surfaceToLocal = [&](ModuleHits& module) {
+    module.localSurface.resize(module.positions.size());
+    for (size_t i = 0; i < module.positions.size(); ++i) {
+      module.surface->globalToLocal(geoContext,
+                                    module.positions[i],
+                                    module.directions[i],
+                                    module.localSurface[i]);
+    }
+  };
+  auto inverseToLocal = [&](ModuleHits& module) {
+    const auto toLocal = module.surface->transform(geoContext).inverse();
+    module.localInverse.resize(module.positions.size());
+    module.directionsInverse.resize(module.positions.size());
+    for (size_t i = 0; i < module.positions.size(); ++i) {
+      module.localInverse[i]      = (toLocal * module.positions[i]).head<2>();
+      module.directionsInverse[i] = toLocal.linear() * module.directions[i];
+    }
+  };
+  auto surfaceToGlobal = [&](ModuleHits& module) {
+    module.globalSurface.resize(module.localTruth.size());
+    for (size_t i = 0; i < module.localTruth.size(); ++i) {
+      module.surface->localToGlobal(geoContext,
+                                    module.localTruth[i],
+                                    module.directions[i],
+                                    module.globalSurface[i]);
+    }
+  };
+  // batched transforms
+  auto batchedToLocal = [&](ModuleHits& module) {
+    const auto toLocal = module.surface->transform(geoContext).inverse();
+    FW::transformToLocal(toLocal, module.positions, module.localBatched);
+    FW::rotateToLocal(toLocal, module.directions, module.directionsBatched);
+  };
+  auto batchedToGlobal = [&](ModuleHits& module) {
+    FW::transformToGlobal(module.surface->transform(geoContext),
+                          module.localTruth,
+                          module.globalBatched);
+  };
+
+  std::printf("%8s %12s %12s %12s %12s %12s %12s\n",
+              "hits/mod",
+              "g2l-surface",
+              "g2l-inverse",
+              "g2l-batched",
+              "l2g-surface",
+              "l2g-batched",
+              "max-dev[mm]");
+  for (auto size : sizes) {
+    if (size <= 0) {
+      std::fprintf(stderr, "Invalid number of hits per module %d\n", size);
+      return EXIT_FAILURE;
+    }
+    FW::RandomEngine rng(rndConfig.seed);
+    auto             modules = makeHits(surfaces, geoContext, size, rng);
+
+    const double g2lSurface
+        = timeTransform(modules, repetitions, surfaceToLocal);
+    const double g2lInverse
+        = timeTransform(modules, repetitions, inverseToLocal);
+    const double g2lBatched
+        = timeTransform(modules, repetitions, batchedToLocal);
+    const double l2gSurface
+        = timeTransform(modules, repetitions, surfaceToGlobal);
+    const double l2gBatched
+        = timeTransform(modules, repetitions, batchedToGlobal);
+
+    double deviation = 0;
+    for (const auto& module : modules) {
+      deviation = std::max({
+          deviation,
+          maxDeviation(module.localBatched, module.localSurface),
+          maxDeviation(module.localBatched, module.localInverse),
+          maxDeviation(module.directionsBatched, module.directionsInverse),
+          maxDeviation(module.globalBatched, module.globalSurface),
+      });
+    }
+    std::printf("%8d %12.2f %12.2f %12.2f %12.2f %12.2f %12.2e\n",
+                size,
+                1e9 * g2lSurface,
+                1e9 * g2lInverse,
+                1e9 * g2lBatched,
+                1e9 * l2gSurface,
+                1e9 * l2gBatched,
+                deviation / 1_mm);
+    if (not(deviation <= tolerance)) {
+      std::fprintf(stderr,
+                   "Batched transforms deviate by %g mm, tolerance %g mm\n",
+                   deviation / 1_mm,
+                   tolerance / 1_mm);
+      return EXIT_FAILURE;
+    }
+  }
+  std::printf("times are in ns/hit\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,199 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/Digitization/DigitizationAlgorithm.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Plugins/Digitization/PlanarModuleStepper.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "PileupEvent.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Digitization timing for one configuration.
+///
+/// The first event is recorded separately since the per-thread clustering
+/// buffers are still empty and must be allocated. All following events
+/// reuse the buffers.
+struct Measurement
+{
+  double firstSeconds = 0;
+  size_t firstHits    = 0;
+  double seconds      = 0;
+  size_t hits         = 0;
+  size_t clusters     = 0;
+};
+
+/// Run the digitization on all events and measure the time of execute only.
+Measurement
+digitizeEvents(const FW::DigitizationAlgorithm&        digitization,
+               const std::vector<FW::SimHitContainer>& events)
+{
+  Measurement measurement;
+  for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+    FW::WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    // the input copy is not part of the measurement
+    store.add("hits", FW::SimHitContainer(events[ievent]));
+    FW::AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (digitization.execute(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Digitization failed");
+    }
+    const double seconds
+        = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (ievent == 0) {
+      measurement.firstSeconds = seconds;
+      measurement.firstHits    = events[ievent].size();
+    } else {
+      measurement.seconds += seconds;
+      measurement.hits += events[ievent].size();
+    }
+    measurement.clusters
+        += store.get<FW::PlanarClusterContainer>("clusters").size();
+  }
+  return measurement;
+}
+
+}  // namespace
+
+/// Digitization throughput benchmark executable
+///
+/// Synthetic pile-up events are simulated in the generic detector by
+/// propagating charged tracks from vertices along the beam line and creating
+/// a hit at every crossed sensitive surface. The digitization is then run on
+/// the same events with one cluster per hit and with the merged clustering of
+/// connected cells, i.e. the connected components search on each module. Only
+/// the execution of the digitization is timed; the event simulation and the
+/// event store setup are not part of the measurement.
+///
+/// The time of the first event, which allocates the clustering buffers, is
+/// printed separately. The time per event and the hit throughput are averaged
+/// over the remaining events, i.e. with reused buffers. The number of
+/// clusters per event is averaged over all events.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-events",
+      value<size_t>()->default_value(10),
+      "Number of digitized events per configuration")(
+      "bench-pileup",
+      value<size_t>()->default_value(200),
+      "Number of pile-up vertices per event")(
+      "bench-tracks-per-vertex",
+      value<size_t>()->default_value(25),
+      "Number of charged tracks per vertex")(
+      "bench-eta-max",
+      value<double>()->default_value(2.5),
+      "Maximum absolute pseudorapidity of the tracks")(
+      "bench-pt",
+      value<read_range>()->multitoken()->default_value({0.5, 10}),
+      "Transverse momentum range of the tracks [in GeV]")(
+      "bench-bz",
+      value<double>()->default_value(2),
+      "Magnetic field along z [in T]");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto nEvents   = vm["bench-events"].as<size_t>();
+  auto ptRange   = vm["bench-pt"].as<read_range>();
+  auto logLevel  = FW::Options::readLogLevel(vm);
+  auto rndConfig = FW::Options::readRandomNumbersConfig(vm);
+
+  FW::PileupEventConfig eventCfg;
+  eventCfg.pileup          = vm["bench-pileup"].as<size_t>();
+  eventCfg.tracksPerVertex = vm["bench-tracks-per-vertex"].as<size_t>();
+  eventCfg.etaMax          = vm["bench-eta-max"].as<double>();
+  eventCfg.bz              = vm["bench-bz"].as<double>() * 1_T;
+  if ((nEvents < 2) or (ptRange.size() != 2)) {
+    std::fprintf(stderr, "At least two events and a momentum range needed\n");
+    return EXIT_FAILURE;
+  }
+  eventCfg.ptMin = ptRange[0] * 1_GeV;
+  eventCfg.ptMax = ptRange[1] * 1_GeV;
+
+  auto trackingGeometry = FW::Geometry::build(vm, detector).first;
+
+  // the same events are digitized with all configurations
+  FW::RandomEngine                 rng(rndConfig.seed);
+  std::vector<FW::SimHitContainer> events;
+  for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+    events.push_back(FW::makePileupEvent(trackingGeometry, eventCfg, rng));
+  }
+
+  FW::DigitizationAlgorithm::Config digiCfg;
+  digiCfg.inputSimulatedHits  = "hits";
+  digiCfg.outputClusters      = "clusters";
+  digiCfg.planarModuleStepper = std::make_shared<Acts::PlanarModuleStepper>(
+      Acts::getDefaultLogger("PlanarModuleStepper", logLevel));
+  digiCfg.randomNumbers    = std::make_shared<FW::RandomNumbers>(rndConfig);
+  digiCfg.trackingGeometry = trackingGeometry;
+
+  std::printf("%-10s %8s %12s %12s %12s %12s %15s\n",
+              "clustering",
+              "pileup",
+              "hits/event",
+              "first[ms]",
+              "ms/event",
+              "Mhits/s",
+              "clusters/event");
+  for (bool mergeHits : {false, true}) {
+    digiCfg.mergeHits = mergeHits;
+    FW::DigitizationAlgorithm digitization(digiCfg, logLevel);
+
+    const auto measurement = digitizeEvents(digitization, events);
+    const auto nReused = nEvents - 1;
+    std::printf("%-10s %8zu %12.1f %12.2f %12.2f %12.3f %15.1f\n",
+                mergeHits ? "merged" : "per-hit",
+                eventCfg.pileup,
+                double(measurement.firstHits + measurement.hits) / nEvents,
+                1e3 * measurement.firstSeconds,
+                1e3 * measurement.seconds / nReused,
+                1e-6 * measurement.hits / measurement.seconds,
+                double(measurement.clusters) / nEvents);
+  }
+  return EXIT_SUCCESS;
+}
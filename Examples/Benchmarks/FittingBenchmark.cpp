@@ -0,0 +1,637 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/Digitization/HitSmearing.hpp"
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/EventData/SimParticle.hpp"
+#include "ACTFW/EventData/SimSourceLink.hpp"
+#include "ACTFW/EventData/Track.hpp"
+#include "ACTFW/Fitting/FittingAlgorithm.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Io/Performance/TrackFitterPerformanceWriter.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Plugins/BField/BFieldOptions.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "ACTFW/Utilities/Paths.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/Utilities/Helpers.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/ParameterDefinitions.hpp"
+#include "Acts/Utilities/PdgParticle.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Utilities/detail/periodic.hpp"
+#include "PileupEvent.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Fit inputs and truth for one event.
+struct Event
+{
+  FW::SimHitContainer          hits;
+  FW::SimSourceLinkContainer   sourceLinks;
+  FW::ProtoTrackContainer      protoTracks;
+  FW::TrackParametersContainer initialParameters;
+  /// Generating track for each proto track
+  std::vector<FW::PileupTrack> truth;
+  /// Generating particle for each proto track for the performance writer
+  FW::SimParticleContainer particles;
+};
+
+/// Smearing widths of the initial track parameters.
+struct InitialSmearing
+{
+  double sigmaPos   = 20_um;
+  double sigmaAngle = 1_degree;
+  double sigmaPRel  = 0.01;
+  double sigmaTime  = 1_ns;
+};
+
+/// Smeared measurements, truth proto tracks, and smeared initial parameters.
+///
+/// The source links refer to the hits; both are moved out of the event store
+/// together and the hit storage does not move.
+Event
+makeEvent(std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry,
+          const FW::PileupEventConfig&                  eventCfg,
+          const FW::HitSmearing&                        smearing,
+          const FW::HitSmearing::Config&                smearingCfg,
+          const InitialSmearing&                        initial,
+          size_t                                        minHits,
+          size_t                                        ievent,
+          FW::RandomEngine&                             rng)
+{
+  std::vector<FW::PileupTrack> tracks;
+  auto hits = FW::makePileupEvent(trackingGeometry, eventCfg, rng, &tracks);
+
+  FW::WhiteBoard store(
+      Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+  store.add(smearingCfg.inputSimulatedHits, std::move(hits));
+  FW::AlgorithmContext ctx(0, ievent, store);
+  if (smearing.execute(ctx) != FW::ProcessCode::SUCCESS) {
+    throw std::runtime_error("Hit smearing failed");
+  }
+  Event event;
+  event.hits = store.pop<FW::SimHitContainer>(smearingCfg.inputSimulatedHits);
+  event.sourceLinks
+      = store.pop<FW::SimSourceLinkContainer>(smearingCfg.outputSourceLinks);
+
+  // group the measurements by their generating track
+  std::unordered_map<ActsFatras::Barcode::Value, size_t> trackIndices;
+  for (size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    trackIndices.emplace(tracks[itrack].particleId.value(), itrack);
+  }
+  std::vector<FW::ProtoTrack> byTrack(tracks.size());
+  for (size_t imeas = 0; imeas < event.sourceLinks.size(); ++imeas) {
+    const auto& hit = event.sourceLinks.nth(imeas)->truthHit();
+    byTrack.at(trackIndices.at(hit.particleId().value())).push_back(imeas);
+  }
+
+  std::normal_distribution<double> stdNormal(0.0, 1.0);
+  for (size_t itrack = 0; itrack < tracks.size(); ++itrack) {
+    if (byTrack[itrack].size() < minHits) { continue; }
+
+    const auto&  track      = tracks[itrack];
+    const double p          = track.momentum.norm();
+    const double phi        = Acts::VectorHelpers::phi(track.momentum);
+    const double theta      = Acts::VectorHelpers::theta(track.momentum);
+    const double deltaPhi   = initial.sigmaAngle * stdNormal(rng);
+    const double deltaTheta = initial.sigmaAngle * stdNormal(rng);
+    // smear direction angles phi,theta ensuring correct bounds
+    const auto angles
+        = Acts::detail::ensureThetaBounds(phi + deltaPhi, theta + deltaTheta);
+    const Acts::Vector3D dir(std::sin(angles.second) * std::cos(angles.first),
+                             std::sin(angles.second) * std::sin(angles.first),
+                             std::cos(angles.second));
+    const Acts::Vector3D pos = track.vertex
+        + initial.sigmaPos
+            * Acts::Vector3D(stdNormal(rng), stdNormal(rng), stdNormal(rng));
+    const double sigmaQOverP = initial.sigmaPRel / p;
+
+    Acts::BoundSymMatrix cov        = Acts::BoundSymMatrix::Zero();
+    cov(Acts::eLOC_0, Acts::eLOC_0) = initial.sigmaPos * initial.sigmaPos;
+    cov(Acts::eLOC_1, Acts::eLOC_1) = initial.sigmaPos * initial.sigmaPos;
+    cov(Acts::ePHI, Acts::ePHI)     = initial.sigmaAngle * initial.sigmaAngle;
+    cov(Acts::eTHETA, Acts::eTHETA) = initial.sigmaAngle * initial.sigmaAngle;
+    cov(Acts::eQOP, Acts::eQOP)     = sigmaQOverP * sigmaQOverP;
+    cov(Acts::eT, Acts::eT)         = initial.sigmaTime * initial.sigmaTime;
+
+    event.protoTracks.push_back(std::move(byTrack[itrack]));
+    event.initialParameters.emplace_back(
+        std::make_optional(std::move(cov)),
+        pos,
+        p * (1 + initial.sigmaPRel * stdNormal(rng)) * dir,
+        track.charge,
+        0.0);
+    event.truth.push_back(track);
+
+    // charged pions; the particle only provides the truth for the writer
+    const auto pdg = (0 < track.charge)
+        ? Acts::PdgParticle::ePionPlus
+        : static_cast<Acts::PdgParticle>(-Acts::PdgParticle::ePionPlus);
+    ActsFatras::Particle particle(
+        track.particleId, pdg, track.charge, 139.57_MeV);
+    particle.setPosition4(
+        track.vertex.x(), track.vertex.y(), track.vertex.z(), 0.0);
+    particle.setDirection(track.momentum.normalized());
+    particle.setAbsMomentum(p);
+    event.particles.insert(std::move(particle));
+  }
+  return event;
+}
+
+/// Running mean and standard deviation.
+struct Moments
+{
+  double n    = 0;
+  double sum  = 0;
+  double sum2 = 0;
+
+  void
+  add(double x)
+  {
+    n += 1;
+    sum += x;
+    sum2 += x * x;
+  }
+  double
+  mean() const
+  {
+    return (0 < n) ? sum / n : 0;
+  }
+  double
+  stddev() const
+  {
+    return (0 < n) ? std::sqrt(std::max(sum2 / n - mean() * mean(), 0.)) : 0;
+  }
+};
+
+/// Smoothed, or filtered for forward-only fits, residuals and pulls at the
+/// measurements and perigee pulls.
+constexpr std::array<const char*, 9> kQuantities = {"res loc0[um]",
+                                                    "res loc1[um]",
+                                                    "pull loc0",
+                                                    "pull loc1",
+                                                    "pull d0",
+                                                    "pull z0",
+                                                    "pull phi",
+                                                    "pull theta",
+                                                    "pull q/p"};
+
+/// One fitter configuration of the benchmark.
+struct Mode
+{
+  std::string name;
+  /// Number of lockstep lanes; zero for the regular fitter
+  size_t lanes = 0;
+  /// Run the lockstep smoother; the regular fitter always smooths
+  bool smoothing = true;
+  /// Flag measurements with a large predicted chi2 as outliers
+  bool outliers = false;
+  /// Apply the chi2/ndf and consecutive outlier limits
+  bool cuts = false;
+  /// Validate against the regular fitter
+  bool validate = false;
+};
+
+/// Timing and fit performance of one fitter configuration.
+struct Measurement
+{
+  double                                  seconds   = 0;
+  size_t                                  tracks    = 0;
+  size_t                                  fitted    = 0;
+  double                                  deviation = 0;
+  std::array<Moments, kQuantities.size()> moments;
+};
+
+/// Accumulate the residuals and pulls of the fitted tracks of one event.
+///
+/// If reference trajectories are given, the largest difference of the
+/// perigee parameters with respect to the reference in units of the
+/// reference uncertainty is recorded as well.
+void
+analyze(const FW::TrajectoryContainer& trajectories,
+        const FW::TrajectoryContainer* reference,
+        const Event&                   event,
+        Measurement&                   measurement)
+{
+  for (size_t itrack = 0; itrack < trajectories.size(); ++itrack) {
+    const auto& track = trajectories[itrack];
+    measurement.tracks += 1;
+    if (not track.hasTrajectory() or not track.hasTrackParameters()) {
+      continue;
+    }
+    measurement.fitted += 1;
+
+    const auto& [tip, mtj] = track.trajectory();
+    mtj.visitBackwards(tip, [&](const auto& state) {
+      if (not state.typeFlags().test(Acts::TrackStateFlag::MeasurementFlag)) {
+        return;
+      }
+      const auto& sl = state.uncalibrated();
+      // forward-only fits have no smoothed parameters
+      const bool isSmoothed = state.hasSmoothed();
+      const auto params = isSmoothed ? state.smoothed() : state.filtered();
+      const auto cov = isSmoothed ? state.smoothedCovariance()
+                                  : state.filteredCovariance();
+      for (size_t i = 0; i < 2; ++i) {
+        const double res = sl.values()[i] - params[i];
+        const double var = sl.covariance()(i, i) - cov(i, i);
+        measurement.moments[i].add(res / 1_um);
+        if (0 < var) { measurement.moments[2 + i].add(res / std::sqrt(var)); }
+      }
+    });
+
+    // the vertices are on the beam line, i.e. the true d0 vanishes
+    const auto&                 params = track.trackParameters();
+    const auto&                 truth  = event.truth[itrack];
+    const std::array<double, 5> trueValues
+        = {0.0,
+           truth.vertex.z(),
+           Acts::VectorHelpers::phi(truth.momentum),
+           Acts::VectorHelpers::theta(truth.momentum),
+           truth.charge / truth.momentum.norm()};
+    if (not params.covariance()) { continue; }
+    const auto& cov = *params.covariance();
+    for (size_t i = 0; i < trueValues.size(); ++i) {
+      double diff = params.parameters()[i] - trueValues[i];
+      if (i == Acts::ePHI) { diff = std::remainder(diff, 2 * M_PI); }
+      if (0 < cov(i, i)) {
+        measurement.moments[4 + i].add(diff / std::sqrt(cov(i, i)));
+      }
+    }
+
+    if (not reference) { continue; }
+    const auto& other = (*reference)[itrack];
+    if (not other.hasTrackParameters()) { continue; }
+    const auto& otherParams = other.trackParameters();
+    if (not otherParams.covariance()) { continue; }
+    const auto& otherCov = *otherParams.covariance();
+    for (size_t i = 0; i < trueValues.size(); ++i) {
+      double diff = params.parameters()[i] - otherParams.parameters()[i];
+      if (i == Acts::ePHI) { diff = std::remainder(diff, 2 * M_PI); }
+      if (0 < otherCov(i, i)) {
+        measurement.deviation = std::max(
+            measurement.deviation, std::abs(diff) / std::sqrt(otherCov(i, i)));
+      }
+    }
+  }
+}
+
+/// Fit all events with one fitter configuration and write the performance.
+Measurement
+fitEvents(const FW::FittingAlgorithm::Config&             cfg,
+          const FW::TrackFitterPerformanceWriter::Config& writerCfg,
+          Acts::Logging::Level                            logLevel,
+          const std::vector<Event>&                       events,
+          const std::vector<FW::TrajectoryContainer>*     reference,
+          std::vector<FW::TrajectoryContainer>&           output)
+{
+  FW::FittingAlgorithm             fitting(cfg, logLevel);
+  FW::TrackFitterPerformanceWriter writer(writerCfg, logLevel);
+
+  Measurement measurement;
+  output.clear();
+  for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+    const auto& event = events[ievent];
+
+    FW::WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    // the input copies are not part of the measurement
+    store.add(cfg.inputSourceLinks,
+              FW::SimSourceLinkContainer(event.sourceLinks));
+    store.add(cfg.inputProtoTracks, FW::ProtoTrackContainer(event.protoTracks));
+    store.add(cfg.inputInitialTrackParameters,
+              FW::TrackParametersContainer(event.initialParameters));
+    store.add(writerCfg.inputParticles,
+              FW::SimParticleContainer(event.particles));
+    FW::AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (fitting.execute(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Fitting failed");
+    }
+    measurement.seconds
+        += std::chrono::duration<double>(Clock::now() - start).count();
+    if (writer.write(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Writing the fit performance failed");
+    }
+
+    output.push_back(
+        store.pop<FW::TrajectoryContainer>(cfg.outputTrajectories));
+    analyze(output.back(),
+            reference ? &(*reference)[ievent] : nullptr,
+            event,
+            measurement);
+  }
+  if (writer.endRun() != FW::ProcessCode::SUCCESS) {
+    throw std::runtime_error("Writing the fit performance failed");
+  }
+  return measurement;
+}
+
+}  // namespace
+
+/// Fitting benchmark executable
+///
+/// Synthetic pile-up events are simulated in the generic detector as for the
+/// digitization benchmark. The hits are smeared into two-dimensional local
+/// measurements and grouped into truth proto tracks with smeared initial
+/// parameters. All events are fitted in each of the following modes:
+///
+/// - the regular Kalman fitter,
+/// - the regular fitter with outlier flagging,
+/// - the regular fitter with outlier flagging and the chi2/ndf and
+///   consecutive outlier limits applied after the fit,
+/// - the lockstep fitter for each requested number of lanes,
+/// - the lockstep fitter with outlier flagging and the limits, which aborts
+///   hopeless tracks during the fit, and
+/// - the lockstep fitter without smoothing, i.e. forward filtering only.
+///
+/// For each mode the fit time, the fraction of fitted tracks, and the mean
+/// and standard deviation of the residuals and pulls at the measurements and
+/// of the perigee parameter pulls are printed in a table. The track fitter
+/// performance histograms are written to one file per mode.
+///
+/// The full lockstep fits are validated against the regular fitter: the mean
+/// of each quantity may differ by at most the tolerance times the standard
+/// deviation of the regular fitter and the standard deviations may differ by
+/// at most the relative tolerance. The largest per-track difference of the
+/// perigee parameters in units of the regular fitter uncertainty is shown for
+/// information. The benchmark fails if the validation fails.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  FW::Options::addOutputOptions(desc);
+  desc.add_options()(
+      "bench-lanes",
+      value<read_series>()->multitoken()->default_value({4, 8, 16}),
+      "Lockstep lanes to benchmark; each must be 4, 8, or 16")(
+      "bench-mode-lanes",
+      value<size_t>()->default_value(8),
+      "Lockstep lanes of the outlier and the forward-only modes")(
+      "bench-events",
+      value<size_t>()->default_value(10),
+      "Number of fitted events")(
+      "bench-vertices",
+      value<size_t>()->default_value(10),
+      "Number of vertices per event")(
+      "bench-tracks-per-vertex",
+      value<size_t>()->default_value(10),
+      "Number of charged tracks per vertex")(
+      "bench-eta-max",
+      value<double>()->default_value(2.5),
+      "Maximum absolute pseudorapidity of the tracks")(
+      "bench-pt",
+      value<read_range>()->multitoken()->default_value({0.5, 10}),
+      "Transverse momentum range of the tracks [in GeV]")(
+      "bench-bz",
+      value<double>()->default_value(2),
+      "Magnetic field along z [in T]")(
+      "bench-resolution",
+      value<read_range>()->multitoken()->default_value({25, 100}),
+      "Local measurement resolutions loc0 and loc1 [in um]")(
+      "bench-min-hits",
+      value<size_t>()->default_value(5),
+      "Minimum number of measurements for a fitted track")(
+      "bench-outlier-chi2",
+      value<double>()->default_value(25),
+      "Maximum predicted chi2 of a measurement in the outlier modes")(
+      "bench-chi2ndf-max",
+      value<double>()->default_value(5),
+      "Maximum chi2/ndf of a track in the outlier modes")(
+      "bench-max-consecutive-outliers",
+      value<size_t>()->default_value(2),
+      "Maximum number of consecutive outliers in the outlier modes")(
+      "bench-tolerance",
+      value<double>()->default_value(0.1),
+      "Validation tolerance of the lockstep against the regular fitter");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto lanes       = vm["bench-lanes"].as<read_series>();
+  auto modeLanes   = vm["bench-mode-lanes"].as<size_t>();
+  auto nEvents     = vm["bench-events"].as<size_t>();
+  auto ptRange     = vm["bench-pt"].as<read_range>();
+  auto resolution  = vm["bench-resolution"].as<read_range>();
+  auto minHits     = vm["bench-min-hits"].as<size_t>();
+  auto outlierChi2 = vm["bench-outlier-chi2"].as<double>();
+  auto chi2NdfMax  = vm["bench-chi2ndf-max"].as<double>();
+  auto maxOutliers = vm["bench-max-consecutive-outliers"].as<size_t>();
+  auto tolerance   = vm["bench-tolerance"].as<double>();
+  auto outputDir
+      = FW::ensureWritableDirectory(vm["output-dir"].as<std::string>());
+  auto logLevel  = FW::Options::readLogLevel(vm);
+  auto rndConfig = FW::Options::readRandomNumbersConfig(vm);
+
+  FW::PileupEventConfig eventCfg;
+  eventCfg.pileup          = vm["bench-vertices"].as<size_t>();
+  eventCfg.tracksPerVertex = vm["bench-tracks-per-vertex"].as<size_t>();
+  eventCfg.etaMax          = vm["bench-eta-max"].as<double>();
+  eventCfg.bz              = vm["bench-bz"].as<double>() * 1_T;
+  if ((nEvents == 0) or (ptRange.size() != 2) or (resolution.size() != 2)
+      or not(0 < tolerance) or not(0 < outlierChi2) or not(0 < chi2NdfMax)) {
+    std::fprintf(stderr, "Invalid events, ranges, limits, or tolerance\n");
+    return EXIT_FAILURE;
+  }
+  for (auto nLanes : lanes) {
+    if ((nLanes != 4) and (nLanes != 8) and (nLanes != 16)) {
+      std::fprintf(stderr, "Invalid number of lanes %d\n", nLanes);
+      return EXIT_FAILURE;
+    }
+  }
+  if ((modeLanes != 4u) and (modeLanes != 8u) and (modeLanes != 16u)) {
+    std::fprintf(stderr, "Invalid number of mode lanes %zu\n", modeLanes);
+    return EXIT_FAILURE;
+  }
+  eventCfg.ptMin = ptRange[0] * 1_GeV;
+  eventCfg.ptMax = ptRange[1] * 1_GeV;
+
+  auto trackingGeometry = FW::Geometry::build(vm, detector).first;
+  FW::Options::BFieldVariant magneticField
+      = std::make_shared<Acts::ConstantBField>(0, 0, eventCfg.bz);
+
+  FW::HitSmearing::Config smearingCfg;
+  smearingCfg.inputSimulatedHits = "hits";
+  smearingCfg.outputSourceLinks  = "sourcelinks";
+  smearingCfg.sigmaLoc0          = resolution[0] * 1_um;
+  smearingCfg.sigmaLoc1          = resolution[1] * 1_um;
+  smearingCfg.trackingGeometry   = trackingGeometry;
+  smearingCfg.randomNumbers = std::make_shared<FW::RandomNumbers>(rndConfig);
+  FW::HitSmearing smearing(smearingCfg, logLevel);
+
+  // all modes fit the same events
+  FW::RandomEngine   rng(rndConfig.seed);
+  std::vector<Event> events;
+  for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+    events.push_back(makeEvent(trackingGeometry,
+                               eventCfg,
+                               smearing,
+                               smearingCfg,
+                               InitialSmearing(),
+                               minHits,
+                               ievent,
+                               rng));
+  }
+
+  // the first mode is the reference for the validation
+  std::vector<Mode> modes;
+  modes.push_back({"regular", 0u, true, false, false, false});
+  modes.push_back({"regular-outliers", 0u, true, true, false, false});
+  modes.push_back({"regular-cuts", 0u, true, true, true, false});
+  for (auto nLanes : lanes) {
+    modes.push_back({"lockstep-" + std::to_string(nLanes),
+                     static_cast<size_t>(nLanes),
+                     true,
+                     false,
+                     false,
+                     true});
+  }
+  modes.push_back({"lockstep-cuts", modeLanes, true, true, true, false});
+  modes.push_back({"lockstep-forward", modeLanes, false, false, false, false});
+
+  FW::FittingAlgorithm::Config fitCfg;
+  fitCfg.inputSourceLinks            = smearingCfg.outputSourceLinks;
+  fitCfg.inputProtoTracks            = "prototracks";
+  fitCfg.inputInitialTrackParameters = "initialparameters";
+  fitCfg.outputTrajectories          = "trajectories";
+  fitCfg.fit = FW::FittingAlgorithm::makeFitterFunction(
+      trackingGeometry, magneticField, logLevel);
+
+  FW::TrackFitterPerformanceWriter::Config writerCfg;
+  writerCfg.inputParticles    = "particles";
+  writerCfg.inputTrajectories = fitCfg.outputTrajectories;
+  writerCfg.outputDir         = outputDir;
+
+  std::vector<FW::TrajectoryContainer> referenceOutput;
+  std::vector<FW::TrajectoryContainer> modeOutput;
+  std::vector<Measurement>             measurements;
+  for (const auto& mode : modes) {
+    auto cfg          = fitCfg;
+    cfg.lockstepLanes = mode.lanes;
+    if (0u < mode.lanes) {
+      cfg.fitBatch
+          = FW::FittingAlgorithm::makeLockstepFitterFunction(trackingGeometry,
+                                                             magneticField,
+                                                             mode.lanes,
+                                                             mode.smoothing,
+                                                             logLevel);
+    }
+    if (mode.outliers) { cfg.outlierChi2Max = outlierChi2; }
+    if (mode.cuts) {
+      cfg.chi2NdfMax             = chi2NdfMax;
+      cfg.maxConsecutiveOutliers = maxOutliers;
+    }
+    auto modeWriterCfg = writerCfg;
+    modeWriterCfg.outputFilename
+        = "performance_track_fitter_" + mode.name + ".root";
+
+    const bool isReference = measurements.empty();
+    measurements.push_back(
+        fitEvents(cfg,
+                  modeWriterCfg,
+                  logLevel,
+                  events,
+                  isReference ? nullptr : &referenceOutput,
+                  isReference ? referenceOutput : modeOutput));
+  }
+
+  std::printf("%-18s %6s %12s %12s %10s %12s\n",
+              "mode",
+              "lanes",
+              "ms/event",
+              "us/track",
+              "fitted[%]",
+              "max dev[sd]");
+  for (size_t imode = 0; imode < modes.size(); ++imode) {
+    const auto& m = measurements[imode];
+    std::printf("%-18s %6zu %12.3f %12.3f %10.2f %12.3f\n",
+                modes[imode].name.c_str(),
+                modes[imode].lanes,
+                1e3 * m.seconds / nEvents,
+                1e6 * m.seconds / std::max<size_t>(m.tracks, 1u),
+                100. * m.fitted / std::max<size_t>(m.tracks, 1u),
+                m.deviation);
+  }
+
+  bool        isValid   = true;
+  const auto& reference = measurements.front();
+  std::printf("\n%-18s %-14s %10s %10s %10s %10s\n",
+              "mode",
+              "quantity",
+              "mean",
+              "std",
+              "dmean/std",
+              "std ratio");
+  for (size_t imode = 0; imode < modes.size(); ++imode) {
+    const auto& m = measurements[imode];
+    for (size_t i = 0; i < kQuantities.size(); ++i) {
+      const auto&  ref   = reference.moments[i];
+      const double shift = (m.moments[i].mean() - ref.mean())
+          / std::max(ref.stddev(), std::numeric_limits<double>::min());
+      const double ratio = m.moments[i].stddev()
+          / std::max(ref.stddev(), std::numeric_limits<double>::min());
+      // modes with outliers or without smoothing are expected to differ
+      const bool isCompatible = not modes[imode].validate
+          or ((std::abs(shift) <= tolerance)
+              and (std::abs(ratio - 1) <= tolerance));
+      std::printf("%-18s %-14s %10.4f %10.4f %10.4f %10.4f%s\n",
+                  modes[imode].name.c_str(),
+                  kQuantities[i],
+                  m.moments[i].mean(),
+                  m.moments[i].stddev(),
+                  shift,
+                  ratio,
+                  isCompatible ? "" : " incompatible");
+      isValid = isValid and isCompatible;
+    }
+  }
+  if (not isValid) {
+    std::fprintf(stderr, "Lockstep fitter is incompatible with the regular\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
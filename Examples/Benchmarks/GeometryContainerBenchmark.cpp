@@ -0,0 +1,193 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "ACTFW/Utilities/RadixSort.hpp"
+#include "Acts/Geometry/GeometryID.hpp"
+
+namespace {
+
+using Clock        = std::chrono::steady_clock;
+using HitSequence  = FW::SimHitContainer::sequence_type;
+using GeometryKeys = std::vector<Acts::GeometryID::Value>;
+
+/// Simulated hits in the order of the simulation, i.e. grouped by particle.
+///
+/// Each particle crosses the layers of a random volume outwards and leaves
+/// one hit on a random module of each layer. The geometry identifiers are
+/// therefore ordered within a particle but not between particles.
+HitSequence
+makeHits(size_t numHits, size_t hitsPerParticle, FW::RandomEngine& rng)
+{
+  std::uniform_int_distribution<Acts::GeometryID::Value> volumeDist(1u, 16u);
+  std::uniform_int_distribution<Acts::GeometryID::Value> moduleDist(1u, 2000u);
+
+  HitSequence hits;
+  hits.reserve(numHits);
+  for (size_t i = 0; i < numHits; ++i) {
+    Acts::GeometryID geoId;
+    geoId.setVolume(volumeDist(rng));
+    geoId.setLayer(2u * (1u + i % hitsPerParticle));
+    geoId.setSensitive(moduleDist(rng));
+    const auto pid = ActsFatras::Barcode(0u).setVertexPrimary(1u).setParticle(
+        1u + i / hitsPerParticle);
+    const ActsFatras::Hit::Vector4 zero4 = ActsFatras::Hit::Vector4::Zero();
+    hits.emplace_back(geoId, pid, zero4, zero4, zero4, i % hitsPerParticle);
+  }
+  return hits;
+}
+
+/// Adopt a sequence that is already ordered by geometry identifier.
+FW::SimHitContainer
+adoptOrdered(HitSequence&& hits)
+{
+  FW::SimHitContainer container;
+  container.adopt_sequence(boost::container::ordered_range, std::move(hits));
+  return container;
+}
+
+/// Measure the average time to build an ordered container.
+template <typename builder_t>
+double
+timeBuild(const HitSequence& unordered,
+          size_t             repetitions,
+          GeometryKeys&      keys,
+          builder_t&&        build)
+{
+  double seconds = 0;
+  for (size_t i = 0; i < repetitions; ++i) {
+    // the input copy is not part of the measurement
+    HitSequence input = unordered;
+    const auto  start = Clock::now();
+    auto        hits  = build(std::move(input));
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+    keys.clear();
+    for (const auto& hit : hits) { keys.push_back(hit.geometryId().value()); }
+  }
+  return seconds / repetitions;
+}
+
+}  // namespace
+
+/// Geometry container build benchmark executable
+///
+/// Simulated hits are created in the simulation order and are then ordered
+/// by geometry identifier to build the hit container. The radix sort builder,
+/// serial and parallel, is compared with a comparison sort of the sequence and
+/// with the previous build, i.e. adopting the unordered sequence. The parallel
+/// radix sort only uses multiple threads above its grain size. All methods
+/// are cross-checked to give the same order of geometry identifiers. The
+/// average build time per hit is printed in a table.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-hits",
+      value<read_series>()->multitoken()->default_value(
+          {10000, 100000, 1000000}),
+      "Number of simulated hits in the container")(
+      "bench-hits-per-particle",
+      value<size_t>()->default_value(10),
+      "Number of simulated hits per particle")(
+      "bench-repetitions",
+      value<size_t>()->default_value(5),
+      "Number of builds per container size");
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto sizes       = vm["bench-hits"].as<read_series>();
+  auto perParticle = vm["bench-hits-per-particle"].as<size_t>();
+  auto repetitions = vm["bench-repetitions"].as<size_t>();
+  auto rndConfig   = FW::Options::readRandomNumbersConfig(vm);
+  if ((perParticle == 0) or (repetitions == 0)) {
+    std::fprintf(stderr, "Invalid hits per particle or repetitions\n");
+    return EXIT_FAILURE;
+  }
+
+  std::printf("%10s %15s %15s %15s %15s\n",
+              "hits",
+              "radix[ns/hit]",
+              "radixMT[ns/hit]",
+              "sort[ns/hit]",
+              "adopt[ns/hit]");
+  for (auto size : sizes) {
+    if (size <= 0) {
+      std::fprintf(stderr, "Invalid number of hits %d\n", size);
+      return EXIT_FAILURE;
+    }
+    FW::RandomEngine rng(rndConfig.seed);
+    const auto       unordered = makeHits(size, perParticle, rng);
+    auto             getKey    = [](const FW::SimHit& hit) {
+      return hit.geometryId().value();
+    };
+
+    auto buildRadix = [&](HitSequence hits) {
+      FW::radixSort(hits, getKey, false);
+      return adoptOrdered(std::move(hits));
+    };
+    auto buildParallel = [&](HitSequence hits) {
+      FW::radixSort(hits, getKey, true);
+      return adoptOrdered(std::move(hits));
+    };
+    auto buildSort = [&](HitSequence hits) {
+      std::sort(hits.begin(), hits.end(), [&](const auto& a, const auto& b) {
+        return getKey(a) < getKey(b);
+      });
+      return adoptOrdered(std::move(hits));
+    };
+    auto buildAdopt = [&](HitSequence hits) {
+      FW::SimHitContainer container;
+      container.adopt_sequence(std::move(hits));
+      return container;
+    };
+
+    GeometryKeys radixKeys, parallelKeys, sortKeys, adoptKeys;
+    const double radix
+        = timeBuild(unordered, repetitions, radixKeys, buildRadix);
+    const double parallel
+        = timeBuild(unordered, repetitions, parallelKeys, buildParallel);
+    const double sort = timeBuild(unordered, repetitions, sortKeys, buildSort);
+    const double adopt
+        = timeBuild(unordered, repetitions, adoptKeys, buildAdopt);
+
+    if ((radixKeys != parallelKeys) or (radixKeys != sortKeys)
+        or (radixKeys != adoptKeys)) {
+      std::fprintf(stderr, "Inconsistent hit order for %d hits\n", size);
+      return EXIT_FAILURE;
+    }
+    std::printf("%10d %15.2f %15.2f %15.2f %15.2f\n",
+                size,
+                1e9 * radix / size,
+                1e9 * parallel / size,
+                1e9 * sort / size,
+                1e9 * adopt / size);
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/EventData/SimParticle.hpp"
+#include "ACTFW/EventData/SimParticleIndex.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Utilities/PdgParticle.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double
+secondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Particles with realistic barcodes, i.e. grouped by primary vertex.
+FW::SimParticleContainer
+makeParticles(size_t numParticles, size_t particlesPerVertex)
+{
+  FW::SimParticleContainer::sequence_type particles;
+  particles.reserve(numParticles);
+  for (size_t i = 0; i < numParticles; ++i) {
+    // vertex zero is reserved for elements without an associated particle
+    const auto pid = ActsFatras::Barcode(0u)
+                         .setVertexPrimary(1u + i / particlesPerVertex)
+                         .setParticle(1u + i % particlesPerVertex);
+    particles.emplace_back(pid, Acts::PdgParticle::ePionPlus, 1_e, 139.57_MeV);
+  }
+  FW::SimParticleContainer container;
+  container.adopt_sequence(boost::container::ordered_unique_range,
+                           std::move(particles));
+  return container;
+}
+
+}  // namespace
+
+/// Particle lookup benchmark executable
+///
+/// Compares the barcode lookup in the particle container, i.e. a binary
+/// search in the ordered flat set, with the hash index. Random barcodes are
+/// looked up, a configurable fraction of them is not in the container. The
+/// index is built once per container as in the writers and its build time is
+/// reported separately. Both lookups are cross-checked against each other.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-particles",
+      value<read_series>()->multitoken()->default_value(
+          {1000, 10000, 100000}),
+      "Number of particles in the container")(
+      "bench-particles-per-vertex",
+      value<size_t>()->default_value(50),
+      "Number of particles per primary vertex")(
+      "bench-lookups",
+      value<size_t>()->default_value(1000000),
+      "Number of lookups per container")(
+      "bench-missing-fraction",
+      value<double>()->default_value(0.1),
+      "Fraction of looked up barcodes that are not in the container");
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto sizes      = vm["bench-particles"].as<read_series>();
+  auto perVertex  = vm["bench-particles-per-vertex"].as<size_t>();
+  auto numLookups = vm["bench-lookups"].as<size_t>();
+  auto missing    = vm["bench-missing-fraction"].as<double>();
+  auto rndConfig  = FW::Options::readRandomNumbersConfig(vm);
+  if (perVertex == 0) {
+    std::fprintf(stderr, "At least one particle per vertex needed\n");
+    return EXIT_FAILURE;
+  }
+
+  std::printf("%10s %10s %15s %15s %15s\n",
+              "particles",
+              "lookups",
+              "set[ns/find]",
+              "index[ns/find]",
+              "build[us]");
+  for (auto size : sizes) {
+    if (size <= 0) {
+      std::fprintf(stderr, "Invalid number of particles %d\n", size);
+      return EXIT_FAILURE;
+    }
+    const auto particles = makeParticles(size, perVertex);
+
+    // the same random barcodes are used for both lookups
+    FW::RandomEngine                      rng(rndConfig.seed);
+    std::uniform_int_distribution<size_t> posDist(0u, particles.size() - 1);
+    std::bernoulli_distribution           missingDist(missing);
+    std::vector<ActsFatras::Barcode>      barcodes;
+    barcodes.reserve(numLookups);
+    for (size_t i = 0; i < numLookups; ++i) {
+      auto pid = particles.nth(posDist(rng))->particleId();
+      // a particle generation that is never used by the generated particles
+      if (missingDist(rng)) { pid.setGeneration(1u); }
+      barcodes.push_back(pid);
+    }
+
+    // positions are stored to keep the lookups and to cross-check them
+    std::vector<size_t> setPositions(numLookups);
+    auto                start = Clock::now();
+    for (size_t i = 0; i < numLookups; ++i) {
+      auto it         = particles.find(barcodes[i]);
+      setPositions[i] = (it != particles.end()) ? particles.index_of(it)
+                                                : SIZE_MAX;
+    }
+    const double setSeconds = secondsSince(start);
+
+    start = Clock::now();
+    const FW::SimParticleIndex index(particles);
+    const double               buildSeconds = secondsSince(start);
+
+    std::vector<size_t> indexPositions(numLookups);
+    start = Clock::now();
+    for (size_t i = 0; i < numLookups; ++i) {
+      indexPositions[i] = index.indexOf(barcodes[i]);
+    }
+    const double indexSeconds = secondsSince(start);
+
+    if (setPositions != indexPositions) {
+      std::fprintf(stderr, "Index lookup differs from the container lookup\n");
+      return EXIT_FAILURE;
+    }
+    std::printf("%10d %10zu %15.2f %15.2f %15.1f\n",
+                size,
+                numLookups,
+                1e9 * setSeconds / numLookups,
+                1e9 * indexSeconds / numLookups,
+                1e6 * buildSeconds);
+  }
+  return EXIT_SUCCESS;
+}
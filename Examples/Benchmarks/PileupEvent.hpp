@@ -0,0 +1,140 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Propagation/SurfaceIntersectionRecorder.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/AbortList.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/detail/StandardAborters.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+namespace FW {
+
+/// Generation parameters of the synthetic pile-up events.
+struct PileupEventConfig
+{
+  size_t pileup          = 200;
+  size_t tracksPerVertex = 25;
+  double etaMax          = 2.5;
+  double ptMin           = 0.5 * Acts::UnitConstants::GeV;
+  double ptMax           = 10 * Acts::UnitConstants::GeV;
+  double sigmaZ          = 50 * Acts::UnitConstants::mm;
+  double bz              = 2 * Acts::UnitConstants::T;
+};
+
+/// Generated charged track of a pile-up event.
+struct PileupTrack
+{
+  ActsFatras::Barcode particleId;
+  Acts::Vector3D      vertex;
+  Acts::Vector3D      momentum;
+  double              charge = 0;
+};
+
+/// Simulated hits for one pile-up event.
+///
+/// Charged tracks from vertices distributed along the beam line are
+/// propagated through the tracking geometry. Each crossing of a sensitive
+/// surface creates a hit without energy loss. The generated tracks are
+/// optionally returned as well, e.g. as truth for a fit.
+inline SimHitContainer
+makePileupEvent(
+    std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry,
+    const PileupEventConfig&                      cfg,
+    RandomEngine&                                 rng,
+    std::vector<PileupTrack>*                     tracks = nullptr)
+{
+  using Stepper    = Acts::EigenStepper<Acts::ConstantBField>;
+  using Propagator = Acts::Propagator<Stepper, Acts::Navigator>;
+  using Recorder   = SurfaceIntersectionRecorder;
+  using ActionList = Acts::ActionList<Recorder>;
+  using AbortList  = Acts::AbortList<Acts::detail::EndOfWorldReached>;
+  using PropagatorOptions = Acts::PropagatorOptions<ActionList, AbortList>;
+
+  Acts::Navigator navigator(std::move(trackingGeometry));
+  navigator.resolveSensitive = true;
+  navigator.resolveMaterial  = false;
+  navigator.resolvePassive   = false;
+  Propagator propagator(Stepper(Acts::ConstantBField(0, 0, cfg.bz)),
+                        std::move(navigator));
+
+  Acts::GeometryContext      geoContext;
+  Acts::MagneticFieldContext magFieldContext;
+
+  std::normal_distribution<double>       zDist(0, cfg.sigmaZ);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> etaDist(-cfg.etaMax, cfg.etaMax);
+  std::uniform_real_distribution<double> ptDist(cfg.ptMin, cfg.ptMax);
+  std::uniform_real_distribution<double> qDist(0., 1.);
+
+  SimHitContainer::sequence_type hits;
+  for (size_t ivtx = 0; ivtx < cfg.pileup; ++ivtx) {
+    const Acts::Vector3D vertex(0, 0, zDist(rng));
+    for (size_t itrk = 0; itrk < cfg.tracksPerVertex; ++itrk) {
+      const double         phi    = phiDist(rng);
+      const double         eta    = etaDist(rng);
+      const double         pt     = ptDist(rng);
+      const double         charge = qDist(rng) > 0.5 ? 1. : -1.;
+      const Acts::Vector3D momentum(
+          pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(eta));
+      const Acts::CurvilinearParameters start(
+          std::nullopt, vertex, momentum, charge, 0.0);
+
+      PropagatorOptions options(geoContext, magFieldContext);
+      options.loopProtection = true;
+      auto result            = propagator.propagate(start, options);
+      if (not result.ok()) { continue; }
+
+      const auto pid = ActsFatras::Barcode(0u)
+                           .setVertexPrimary(1u + ivtx)
+                           .setParticle(1u + itrk);
+      if (tracks) { tracks->push_back({pid, vertex, momentum, charge}); }
+      const auto& crossings
+          = result.value().get<Recorder::result_type>().intersections;
+      uint32_t index = 0;
+      for (const auto& crossing : crossings) {
+        if (crossing.geoId.sensitive() == 0) { continue; }
+        // the consumers only use the direction; neglect the mass
+        const double energy = crossing.momentum.norm();
+        ActsFatras::Hit::Vector4 pos4(crossing.position.x(),
+                                      crossing.position.y(),
+                                      crossing.position.z(),
+                                      0.0);
+        ActsFatras::Hit::Vector4 mom4(crossing.momentum.x(),
+                                      crossing.momentum.y(),
+                                      crossing.momentum.z(),
+                                      energy);
+        hits.emplace_back(crossing.geoId, pid, pos4, mom4, mom4, index++);
+      }
+    }
+  }
+  return makeGeometryIdMultiset(std::move(hits));
+}
+
+}  // namespace FW
@@ -0,0 +1,260 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/EventData/ProtoTrack.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/EventData/SpacePoints.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/TrackFinding/SeedingAlgorithm.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "PileupEvent.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Simulated event with the space points made from the truth hits.
+struct Event
+{
+  FW::SimHitContainer     hits;
+  FW::SpacePointContainer spacePoints;
+};
+
+/// Space points at the truth hit positions.
+///
+/// The measurement index is the hit index, i.e. the seed hits can be mapped
+/// directly to the generating particle.
+FW::SpacePointContainer
+makeSpacePoints(const FW::SimHitContainer&   hits,
+                const FW::SpacePointBinning& binning,
+                double                       sigma)
+{
+  std::vector<FW::SpacePoint> spacePoints;
+  spacePoints.reserve(hits.size());
+  for (std::size_t ihit = 0; ihit < hits.size(); ++ihit) {
+    const auto& pos = hits.nth(ihit)->position();
+
+    FW::SpacePoint sp;
+    sp.x                = pos.x();
+    sp.y                = pos.y();
+    sp.z                = pos.z();
+    sp.varianceR        = sigma * sigma;
+    sp.varianceZ        = sigma * sigma;
+    sp.measurementIndex = ihit;
+    spacePoints.push_back(sp);
+  }
+  return FW::SpacePointContainer(binning, spacePoints);
+}
+
+/// Seeding timing and performance for one seeder and pile-up value.
+struct Measurement
+{
+  double seconds         = 0;
+  size_t seeds           = 0;
+  size_t fakeSeeds       = 0;
+  size_t particles       = 0;
+  size_t seededParticles = 0;
+};
+
+/// Run the seeding on all events and compare the seeds to the truth.
+///
+/// A seed is true if all its hits originate from the same particle and fake
+/// otherwise. Particles with at least three hits are considered seedable;
+/// they are seeded if at least one true seed was found for them.
+Measurement
+seedEvents(const FW::SeedingAlgorithm&         seeding,
+           const FW::SeedingAlgorithm::Config& cfg,
+           const std::vector<Event>&           events)
+{
+  Measurement measurement;
+  for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+    const auto& event = events[ievent];
+
+    FW::WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    // the input copy is not part of the measurement
+    store.add(cfg.inputSpacePoints, FW::SpacePointContainer(event.spacePoints));
+    FW::AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (seeding.execute(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Seeding failed");
+    }
+    measurement.seconds
+        += std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::unordered_map<ActsFatras::Barcode::Value, size_t> numHits;
+    std::unordered_set<ActsFatras::Barcode::Value>         seeded;
+    for (const auto& hit : event.hits) {
+      numHits[hit.particleId().value()] += 1;
+    }
+
+    const auto& seeds
+        = store.get<FW::ProtoTrackContainer>(cfg.outputProtoTracks);
+    for (const auto& seed : seeds) {
+      const auto pid    = event.hits.nth(seed.front())->particleId();
+      bool       isTrue = true;
+      for (auto ihit : seed) {
+        isTrue = isTrue and (event.hits.nth(ihit)->particleId() == pid);
+      }
+      if (isTrue) {
+        seeded.insert(pid.value());
+      } else {
+        measurement.fakeSeeds += 1;
+      }
+    }
+    measurement.seeds += seeds.size();
+    for (const auto& [pid, n] : numHits) {
+      if (n < 3) { continue; }
+      measurement.particles += 1;
+      measurement.seededParticles += seeded.count(pid);
+    }
+  }
+  return measurement;
+}
+
+}  // namespace
+
+/// Seeding benchmark executable
+///
+/// Synthetic pile-up events are simulated in the generic detector as for the
+/// digitization benchmark and space points are created at the truth hit
+/// positions. The built-in triplet search and the Acts seed finder run with
+/// the same requirements on the same events for each requested pile-up
+/// value. For each seeder the time per event, the seeds per event, the
+/// seeding efficiency, i.e. the fraction of particles with at least three
+/// hits and at least one true seed, and the fraction of fake seeds, i.e.
+/// seeds with hits from more than one particle, are printed in a table.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-pileup",
+      value<read_series>()->multitoken()->default_value({10, 50, 100, 200}),
+      "Pile-up values to benchmark, i.e. vertices per event")(
+      "bench-events",
+      value<size_t>()->default_value(10),
+      "Number of seeded events per pile-up value")(
+      "bench-tracks-per-vertex",
+      value<size_t>()->default_value(25),
+      "Number of charged tracks per vertex")(
+      "bench-eta-max",
+      value<double>()->default_value(2.5),
+      "Maximum absolute pseudorapidity of the tracks")(
+      "bench-pt",
+      value<read_range>()->multitoken()->default_value({0.5, 10}),
+      "Transverse momentum range of the tracks [in GeV]")(
+      "bench-bz",
+      value<double>()->default_value(2),
+      "Magnetic field along z [in T]")(
+      "bench-sigma",
+      value<double>()->default_value(0.05),
+      "Space point position uncertainty [in mm]");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto pileups   = vm["bench-pileup"].as<read_series>();
+  auto nEvents   = vm["bench-events"].as<size_t>();
+  auto ptRange   = vm["bench-pt"].as<read_range>();
+  auto sigma     = vm["bench-sigma"].as<double>() * 1_mm;
+  auto logLevel  = FW::Options::readLogLevel(vm);
+  auto rndConfig = FW::Options::readRandomNumbersConfig(vm);
+
+  FW::PileupEventConfig eventCfg;
+  eventCfg.tracksPerVertex = vm["bench-tracks-per-vertex"].as<size_t>();
+  eventCfg.etaMax          = vm["bench-eta-max"].as<double>();
+  eventCfg.bz              = vm["bench-bz"].as<double>() * 1_T;
+  if ((nEvents == 0) or (ptRange.size() != 2)) {
+    std::fprintf(stderr, "Invalid number of events or momentum range\n");
+    return EXIT_FAILURE;
+  }
+  eventCfg.ptMin = ptRange[0] * 1_GeV;
+  eventCfg.ptMax = ptRange[1] * 1_GeV;
+
+  auto trackingGeometry = FW::Geometry::build(vm, detector).first;
+
+  FW::SeedingAlgorithm::Config seedingCfg;
+  seedingCfg.inputSpacePoints        = "spacepoints";
+  seedingCfg.outputProtoTracks       = "seeds";
+  seedingCfg.outputInitialParameters = "seedparameters";
+  seedingCfg.bFieldInZ               = eventCfg.bz;
+  seedingCfg.minPt                   = eventCfg.ptMin;
+
+  std::printf("%-8s %8s %12s %12s %10s %10s\n",
+              "seeder",
+              "pileup",
+              "ms/event",
+              "seeds/event",
+              "eff[%]",
+              "fake[%]");
+  for (auto pileup : pileups) {
+    if (pileup <= 0) {
+      std::fprintf(stderr, "Invalid pile-up %d\n", pileup);
+      return EXIT_FAILURE;
+    }
+    eventCfg.pileup = pileup;
+
+    // the same events are seeded with both seeders
+    FW::RandomEngine   rng(rndConfig.seed);
+    std::vector<Event> events;
+    for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+      Event event;
+      event.hits = FW::makePileupEvent(trackingGeometry, eventCfg, rng);
+      event.spacePoints
+          = makeSpacePoints(event.hits, FW::SpacePointBinning(), sigma);
+      events.push_back(std::move(event));
+    }
+
+    for (bool useActs : {false, true}) {
+      seedingCfg.useActsSeedfinder = useActs;
+      FW::SeedingAlgorithm seeding(seedingCfg, logLevel);
+
+      const auto m = seedEvents(seeding, seedingCfg, events);
+      std::printf("%-8s %8d %12.2f %12.1f %10.2f %10.2f\n",
+                  useActs ? "acts" : "triplet",
+                  pileup,
+                  1e3 * m.seconds / nEvents,
+                  double(m.seeds) / nEvents,
+                  100. * m.seededParticles / std::max<size_t>(m.particles, 1u),
+                  100. * m.fakeSeeds / std::max<size_t>(m.seeds, 1u));
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include "ACTFW/Digitization/DigitizationAlgorithm.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
+#include "ACTFW/EventData/SimHit.hpp"
+#include "ACTFW/EventData/SpacePoints.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/TrackFinding/SpacePointMaker.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/Plugins/Digitization/PlanarModuleStepper.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "PileupEvent.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Space point formation timing for one pile-up value.
+///
+/// The first event is recorded separately since it runs with cold caches,
+/// e.g. for the surface transforms.
+struct Measurement
+{
+  double firstSeconds  = 0;
+  size_t firstClusters = 0;
+  double seconds       = 0;
+  size_t clusters      = 0;
+  size_t spacePoints   = 0;
+};
+
+/// Digitize the simulated hits of one event into merged clusters.
+FW::PlanarClusterContainer
+digitizeEvent(const FW::DigitizationAlgorithm& digitization,
+              FW::SimHitContainer              hits,
+              size_t                           ievent)
+{
+  FW::WhiteBoard store(
+      Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+  store.add("hits", std::move(hits));
+  FW::AlgorithmContext ctx(0, ievent, store);
+  if (digitization.execute(ctx) != FW::ProcessCode::SUCCESS) {
+    throw std::runtime_error("Digitization failed");
+  }
+  return store.pop<FW::PlanarClusterContainer>("clusters");
+}
+
+/// Run the space point maker on all events and measure the time of execute.
+Measurement
+makeSpacePoints(const FW::SpacePointMaker&                     spacePointMaker,
+                const std::vector<FW::PlanarClusterContainer>& events)
+{
+  Measurement measurement;
+  for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+    FW::WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    // the input copy is not part of the measurement
+    store.add("clusters", FW::PlanarClusterContainer(events[ievent]));
+    FW::AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (spacePointMaker.execute(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Space point formation failed");
+    }
+    const double seconds
+        = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (ievent == 0) {
+      measurement.firstSeconds  = seconds;
+      measurement.firstClusters = events[ievent].size();
+    } else {
+      measurement.seconds += seconds;
+      measurement.clusters += events[ievent].size();
+    }
+    measurement.spacePoints
+        += store.get<FW::SpacePointContainer>("spacepoints").size();
+  }
+  return measurement;
+}
+
+}  // namespace
+
+/// Space point formation throughput benchmark executable
+///
+/// Synthetic pile-up events are simulated in the generic detector as for the
+/// digitization benchmark and digitized with the merged clustering. The space
+/// point maker then converts the clusters of each event into binned space
+/// points. Only the execution of the space point maker is timed; the event
+/// simulation, the digitization, and the event store setup are not part of
+/// the measurement.
+///
+/// For each pile-up value, the time of the first event is printed separately.
+/// The time per event and the cluster throughput are averaged over the
+/// remaining events. The number of clusters and space points per event are
+/// averaged over all events.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-events",
+      value<size_t>()->default_value(10),
+      "Number of events per pile-up value")(
+      "bench-pileup",
+      value<read_series>()->multitoken()->default_value({50, 100, 200}),
+      "Pile-up values, i.e. number of vertices per event")(
+      "bench-tracks-per-vertex",
+      value<size_t>()->default_value(25),
+      "Number of charged tracks per vertex")(
+      "bench-eta-max",
+      value<double>()->default_value(2.5),
+      "Maximum absolute pseudorapidity of the tracks")(
+      "bench-pt",
+      value<read_range>()->multitoken()->default_value({0.5, 10}),
+      "Transverse momentum range of the tracks [in GeV]")(
+      "bench-bz",
+      value<double>()->default_value(2),
+      "Magnetic field along z [in T]")(
+      "bench-phi-bins",
+      value<size_t>()->default_value(64),
+      "Number of space point bins in phi")(
+      "bench-z-bins",
+      value<size_t>()->default_value(16),
+      "Number of space point bins in z");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto nEvents   = vm["bench-events"].as<size_t>();
+  auto pileups   = vm["bench-pileup"].as<read_series>();
+  auto ptRange   = vm["bench-pt"].as<read_range>();
+  auto logLevel  = FW::Options::readLogLevel(vm);
+  auto rndConfig = FW::Options::readRandomNumbersConfig(vm);
+
+  FW::PileupEventConfig eventCfg;
+  eventCfg.tracksPerVertex = vm["bench-tracks-per-vertex"].as<size_t>();
+  eventCfg.etaMax          = vm["bench-eta-max"].as<double>();
+  eventCfg.bz              = vm["bench-bz"].as<double>() * 1_T;
+  if ((nEvents < 2) or (ptRange.size() != 2)) {
+    std::fprintf(stderr, "At least two events and a momentum range needed\n");
+    return EXIT_FAILURE;
+  }
+  for (auto pileup : pileups) {
+    if (pileup < 1) {
+      std::fprintf(stderr, "Invalid pile-up value %d\n", pileup);
+      return EXIT_FAILURE;
+    }
+  }
+  eventCfg.ptMin = ptRange[0] * 1_GeV;
+  eventCfg.ptMax = ptRange[1] * 1_GeV;
+
+  auto trackingGeometry = FW::Geometry::build(vm, detector).first;
+
+  FW::DigitizationAlgorithm::Config digiCfg;
+  digiCfg.inputSimulatedHits  = "hits";
+  digiCfg.outputClusters      = "clusters";
+  digiCfg.mergeHits           = true;
+  digiCfg.planarModuleStepper = std::make_shared<Acts::PlanarModuleStepper>(
+      Acts::getDefaultLogger("PlanarModuleStepper", logLevel));
+  digiCfg.randomNumbers    = std::make_shared<FW::RandomNumbers>(rndConfig);
+  digiCfg.trackingGeometry = trackingGeometry;
+  FW::DigitizationAlgorithm digitization(digiCfg, logLevel);
+
+  FW::SpacePointMaker::Config spacePointCfg;
+  spacePointCfg.inputClusters      = digiCfg.outputClusters;
+  spacePointCfg.outputSpacePoints  = "spacepoints";
+  spacePointCfg.binning.numPhiBins = vm["bench-phi-bins"].as<size_t>();
+  spacePointCfg.binning.numZBins   = vm["bench-z-bins"].as<size_t>();
+  FW::SpacePointMaker spacePointMaker(spacePointCfg, logLevel);
+
+  std::printf("%8s %15s %12s %12s %12s %18s\n",
+              "pileup",
+              "clusters/event",
+              "first[ms]",
+              "ms/event",
+              "Mclusters/s",
+              "spacepoints/event");
+  FW::RandomEngine rng(rndConfig.seed);
+  for (auto pileup : pileups) {
+    eventCfg.pileup = pileup;
+
+    std::vector<FW::PlanarClusterContainer> events;
+    for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+      events.push_back(digitizeEvent(
+          digitization,
+          FW::makePileupEvent(trackingGeometry, eventCfg, rng),
+          ievent));
+    }
+
+    const auto measurement = makeSpacePoints(spacePointMaker, events);
+    const auto nReused     = nEvents - 1;
+    std::printf(
+        "%8zu %15.1f %12.3f %12.3f %12.3f %18.1f\n",
+        eventCfg.pileup,
+        double(measurement.firstClusters + measurement.clusters) / nEvents,
+        1e3 * measurement.firstSeconds,
+        1e3 * measurement.seconds / nReused,
+        1e-6 * measurement.clusters / measurement.seconds,
+        double(measurement.spacePoints) / nEvents);
+  }
+  return EXIT_SUCCESS;
+}
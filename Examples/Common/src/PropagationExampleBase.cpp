@@ -24,6 +24,7 @@
 #include "ACTFW/Framework/Sequencer.hpp"
 #include "ACTFW/Geometry/CommonGeometry.hpp"
 #include "ACTFW/Io/Root/RootPropagationStepsWriter.hpp"
+#include "ACTFW/Io/Root/RootSurfaceIntersectionWriter.hpp"
 #include "ACTFW/Options/CommonOptions.hpp"
 #include "ACTFW/Plugins/BField/BFieldOptions.hpp"
 #include "ACTFW/Plugins/BField/ScalableBField.hpp"
@@ -121,7 +122,10 @@ propagationExample(int argc, char* argv[], FW::IBaseDetector& detector)
   std::string outputDir    = vm["output-dir"].template as<std::string>();
   auto        psCollection = vm["prop-step-collection"].as<std::string>();
 
-  if (vm["output-root"].template as<bool>()) {
+  // steps are only recorded in the step logging mode
+  bool writeSteps = (vm["prop-mode"].template as<int>() == 0);
+
+  if (writeSteps and vm["output-root"].template as<bool>()) {
     // Write the propagation steps as ROOT TTree
     FW::RootPropagationStepsWriter::Config pstepWriterRootConfig;
     pstepWriterRootConfig.collection = psCollection;
@@ -131,7 +135,7 @@ propagationExample(int argc, char* argv[], FW::IBaseDetector& detector)
         pstepWriterRootConfig));
   }
 
-  if (vm["output-obj"].template as<bool>()) {
+  if (writeSteps and vm["output-obj"].template as<bool>()) {
     using PropagationSteps = Acts::detail::Step;
     using ObjPropagationStepsWriter
         = FW::Obj::ObjPropagationStepsWriter<PropagationSteps>;
@@ -144,5 +148,21 @@ propagationExample(int argc, char* argv[], FW::IBaseDetector& detector)
         std::make_shared<ObjPropagationStepsWriter>(pstepWriterObjConfig));
   }
 
+  // surface intersections are only recorded in the surface mode
+  bool writeIntersections = (vm["prop-mode"].template as<int>() == 1);
+
+  if (writeIntersections and vm["output-root"].template as<bool>()) {
+    auto isCollection
+        = vm["prop-intersection-collection"].template as<std::string>();
+
+    // Write the surface intersections as ROOT TTree
+    FW::RootSurfaceIntersectionWriter::Config intersectionWriterRootConfig;
+    intersectionWriterRootConfig.collection = isCollection;
+    intersectionWriterRootConfig.filePath
+        = FW::joinPaths(outputDir, isCollection + ".root");
+    sequencer.addWriter(std::make_shared<FW::RootSurfaceIntersectionWriter>(
+        intersectionWriterRootConfig));
+  }
+
   return sequencer.run();
 }
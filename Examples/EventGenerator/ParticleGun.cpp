@@ -53,6 +53,7 @@ main(int argc, char* argv[])
   FlattenEvent::Config flatten;
   flatten.inputEvent      = evgenCfg.output;
   flatten.outputParticles = "particles";
+  flatten.consumeEvent    = true;
   sequencer.addAlgorithm(std::make_shared<FlattenEvent>(flatten, logLevel));
 
   // print generated particles
@@ -66,6 +66,7 @@ main(int argc, char* argv[])
   FlattenEvent::Config flatten;
   flatten.inputEvent      = selectorCfg.outputEvent;
   flatten.outputParticles = "particles";
+  flatten.consumeEvent    = true;
   sequencer.addAlgorithm(std::make_shared<FlattenEvent>(flatten, logLevel));
 
   // print generated particles
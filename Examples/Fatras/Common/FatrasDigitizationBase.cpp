@@ -11,6 +11,7 @@
 #include <boost/program_options.hpp>
 
 #include "ACTFW/Digitization/DigitizationAlgorithm.hpp"
+#include "ACTFW/Digitization/Resolution.hpp"
 #include "ACTFW/Framework/RandomNumbers.hpp"
 #include "ACTFW/Framework/Sequencer.hpp"
 #include "ACTFW/Io/Csv/CsvPlanarClusterWriter.hpp"
@@ -37,6 +38,12 @@ FW::setupDigitization(
       Acts::getDefaultLogger("PlanarModuleStepper", logLevel));
   digi.randomNumbers    = randomNumbers;
   digi.trackingGeometry = trackingGeometry;
+  digi.mergeHits        = vars["digi-merge-hits"].template as<bool>();
+
+  auto resolutionFile = vars["digi-resolution-file"].template as<std::string>();
+  if (not resolutionFile.empty()) {
+    digi.resolutions = FW::readResolutionMap(resolutionFile);
+  }
   sequencer.addAlgorithm(
       std::make_shared<FW::DigitizationAlgorithm>(digi, logLevel));
 
@@ -51,6 +51,14 @@ FW::fatrasMain(int                                argc,
   desc.add_options()("evg-input-type",
                      value<std::string>()->default_value("pythia8"),
                      "Type of evgen input 'gun', 'pythia8'");
+  desc.add_options()(
+      "digi-merge-hits",
+      value<bool>()->default_value(false),
+      "Merge cells from all hits on a module into connected clusters");
+  desc.add_options()(
+      "digi-resolution-file",
+      value<std::string>()->default_value(""),
+      "CSV file with cluster resolutions per volume/layer/module");
   // Add specific options for this geometry
   detector->addOptions(desc);
   auto vm = FW::Options::parse(desc, argc, argv);
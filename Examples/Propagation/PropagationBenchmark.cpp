@@ -0,0 +1,832 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <tbb/global_control.h>
+
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Io/Root/RootPropagationStepsWriter.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Plugins/BField/BFieldOptions.hpp"
+#include "ACTFW/Propagation/PropagationAlgorithm.hpp"
+#include "ACTFW/Propagation/StepRecorder.hpp"
+#include "ACTFW/Propagation/SurfaceIntersectionRecorder.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "ACTFW/Utilities/Paths.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/Geometry/TrackingGeometry.hpp"
+#include "Acts/MagneticField/BFieldMapUtils.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/InterpolatedBFieldMap.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/MagneticField/SharedBField.hpp"
+#include "Acts/Propagator/AbortList.hpp"
+#include "Acts/Propagator/ActionList.hpp"
+#include "Acts/Propagator/AtlasStepper.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Navigator.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Propagator/StraightLineStepper.hpp"
+#include "Acts/Propagator/detail/StandardAborters.hpp"
+#include "Acts/Utilities/Logger.hpp"
+#include "Acts/Utilities/Units.hpp"
+
+using namespace Acts::UnitLiterals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Navigator wrapper that measures the time spent within the navigation.
+///
+/// The clock calls add a small overhead to each step. The time per step is
+/// therefore measured in a separate run with the plain navigator.
+struct TimedNavigator
+{
+  using state_type = Acts::Navigator::state_type;
+  using State      = Acts::Navigator::State;
+
+  Acts::Navigator navigator;
+  double*         seconds;
+
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  status(propagator_state_t& state, const stepper_t& stepper) const
+  {
+    const auto start = Clock::now();
+    navigator.status(state, stepper);
+    *seconds += std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  template <typename propagator_state_t, typename stepper_t>
+  void
+  target(propagator_state_t& state, const stepper_t& stepper) const
+  {
+    const auto start = Clock::now();
+    navigator.target(state, stepper);
+    *seconds += std::chrono::duration<double>(Clock::now() - start).count();
+  }
+};
+
+/// Test tracks for one momentum and pseudo-rapidity range.
+struct TrackSample
+{
+  double                                   pt;
+  std::pair<double, double>                etaRange;
+  std::vector<Acts::CurvilinearParameters> tracks;
+};
+
+/// Common setup for all benchmark runs.
+struct Setup
+{
+  std::shared_ptr<const Acts::TrackingGeometry> trackingGeometry;
+  Acts::GeometryContext                         geoContext;
+  Acts::MagneticFieldContext                    magFieldContext;
+  std::vector<TrackSample>                      samples;
+  double                                        maxStepSize;
+  double                                        ptLoopers;
+  std::string                                   outputDir;
+};
+
+/// Timing of one configuration and track sample.
+struct Measurement
+{
+  double seconds      = 0;
+  size_t steps        = 0;
+  size_t failures     = 0;
+  size_t bytes        = 0;
+  double writeSeconds = 0;
+};
+
+/// Memory used by the recorded steps, without the referenced surfaces.
+size_t
+recordedBytes(const FW::StepRecorder::result_type& result)
+{
+  return result.steps.size() * sizeof(Acts::detail::Step);
+}
+
+/// Memory used by the recorded surface intersections.
+size_t
+recordedBytes(const FW::SurfaceIntersectionRecorder::result_type& result)
+{
+  return result.intersections.size() * sizeof(FW::SurfaceIntersection);
+}
+
+/// Propagate all tracks of a sample until they leave the world.
+template <typename stepper_t, typename navigator_t>
+Measurement
+propagateSample(const Setup&       setup,
+                const TrackSample& sample,
+                stepper_t          stepper,
+                navigator_t        navigator)
+{
+  using Propagator = Acts::Propagator<stepper_t, navigator_t>;
+  using ActionList = Acts::ActionList<>;
+  using AbortList  = Acts::AbortList<Acts::detail::EndOfWorldReached>;
+  using PropagatorOptions = Acts::PropagatorOptions<ActionList, AbortList>;
+
+  Propagator propagator(std::move(stepper), std::move(navigator));
+
+  Measurement measurement;
+  const auto  start = Clock::now();
+  for (const auto& track : sample.tracks) {
+    PropagatorOptions options(setup.geoContext, setup.magFieldContext);
+    options.maxStepSize    = setup.maxStepSize;
+    options.loopProtection = (sample.pt < setup.ptLoopers);
+    auto result            = propagator.propagate(track, options);
+    if (result.ok()) {
+      measurement.steps += result.value().steps;
+    } else {
+      ++measurement.failures;
+    }
+  }
+  measurement.seconds
+      = std::chrono::duration<double>(Clock::now() - start).count();
+  return measurement;
+}
+
+/// Recorder results of all tracks in a sample.
+template <typename recorder_t>
+using Results = std::vector<typename recorder_t::result_type>;
+
+/// Write the recorded steps of a sample as one event to a ROOT file.
+///
+/// Only the event write and the tree write at the end of the run are timed;
+/// opening the output file is not part of the measurement.
+double
+writeSteps(std::vector<FW::PropagationSteps> steps, const std::string& path)
+{
+  FW::RootPropagationStepsWriter::Config writerCfg;
+  writerCfg.collection = "steps";
+  writerCfg.filePath   = path;
+  FW::RootPropagationStepsWriter writer(writerCfg, Acts::Logging::WARNING);
+
+  FW::WhiteBoard store(
+      Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+  store.add(writerCfg.collection, std::move(steps));
+  FW::AlgorithmContext ctx(0, 0, store);
+
+  const auto start = Clock::now();
+  if ((writer.write(ctx) != FW::ProcessCode::SUCCESS)
+      or (writer.endRun() != FW::ProcessCode::SUCCESS)) {
+    throw std::runtime_error("Writing the propagation steps failed");
+  }
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// Propagate all tracks of a sample until they leave the world and record
+/// the output with the given recorder.
+///
+/// The recorder results are appended to the given container, if any.
+template <typename stepper_t, typename recorder_t>
+Measurement
+recordSample(const Setup&         setup,
+             const TrackSample&   sample,
+             stepper_t            stepper,
+             Acts::Navigator      navigator,
+             const recorder_t&    recorder,
+             Results<recorder_t>* results = nullptr)
+{
+  using Propagator = Acts::Propagator<stepper_t, Acts::Navigator>;
+  using ActionList = Acts::ActionList<recorder_t>;
+  using AbortList  = Acts::AbortList<Acts::detail::EndOfWorldReached>;
+  using PropagatorOptions = Acts::PropagatorOptions<ActionList, AbortList>;
+
+  Propagator propagator(std::move(stepper), std::move(navigator));
+
+  Measurement measurement;
+  const auto  start = Clock::now();
+  for (const auto& track : sample.tracks) {
+    PropagatorOptions options(setup.geoContext, setup.magFieldContext);
+    options.actionList.template get<recorder_t>() = recorder;
+
+    options.maxStepSize    = setup.maxStepSize;
+    options.loopProtection = (sample.pt < setup.ptLoopers);
+    auto result            = propagator.propagate(track, options);
+    if (result.ok()) {
+      auto& recorded
+          = result.value().template get<typename recorder_t::result_type>();
+      measurement.steps += result.value().steps;
+      measurement.bytes += recordedBytes(recorded);
+      if (results) { results->push_back(std::move(recorded)); }
+    } else {
+      ++measurement.failures;
+    }
+  }
+  measurement.seconds
+      = std::chrono::duration<double>(Clock::now() - start).count();
+  return measurement;
+}
+
+/// Record the steps of a sample with the given recorder and write them.
+template <typename stepper_t>
+Measurement
+recordSteps(const Setup&            setup,
+            const TrackSample&      sample,
+            const stepper_t&        stepper,
+            const Acts::Navigator&  navigator,
+            const FW::StepRecorder& recorder,
+            const std::string&      name)
+{
+  Results<FW::StepRecorder> results;
+  auto measurement
+      = recordSample(setup, sample, stepper, navigator, recorder, &results);
+
+  std::vector<FW::PropagationSteps> steps;
+  steps.reserve(results.size());
+  for (auto& result : results) {
+    steps.push_back(FW::StepRecorder::takeSteps(result));
+  }
+  measurement.writeSeconds = writeSteps(
+      std::move(steps),
+      FW::joinPaths(setup.outputDir, "propagation_steps_" + name + ".root"));
+  return measurement;
+}
+
+/// Benchmark the step recording modes against the surface recording.
+///
+/// The step modes correspond to the step recording options of the
+/// propagation algorithm; the surface mode has no writer.
+template <typename stepper_t>
+void
+benchmarkRecording(const Setup& setup, const stepper_t& stepper)
+{
+  Acts::Navigator navigator(setup.trackingGeometry);
+  navigator.resolveSensitive = true;
+  navigator.resolveMaterial  = true;
+  navigator.resolvePassive   = false;
+
+  // only one surface type and no other steps
+  FW::StepRecorder sensitiveSteps;
+  sensitiveSteps.material   = false;
+  sensitiveSteps.boundary   = false;
+  sensitiveSteps.decimation = 0;
+  FW::StepRecorder materialSteps;
+  materialSteps.sensitive  = false;
+  materialSteps.boundary   = false;
+  materialSteps.decimation = 0;
+  // all surfaces and a fraction of the other steps
+  FW::StepRecorder decimatedSteps;
+  decimatedSteps.decimation = 10;
+  // all steps, but only the last ones of each track
+  FW::StepRecorder lastSteps;
+  lastSteps.maxSteps = 10;
+
+  const std::pair<const char*, FW::StepRecorder> stepModes[] = {
+      {"all", FW::StepRecorder()},
+      {"sensitive", sensitiveSteps},
+      {"material", materialSteps},
+      {"decimated", decimatedSteps},
+      {"last-10", lastSteps},
+  };
+
+  for (const auto& sample : setup.samples) {
+    std::vector<std::pair<const char*, Measurement>> measurements;
+    measurements.emplace_back(
+        "none", propagateSample(setup, sample, stepper, navigator));
+    for (const auto& [name, recorder] : stepModes) {
+      measurements.emplace_back(
+          name, recordSteps(setup, sample, stepper, navigator, recorder, name));
+    }
+    measurements.emplace_back("surfaces",
+                              recordSample(setup,
+                                           sample,
+                                           stepper,
+                                           navigator,
+                                           FW::SurfaceIntersectionRecorder()));
+
+    for (const auto& [recording, measurement] : measurements) {
+      const auto nTracks = sample.tracks.size();
+      std::printf("%-9s %8.2f %5.2f-%-5.2f %10.2f %10.2f %13.2f %6zu\n",
+                  recording,
+                  sample.pt / 1_GeV,
+                  sample.etaRange.first,
+                  sample.etaRange.second,
+                  1e6 * measurement.seconds / nTracks,
+                  double(measurement.bytes) / nTracks / 1024,
+                  1e6 * measurement.writeSeconds / nTracks,
+                  measurement.failures);
+    }
+  }
+}
+
+/// Benchmark a stepper for all samples with and without surface resolution.
+template <typename stepper_t>
+void
+benchmarkStepper(const Setup&       setup,
+                 const std::string& fieldName,
+                 const std::string& stepperName,
+                 const stepper_t&   stepper)
+{
+  for (bool resolve : {true, false}) {
+    Acts::Navigator navigator(setup.trackingGeometry);
+    navigator.resolveSensitive = resolve;
+    navigator.resolveMaterial  = resolve;
+    navigator.resolvePassive   = false;
+
+    for (const auto& sample : setup.samples) {
+      // the instrumented run is only used for the navigation share
+      double navSeconds   = 0;
+      auto   instrumented = propagateSample(
+          setup, sample, stepper, TimedNavigator{navigator, &navSeconds});
+      auto measurement = propagateSample(setup, sample, stepper, navigator);
+
+      const auto nSteps  = std::max<size_t>(measurement.steps, 1u);
+      const auto nTracks = sample.tracks.size();
+      std::printf("%-8s %-13s %-8s %8.2f %5.2f-%-5.2f %10.1f %12.1f %8.1f",
+                  fieldName.c_str(),
+                  stepperName.c_str(),
+                  resolve ? "all" : "boundary",
+                  sample.pt / 1_GeV,
+                  sample.etaRange.first,
+                  sample.etaRange.second,
+                  1e9 * measurement.seconds / nSteps,
+                  double(measurement.steps) / nTracks,
+                  100 * navSeconds / instrumented.seconds);
+      std::printf(" %6zu\n", measurement.failures);
+    }
+  }
+}
+
+/// Benchmark all field-dependent steppers for a given magnetic field.
+template <typename field_t>
+void
+benchmarkField(const Setup&             setup,
+               const std::string&       fieldName,
+               std::shared_ptr<field_t> field)
+{
+  using SharedField = Acts::SharedBField<field_t>;
+  benchmarkStepper(setup,
+                   fieldName,
+                   "EigenStepper",
+                   Acts::EigenStepper<SharedField>(SharedField(field)));
+  benchmarkStepper(setup,
+                   fieldName,
+                   "AtlasStepper",
+                   Acts::AtlasStepper<SharedField>(SharedField(field)));
+}
+
+/// Event outputs of the propagation algorithm.
+struct PropagationEvent
+{
+  std::vector<FW::PropagationSteps>      steps;
+  std::vector<FW::RecordedMaterialTrack> material;
+};
+
+/// Bitwise comparison, i.e. also for NaN and signed zeros.
+bool
+sameBits(double lhs, double rhs)
+{
+  return std::memcmp(&lhs, &rhs, sizeof(double)) == 0;
+}
+
+/// Bitwise comparison of all vector components.
+bool
+sameBits(const Acts::Vector3D& lhs, const Acts::Vector3D& rhs)
+{
+  return std::memcmp(lhs.data(), rhs.data(), 3 * sizeof(double)) == 0;
+}
+
+/// Compare the recorded steps of one test.
+bool
+sameSteps(const FW::PropagationSteps& lhs, const FW::PropagationSteps& rhs)
+{
+  using Acts::ConstrainedStep;
+
+  if (lhs.size() != rhs.size()) { return false; }
+  for (size_t istep = 0; istep < lhs.size(); ++istep) {
+    const auto& lstep = lhs[istep];
+    const auto& rstep = rhs[istep];
+    for (auto type : {ConstrainedStep::accuracy,
+                      ConstrainedStep::actor,
+                      ConstrainedStep::aborter,
+                      ConstrainedStep::user}) {
+      if (not sameBits(lstep.stepSize.value(type),
+                       rstep.stepSize.value(type))) {
+        return false;
+      }
+    }
+    if (not sameBits(lstep.position, rstep.position)
+        or not sameBits(lstep.momentum, rstep.momentum)
+        or (lstep.surface != rstep.surface) or (lstep.volume != rstep.volume)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Compare one recorded material track.
+bool
+sameMaterial(const FW::RecordedMaterialTrack& lhs,
+             const FW::RecordedMaterialTrack& rhs)
+{
+  const auto& lmat = lhs.second;
+  const auto& rmat = rhs.second;
+  if (not sameBits(lhs.first.first, rhs.first.first)
+      or not sameBits(lhs.first.second, rhs.first.second)
+      or not sameBits(lmat.materialInX0, rmat.materialInX0)
+      or not sameBits(lmat.materialInL0, rmat.materialInL0)
+      or (lmat.materialInteractions.size()
+          != rmat.materialInteractions.size())) {
+    return false;
+  }
+  for (size_t iint = 0; iint < lmat.materialInteractions.size(); ++iint) {
+    const auto& lint   = lmat.materialInteractions[iint];
+    const auto& rint   = rmat.materialInteractions[iint];
+    const auto& lprops = lint.materialProperties;
+    const auto& rprops = rint.materialProperties;
+    if (not sameBits(lint.position, rint.position)
+        or not sameBits(lint.direction, rint.direction)
+        or not sameBits(lint.pathCorrection, rint.pathCorrection)
+        or (lint.surface != rint.surface)
+        or not sameBits(lprops.thickness(), rprops.thickness())
+        or not sameBits(lprops.material().X0(), rprops.material().X0())
+        or not sameBits(lprops.material().L0(), rprops.material().L0())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Compare the step and material collections of one event.
+bool
+sameEvent(const PropagationEvent& lhs, const PropagationEvent& rhs)
+{
+  return std::equal(lhs.steps.begin(),
+                    lhs.steps.end(),
+                    rhs.steps.begin(),
+                    rhs.steps.end(),
+                    sameSteps)
+      and std::equal(lhs.material.begin(),
+                     lhs.material.end(),
+                     rhs.material.begin(),
+                     rhs.material.end(),
+                     sameMaterial);
+}
+
+/// Run the propagation algorithm on all events and measure the time of
+/// execute. The outputs of each event are taken from the event store.
+template <typename propagator_t>
+double
+runPropagation(
+    const FW::PropagationAlgorithm<propagator_t>&                  algorithm,
+    const typename FW::PropagationAlgorithm<propagator_t>::Config& cfg,
+    size_t                                                         nEvents,
+    std::vector<PropagationEvent>&                                 events)
+{
+  double seconds = 0;
+  events.clear();
+  for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+    FW::WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    FW::AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (algorithm.execute(ctx) != FW::ProcessCode::SUCCESS) {
+      throw std::runtime_error("Test propagation failed");
+    }
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+
+    PropagationEvent event;
+    event.steps = store.pop<std::vector<FW::PropagationSteps>>(
+        cfg.propagationStepCollection);
+    event.material = store.pop<std::vector<FW::RecordedMaterialTrack>>(
+        cfg.propagationMaterialCollection);
+    events.push_back(std::move(event));
+  }
+  return seconds;
+}
+
+/// Benchmark the parallel tests within an event against the serial mode.
+///
+/// The parallel mode runs once for each maximum number of threads. The step
+/// and material collections of every event are compared bitwise to the
+/// serial run.
+///
+/// @return Whether all thread counts reproduce the serial output
+template <typename propagator_t>
+bool
+benchmarkParallel(
+    typename FW::PropagationAlgorithm<propagator_t>::Config cfg,
+    size_t                                                  nEvents,
+    size_t                                                  minTestsPerTask,
+    const std::vector<int>&                                 threads)
+{
+  using Algorithm = FW::PropagationAlgorithm<propagator_t>;
+
+  // the serial mode is the reference for all thread counts
+  cfg.minTestsPerTask = 0;
+  std::vector<PropagationEvent> reference;
+  const double                  serialSeconds = runPropagation(
+      Algorithm(cfg, Acts::Logging::WARNING), cfg, nEvents, reference);
+  std::printf("%-8s %7d %10.3f %8.2f %9s\n",
+              "serial",
+              1,
+              1e3 * serialSeconds / nEvents,
+              1.,
+              "reference");
+
+  cfg.minTestsPerTask = minTestsPerTask;
+  Algorithm parallel(cfg, Acts::Logging::WARNING);
+
+  bool identical = true;
+  for (auto nThreads : threads) {
+    tbb::global_control control(tbb::global_control::max_allowed_parallelism,
+                                nThreads);
+
+    std::vector<PropagationEvent> events;
+    const double seconds = runPropagation(parallel, cfg, nEvents, events);
+    const bool   same    = std::equal(events.begin(),
+                                     events.end(),
+                                     reference.begin(),
+                                     reference.end(),
+                                     sameEvent);
+    identical = identical and same;
+    std::printf("%-8s %7d %10.3f %8.2f %9s\n",
+                "parallel",
+                nThreads,
+                1e3 * seconds / nEvents,
+                serialSeconds / seconds,
+                same ? "yes" : "NO");
+  }
+  return identical;
+}
+
+}  // namespace
+
+/// Stepper and navigator comparison benchmark executable
+///
+/// Test tracks from the origin are propagated through the generic detector
+/// until they leave the world. All field-dependent steppers are combined with
+/// a constant field and 2D and 3D interpolated field maps that are sampled
+/// from the same constant field, i.e. all configurations see the same field
+/// values. The straight line stepper runs without field. Each combination
+/// runs once with the resolution of sensitive and material surfaces and once
+/// with boundary surfaces only.
+///
+/// For each combination and track sample the time per step, the number of
+/// steps per track, the share of the time spent in the navigation, and the
+/// number of failed propagations are printed in a table.
+///
+/// A second table compares the output recording with the Eigen stepper in
+/// the constant field: no recording, the step recording modes of the
+/// propagation algorithm, i.e. all steps, only sensitive or material surfaces,
+/// decimated steps, and the last steps of each track, and the surface
+/// intersections as in its surface mode. The propagation time, the recorded
+/// memory, and, for the step modes, the time to write the steps with the ROOT
+/// writer are printed per track. The files are written to the output
+/// directory.
+///
+/// A third table compares the parallel tests within an event of the
+/// propagation algorithm with its serial mode, using the Eigen stepper in the
+/// constant field and material recording. The maximum number of threads is
+/// limited for each run with a TBB global control; values above the number
+/// of available cores do not add threads. The time per event and the speedup
+/// are printed for each thread count, and the step and material collections
+/// are compared bitwise to the serial run. The benchmark fails if any of them
+/// differ.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::value;
+
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  FW::Options::addGeometryOptions(desc);
+  FW::Options::addMaterialOptions(desc);
+  FW::Options::addRandomNumbersOptions(desc);
+  FW::Options::addOutputOptions(desc);
+  desc.add_options()(
+      "bench-tracks",
+      value<size_t>()->default_value(1000),
+      "Number of test tracks per momentum and eta range")(
+      "bench-pt",
+      value<read_range>()->multitoken()->default_value({0.5, 1, 10, 100}),
+      "Transverse momenta of the test tracks [in GeV]")(
+      "bench-eta",
+      value<read_range>()->multitoken()->default_value({0, 1.5, 2.5, 4}),
+      "Pseudorapidity bin edges of the test tracks")(
+      "bench-bz",
+      value<double>()->default_value(2),
+      "Magnetic field along z [in T]")(
+      "bench-map-step",
+      value<double>()->default_value(100),
+      "Grid step of the interpolated field maps [in mm]")(
+      "bench-max-stepsize",
+      value<double>()->default_value(3000),
+      "Maximum step size for the propagation [in mm]")(
+      "bench-threads",
+      value<read_series>()->multitoken()->default_value({1, 2, 4, 8}),
+      "Maximum number of threads for the parallel propagation tests")(
+      "bench-parallel-events",
+      value<size_t>()->default_value(10),
+      "Number of events for the parallel propagation tests")(
+      "bench-parallel-tests",
+      value<size_t>()->default_value(1000),
+      "Number of propagation tests per event")(
+      "bench-tests-per-task",
+      value<size_t>()->default_value(10),
+      "Minimum number of propagation tests per parallel task");
+  detector.addOptions(desc);
+  auto vm = FW::Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto ptValues  = vm["bench-pt"].as<read_range>();
+  auto etaEdges  = vm["bench-eta"].as<read_range>();
+  auto nTracks   = vm["bench-tracks"].as<size_t>();
+  auto bz        = vm["bench-bz"].as<double>() * 1_T;
+  auto mapStep   = vm["bench-map-step"].as<double>() * 1_mm;
+  auto rndConfig = FW::Options::readRandomNumbersConfig(vm);
+  auto threads   = vm["bench-threads"].as<read_series>();
+  auto nParTests = vm["bench-parallel-tests"].as<size_t>();
+  auto nPerTask  = vm["bench-tests-per-task"].as<size_t>();
+  if (etaEdges.size() < 2) {
+    std::fprintf(stderr, "At least two pseudorapidity bin edges needed\n");
+    return EXIT_FAILURE;
+  }
+  // the parallel mode is only used with smaller tasks than all tests
+  if ((nPerTask < 1) or (nParTests <= nPerTask)) {
+    std::fprintf(stderr, "Invalid number of tests per parallel task\n");
+    return EXIT_FAILURE;
+  }
+  for (auto nThreads : threads) {
+    if (nThreads < 1) {
+      std::fprintf(stderr, "Invalid number of threads %d\n", nThreads);
+      return EXIT_FAILURE;
+    }
+  }
+
+  Setup setup;
+  setup.trackingGeometry = FW::Geometry::build(vm, detector).first;
+  setup.maxStepSize      = vm["bench-max-stepsize"].as<double>() * 1_mm;
+  setup.ptLoopers        = 300_MeV;
+  setup.outputDir        = FW::ensureWritableDirectory(
+      vm["output-dir"].as<std::string>());
+
+  // the same test tracks are used for all configurations
+  FW::RandomEngine                       rng(rndConfig.seed);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> qDist(0., 1.);
+  for (auto pt : ptValues) {
+    for (size_t ieta = 0; (ieta + 1) < etaEdges.size(); ++ieta) {
+      TrackSample sample;
+      sample.pt       = pt * 1_GeV;
+      sample.etaRange = {etaEdges[ieta], etaEdges[ieta + 1]};
+      std::uniform_real_distribution<double> etaDist(sample.etaRange.first,
+                                                     sample.etaRange.second);
+      for (size_t itrack = 0; itrack < nTracks; ++itrack) {
+        const double phi    = phiDist(rng);
+        const double eta    = etaDist(rng);
+        const double charge = qDist(rng) > 0.5 ? 1. : -1.;
+        const Acts::Vector3D momentum(sample.pt * std::cos(phi),
+                                      sample.pt * std::sin(phi),
+                                      sample.pt * std::sinh(eta));
+        sample.tracks.emplace_back(
+            std::nullopt, Acts::Vector3D(0, 0, 0), momentum, charge, 0.0);
+      }
+      setup.samples.push_back(std::move(sample));
+    }
+  }
+
+  // Field maps that cover the full generic detector
+  const double rMax = 2_m;
+  const double zMax = 4_m;
+  const size_t nR   = std::lround(rMax / mapStep) + 1;
+  const size_t nZ   = std::lround(2 * zMax / mapStep) + 1;
+
+  std::vector<double>         rPos, zPos;
+  std::vector<Acts::Vector2D> values2D;
+  for (size_t iz = 0; iz < nZ; ++iz) {
+    for (size_t ir = 0; ir < nR; ++ir) {
+      rPos.push_back(ir * mapStep);
+      zPos.push_back(-zMax + iz * mapStep);
+      values2D.emplace_back(0, bz);
+    }
+  }
+  auto mapper2D = Acts::fieldMapperRZ(
+      [](std::array<size_t, 2> binsRZ, std::array<size_t, 2> nBinsRZ) {
+        return (binsRZ.at(1) * nBinsRZ.at(0) + binsRZ.at(0));
+      },
+      rPos,
+      zPos,
+      values2D,
+      1_mm,
+      1);
+  InterpolatedBFieldMap2D::Config config2D(std::move(mapper2D));
+
+  std::vector<double>         xPos, yPos, xyzPos;
+  std::vector<Acts::Vector3D> values3D;
+  for (size_t ix = 0; ix < 2 * nR - 1; ++ix) {
+    for (size_t iy = 0; iy < 2 * nR - 1; ++iy) {
+      for (size_t iz = 0; iz < nZ; ++iz) {
+        xPos.push_back(-rMax + ix * mapStep);
+        yPos.push_back(-rMax + iy * mapStep);
+        xyzPos.push_back(-zMax + iz * mapStep);
+        values3D.emplace_back(0, 0, bz);
+      }
+    }
+  }
+  auto mapper3D = Acts::fieldMapperXYZ(
+      [](std::array<size_t, 3> binsXYZ, std::array<size_t, 3> nBinsXYZ) {
+        return (binsXYZ.at(0) * (nBinsXYZ.at(1) * nBinsXYZ.at(2))
+                + binsXYZ.at(1) * nBinsXYZ.at(2) + binsXYZ.at(2));
+      },
+      xPos,
+      yPos,
+      xyzPos,
+      values3D,
+      1_mm,
+      1);
+  InterpolatedBFieldMap3D::Config config3D(std::move(mapper3D));
+
+  std::printf("%-8s %-13s %-8s %8s %11s %10s %12s %8s %6s\n",
+              "field",
+              "stepper",
+              "surfaces",
+              "pT[GeV]",
+              "eta",
+              "ns/step",
+              "steps/track",
+              "nav[%]",
+              "failed");
+  benchmarkStepper(setup, "none", "StraightLine", Acts::StraightLineStepper());
+  benchmarkField(
+      setup, "constant", std::make_shared<Acts::ConstantBField>(0, 0, bz));
+  benchmarkField(
+      setup, "map2D", std::make_shared<InterpolatedBFieldMap2D>(config2D));
+  benchmarkField(
+      setup, "map3D", std::make_shared<InterpolatedBFieldMap3D>(config3D));
+
+  using ConstantField = Acts::SharedBField<Acts::ConstantBField>;
+  std::printf("\n%-9s %8s %11s %10s %10s %13s %6s\n",
+              "recording",
+              "pT[GeV]",
+              "eta",
+              "us/track",
+              "kB/track",
+              "write[us/trk]",
+              "failed");
+  benchmarkRecording(setup,
+                     Acts::EigenStepper<ConstantField>(ConstantField(
+                         std::make_shared<Acts::ConstantBField>(0, 0, bz))));
+
+  using Stepper    = Acts::EigenStepper<ConstantField>;
+  using Propagator = Acts::Propagator<Stepper, Acts::Navigator>;
+  Acts::Navigator navigator(setup.trackingGeometry);
+  navigator.resolveSensitive = true;
+  navigator.resolveMaterial  = true;
+  navigator.resolvePassive   = false;
+  FW::PropagationAlgorithm<Propagator>::Config propCfg(Propagator(
+      Stepper(ConstantField(std::make_shared<Acts::ConstantBField>(0, 0, bz))),
+      std::move(navigator)));
+  propCfg.randomNumberSvc = std::make_shared<FW::RandomNumbers>(rndConfig);
+  propCfg.ntests          = nParTests;
+  propCfg.maxStepSize     = setup.maxStepSize;
+  // the material collection is compared as well
+  propCfg.recordMaterialInteractions = true;
+
+  std::printf("\n%-8s %7s %10s %8s %9s\n",
+              "mode",
+              "threads",
+              "ms/event",
+              "speedup",
+              "identical");
+  if (not benchmarkParallel<Propagator>(
+          propCfg,
+          vm["bench-parallel-events"].as<size_t>(),
+          nPerTask,
+          threads)) {
+    std::fprintf(stderr, "Parallel propagation differs from serial mode\n");
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <memory>
+
+#include <Acts/Utilities/Units.hpp>
+
+#include "ACTFW/Digitization/ClusterSourceLinkMaker.hpp"
+#include "ACTFW/Framework/Sequencer.hpp"
+#include "ACTFW/GenericDetector/GenericDetector.hpp"
+#include "ACTFW/Geometry/CommonGeometry.hpp"
+#include "ACTFW/Io/Csv/CsvOptionsReader.hpp"
+#include "ACTFW/Io/Csv/CsvParticleReader.hpp"
+#include "ACTFW/Io/Csv/CsvPlanarClusterReader.hpp"
+#include "ACTFW/Io/Csv/CsvTrackFindingStatisticsWriter.hpp"
+#include "ACTFW/Io/Performance/TrackFinderPerformanceWriter.hpp"
+#include "ACTFW/Io/Performance/TrackFitterPerformanceWriter.hpp"
+#include "ACTFW/Io/Root/RootTrajectoryWriter.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/Plugins/BField/BFieldOptions.hpp"
+#include "ACTFW/TrackFinding/AmbiguityResolutionAlgorithm.hpp"
+#include "ACTFW/TrackFinding/SeedingAlgorithm.hpp"
+#include "ACTFW/TrackFinding/SpacePointMaker.hpp"
+#include "ACTFW/TrackFinding/TrackFindingAlgorithm.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "ACTFW/Utilities/Paths.hpp"
+
+using namespace Acts::UnitLiterals;
+using namespace FW;
+
+int
+main(int argc, char* argv[])
+{
+  GenericDetector detector;
+
+  // setup and parse options
+  auto desc = FW::Options::makeDefaultOptions();
+  Options::addSequencerOptions(desc);
+  Options::addGeometryOptions(desc);
+  Options::addMaterialOptions(desc);
+  Options::addInputOptions(desc);
+  Options::addOutputOptions(desc);
+  detector.addOptions(desc);
+  Options::addBFieldOptions(desc);
+  desc.add_options()(
+      "ckf-chi2-max",
+      boost::program_options::value<double>()->default_value(15.0),
+      "Maximum chi2 for a measurement to be added to a track candidate")(
+      "ckf-branches-max",
+      boost::program_options::value<std::size_t>()->default_value(10),
+      "Maximum number of track candidate branches per surface")(
+      "ckf-tracks-per-seed",
+      boost::program_options::value<std::size_t>()->default_value(10),
+      "Maximum number of track candidates kept per seed")(
+      "ambi-max-shared-fraction",
+      boost::program_options::value<double>()->default_value(0.0),
+      "Maximum fraction of measurements a track can share with other tracks");
+
+  auto vm = Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  Sequencer sequencer(Options::readSequencerConfig(vm));
+
+  // Read some standard options
+  auto logLevel  = Options::readLogLevel(vm);
+  auto outputDir = ensureWritableDirectory(vm["output-dir"].as<std::string>());
+
+  // Setup detector geometry
+  auto geometry         = Geometry::build(vm, detector);
+  auto trackingGeometry = geometry.first;
+  // Add context decorators
+  for (auto cdr : geometry.second) { sequencer.addContextDecorator(cdr); }
+  // Setup the magnetic field; the seeding assumes it is homogeneous along z
+  auto magneticField = Options::readBField(vm);
+  auto bFieldValues = vm["bf-values"].as<read_range>();
+
+  // Read particles (initial states) and clusters from CSV files
+  auto particleReader            = Options::readCsvParticleReaderConfig(vm);
+  particleReader.inputStem       = "particles_initial";
+  particleReader.outputParticles = "particles_initial";
+  sequencer.addReader(
+      std::make_shared<CsvParticleReader>(particleReader, logLevel));
+  // Read clusters from CSV files
+  auto clusterReaderCfg = Options::readCsvPlanarClusterReaderConfig(vm);
+  clusterReaderCfg.trackingGeometry      = trackingGeometry;
+  clusterReaderCfg.outputClusters        = "clusters";
+  clusterReaderCfg.outputHitIds          = "hit_ids";
+  clusterReaderCfg.outputHitParticlesMap = "hit_particles_map";
+  clusterReaderCfg.outputSimulatedHits   = "hits";
+  sequencer.addReader(
+      std::make_shared<CsvPlanarClusterReader>(clusterReaderCfg, logLevel));
+
+  // Create space points from all clusters
+  SpacePointMaker::Config spacePointCfg;
+  spacePointCfg.inputClusters     = clusterReaderCfg.outputClusters;
+  spacePointCfg.outputSpacePoints = "spacepoints";
+  sequencer.addAlgorithm(
+      std::make_shared<SpacePointMaker>(spacePointCfg, logLevel));
+
+  // Find track seeds
+  SeedingAlgorithm::Config seedingCfg;
+  seedingCfg.inputSpacePoints        = spacePointCfg.outputSpacePoints;
+  seedingCfg.outputProtoTracks       = "seeds";
+  seedingCfg.outputInitialParameters = "seedparameters";
+  seedingCfg.bFieldInZ               = bFieldValues.at(2) * 1_T;
+  sequencer.addAlgorithm(
+      std::make_shared<SeedingAlgorithm>(seedingCfg, logLevel));
+
+  // Create source links from clusters; shares the cluster indices
+  ClusterSourceLinkMaker::Config sourceLinkCfg;
+  sourceLinkCfg.inputClusters      = clusterReaderCfg.outputClusters;
+  sourceLinkCfg.inputSimulatedHits = clusterReaderCfg.outputSimulatedHits;
+  sourceLinkCfg.outputSourceLinks  = "sourcelinks";
+  sequencer.addAlgorithm(
+      std::make_shared<ClusterSourceLinkMaker>(sourceLinkCfg, logLevel));
+
+  // Find tracks starting from the seeds
+  TrackFindingAlgorithm::Config trackFindingCfg;
+  trackFindingCfg.inputSourceLinks = sourceLinkCfg.outputSourceLinks;
+  trackFindingCfg.inputInitialTrackParameters
+      = seedingCfg.outputInitialParameters;
+  trackFindingCfg.outputTrajectories = "trajectories";
+  trackFindingCfg.outputStatistics   = "trackfinding_statistics";
+  trackFindingCfg.findTracks
+      = TrackFindingAlgorithm::makeTrackFinderFunction(
+          trackingGeometry, magneticField, logLevel);
+  trackFindingCfg.chi2Max = vm["ckf-chi2-max"].as<double>();
+  trackFindingCfg.maxBranchesPerSurface
+      = vm["ckf-branches-max"].as<std::size_t>();
+  trackFindingCfg.maxTracksPerSeed
+      = vm["ckf-tracks-per-seed"].as<std::size_t>();
+  sequencer.addAlgorithm(
+      std::make_shared<TrackFindingAlgorithm>(trackFindingCfg, logLevel));
+
+  // Remove tracks with too many shared measurements
+  AmbiguityResolutionAlgorithm::Config ambiguityCfg;
+  ambiguityCfg.inputTrajectories  = trackFindingCfg.outputTrajectories;
+  ambiguityCfg.inputSourceLinks   = sourceLinkCfg.outputSourceLinks;
+  ambiguityCfg.outputTrajectories = "resolvedtrajectories";
+  ambiguityCfg.maxSharedFraction
+      = vm["ambi-max-shared-fraction"].as<double>();
+  sequencer.addAlgorithm(
+      std::make_shared<AmbiguityResolutionAlgorithm>(ambiguityCfg, logLevel));
+
+  // write found tracks
+  RootTrajectoryWriter::Config trackWriter;
+  trackWriter.inputParticles    = particleReader.outputParticles;
+  trackWriter.inputTrajectories = ambiguityCfg.outputTrajectories;
+  trackWriter.outputDir         = outputDir;
+  trackWriter.outputFilename    = "tracks_ckf.root";
+  trackWriter.outputTreename    = "tracks";
+  sequencer.addWriter(
+      std::make_shared<RootTrajectoryWriter>(trackWriter, logLevel));
+
+  // write the per-event track finding counts and print their summary
+  CsvTrackFindingStatisticsWriter::Config statisticsWriter;
+  statisticsWriter.inputStatistics = trackFindingCfg.outputStatistics;
+  statisticsWriter.outputDir       = outputDir;
+  sequencer.addWriter(std::make_shared<CsvTrackFindingStatisticsWriter>(
+      statisticsWriter, logLevel));
+
+  // write seeding performance data
+  TrackFinderPerformanceWriter::Config perfSeeding;
+  perfSeeding.inputParticles       = particleReader.outputParticles;
+  perfSeeding.inputHitParticlesMap = clusterReaderCfg.outputHitParticlesMap;
+  perfSeeding.inputProtoTracks     = seedingCfg.outputProtoTracks;
+  perfSeeding.outputDir            = outputDir;
+  perfSeeding.outputFilename       = "performance_seeding.root";
+  sequencer.addWriter(
+      std::make_shared<TrackFinderPerformanceWriter>(perfSeeding, logLevel));
+  // write track finding performance data. The truth track finding is not run
+  // in this job; the truth tracks reconstruction example writes the same
+  // quantities and must be run separately on the same input for comparison.
+  TrackFitterPerformanceWriter::Config perfFinder;
+  perfFinder.inputParticles    = particleReader.outputParticles;
+  perfFinder.inputTrajectories = ambiguityCfg.outputTrajectories;
+  perfFinder.outputDir         = outputDir;
+  perfFinder.outputFilename    = "performance_ckf.root";
+  sequencer.addWriter(
+      std::make_shared<TrackFitterPerformanceWriter>(perfFinder, logLevel));
+
+  return sequencer.run();
+}
@@ -6,6 +6,7 @@
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
+#include <limits>
 #include <memory>
 
 #include <Acts/Utilities/Units.hpp>
@@ -47,6 +48,31 @@ main(int argc, char* argv[])
   Options::addOutputOptions(desc);
   detector.addOptions(desc);
   Options::addBFieldOptions(desc);
+  desc.add_options()(
+      "smearing-resolution-file",
+      boost::program_options::value<std::string>()->default_value(""),
+      "CSV file with smearing resolutions per volume/layer/module")(
+      "fit-tracks-per-task",
+      boost::program_options::value<std::size_t>()->default_value(0),
+      "Minimum number of tracks per parallel fit task; 0 fits serially")(
+      "fit-lockstep-lanes",
+      boost::program_options::value<std::size_t>()->default_value(0),
+      "Number of tracks fitted in lockstep (4, 8, or 16); 0 fits one by one")(
+      "fit-lockstep-forward-only",
+      boost::program_options::bool_switch(),
+      "Skip the smoothing in the lockstep fitter")(
+      "fit-outlier-chi2-max",
+      boost::program_options::value<double>()->default_value(
+          std::numeric_limits<double>::infinity()),
+      "Maximum predicted chi2 before a measurement is flagged as an outlier")(
+      "fit-chi2ndf-max",
+      boost::program_options::value<double>()->default_value(
+          std::numeric_limits<double>::infinity()),
+      "Discard fitted tracks with a larger chi2/ndf")(
+      "fit-max-consecutive-outliers",
+      boost::program_options::value<std::size_t>()->default_value(
+          std::numeric_limits<std::size_t>::max()),
+      "Discard fitted tracks with more consecutive outliers");
 
   auto vm = Options::parse(desc, argc, argv);
   if (vm.empty()) { return EXIT_FAILURE; }
@@ -94,6 +120,11 @@ main(int argc, char* argv[])
   hitSmearingCfg.sigmaLoc1          = 100_um;
   hitSmearingCfg.randomNumbers      = rnd;
   hitSmearingCfg.trackingGeometry   = trackingGeometry;
+  // optional resolutions per volume/layer/module override the global widths
+  auto resolutionFile = vm["smearing-resolution-file"].as<std::string>();
+  if (not resolutionFile.empty()) {
+    hitSmearingCfg.resolutions = readResolutionMap(resolutionFile);
+  }
   sequencer.addAlgorithm(
       std::make_shared<HitSmearing>(hitSmearingCfg, logLevel));
 
@@ -136,6 +167,20 @@ main(int argc, char* argv[])
   fitter.outputTrajectories = "trajectories";
   fitter.fit                = FittingAlgorithm::makeFitterFunction(
       trackingGeometry, magneticField, logLevel);
+  fitter.minTracksPerTask = vm["fit-tracks-per-task"].as<std::size_t>();
+  fitter.outlierChi2Max   = vm["fit-outlier-chi2-max"].as<double>();
+  fitter.chi2NdfMax       = vm["fit-chi2ndf-max"].as<double>();
+  fitter.maxConsecutiveOutliers
+      = vm["fit-max-consecutive-outliers"].as<std::size_t>();
+  fitter.lockstepLanes = vm["fit-lockstep-lanes"].as<std::size_t>();
+  if (0u < fitter.lockstepLanes) {
+    fitter.fitBatch = FittingAlgorithm::makeLockstepFitterFunction(
+        trackingGeometry,
+        magneticField,
+        fitter.lockstepLanes,
+        not vm["fit-lockstep-forward-only"].as<bool>(),
+        logLevel);
+  }
   sequencer.addAlgorithm(std::make_shared<FittingAlgorithm>(fitter, logLevel));
 
   // write tracks from fitting
@@ -58,6 +58,7 @@ main(int argc, char* argv[])
   FWE::VertexFindingAlgorithm::Config vertexFindingCfg;
   vertexFindingCfg.trackCollection = vtxAndTracksReaderCfg.outputCollection;
   vertexFindingCfg.bField          = bField;
+  vertexFindingCfg.outputVertices  = "vertices";
 
   Sequencer::Config sequencerCfg = Options::readSequencerConfig(vm);
   Sequencer         sequencer(sequencerCfg);
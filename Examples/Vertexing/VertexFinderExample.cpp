@@ -40,6 +40,15 @@ main(int argc, char* argv[])
   Options::addRandomNumbersOptions(desc);
   Options::addPythia8Options(desc);
   Options::addOutputOptions(desc);
+  desc.add_options()("analytic-helix",
+                     boost::program_options::bool_switch(),
+                     "Extrapolate truth tracks with the analytic helix")(
+      "grid-density-seeder",
+      boost::program_options::bool_switch(),
+      "Seed vertices from the track density instead of the z-scan")(
+      "helix-linearizer",
+      boost::program_options::bool_switch(),
+      "Linearize tracks with the analytic helix instead of the propagator");
   auto vm = Options::parse(desc, argc, argv);
   if (vm.empty()) { return EXIT_FAILURE; }
 
@@ -67,11 +76,12 @@ main(int argc, char* argv[])
 
   // Set up TruthVerticesToTracks converter algorithm
   TruthVerticesToTracksAlgorithm::Config trkConvConfig;
-  trkConvConfig.input           = ptcSelectorCfg.outputEvent;
-  trkConvConfig.output          = "tracks";
-  trkConvConfig.doSmearing      = true;
-  trkConvConfig.randomNumberSvc = rnd;
-  trkConvConfig.bField          = {0_T, 0_T, 1_T};
+  trkConvConfig.input            = ptcSelectorCfg.outputEvent;
+  trkConvConfig.output           = "tracks";
+  trkConvConfig.doSmearing       = true;
+  trkConvConfig.randomNumberSvc  = rnd;
+  trkConvConfig.bField           = {0_T, 0_T, 1_T};
+  trkConvConfig.useAnalyticHelix = vm["analytic-helix"].as<bool>();
   sequencer.addAlgorithm(std::make_shared<TruthVerticesToTracksAlgorithm>(
       trkConvConfig, logLevel));
 
@@ -90,6 +100,10 @@ main(int argc, char* argv[])
   FWE::VertexFindingAlgorithm::Config vertexFindingCfg;
   vertexFindingCfg.trackCollection = selectorConfig.output;
   vertexFindingCfg.bField          = trkConvConfig.bField;
+  vertexFindingCfg.outputVertices  = "vertices";
+  vertexFindingCfg.useGridDensitySeeder
+      = vm["grid-density-seeder"].as<bool>();
+  vertexFindingCfg.useHelixLinearizer = vm["helix-linearizer"].as<bool>();
   sequencer.addAlgorithm(std::make_shared<FWE::VertexFindingAlgorithm>(
       vertexFindingCfg, logLevel));
 
@@ -39,6 +39,12 @@ main(int argc, char* argv[])
   Options::addRandomNumbersOptions(desc);
   Options::addPythia8Options(desc);
   Options::addOutputOptions(desc);
+  desc.add_options()("analytic-helix",
+                     boost::program_options::bool_switch(),
+                     "Extrapolate truth tracks with the analytic helix")(
+      "helix-linearizer",
+      boost::program_options::bool_switch(),
+      "Linearize tracks with the analytic helix instead of the propagator");
   auto vm = Options::parse(desc, argc, argv);
   if (vm.empty()) { return EXIT_FAILURE; }
 
@@ -56,10 +62,11 @@ main(int argc, char* argv[])
 
   // Set up TruthVerticesToTracks converter algorithm
   TruthVerticesToTracksAlgorithm::Config trkConvConfig;
-  trkConvConfig.input           = evgen.output;
-  trkConvConfig.output          = "all_tracks";
-  trkConvConfig.randomNumberSvc = rnd;
-  trkConvConfig.bField          = {0_T, 0_T, 2_T};
+  trkConvConfig.input            = evgen.output;
+  trkConvConfig.output           = "all_tracks";
+  trkConvConfig.randomNumberSvc  = rnd;
+  trkConvConfig.bField           = {0_T, 0_T, 2_T};
+  trkConvConfig.useAnalyticHelix = vm["analytic-helix"].as<bool>();
   sequencer.addAlgorithm(std::make_shared<TruthVerticesToTracksAlgorithm>(
       trkConvConfig, logLevel));
 
@@ -76,8 +83,10 @@ main(int argc, char* argv[])
 
   // Add the fit algorithm with Billoir fitter
   FWE::VertexFitAlgorithm::Config vertexFitCfg;
-  vertexFitCfg.trackCollection = selectorConfig.output;
-  vertexFitCfg.bField          = trkConvConfig.bField;
+  vertexFitCfg.trackCollection    = selectorConfig.output;
+  vertexFitCfg.outputVertices     = "fitted_vertices";
+  vertexFitCfg.bField             = trkConvConfig.bField;
+  vertexFitCfg.useHelixLinearizer = vm["helix-linearizer"].as<bool>();
   sequencer.addAlgorithm(
       std::make_shared<FWE::VertexFitAlgorithm>(vertexFitCfg, logLevel));
 
@@ -0,0 +1,638 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <tbb/task_scheduler_init.h>
+
+#include "ACTFW/EventData/RecVertex.hpp"
+#include "ACTFW/Framework/AlgorithmContext.hpp"
+#include "ACTFW/Framework/RandomNumbers.hpp"
+#include "ACTFW/Framework/Sequencer.hpp"
+#include "ACTFW/Framework/WhiteBoard.hpp"
+#include "ACTFW/Generators/EventGenerator.hpp"
+#include "ACTFW/Generators/MultiplicityGenerators.hpp"
+#include "ACTFW/Generators/ParametricProcessGenerator.hpp"
+#include "ACTFW/Generators/VertexGenerators.hpp"
+#include "ACTFW/Options/CommonOptions.hpp"
+#include "ACTFW/TruthTracking/TruthVerticesToTracks.hpp"
+#include "ACTFW/TruthTracking/VertexAndTracks.hpp"
+#include "ACTFW/Utilities/HelixExtrapolation.hpp"
+#include "ACTFW/Utilities/Options.hpp"
+#include "ACTFW/Vertexing/HelixTrackLinearizer.hpp"
+#include "ACTFW/Vertexing/VertexFindingAlgorithm.hpp"
+#include "ACTFW/Vertexing/VertexFitAlgorithm.hpp"
+#include "Acts/EventData/TrackParameters.hpp"
+#include "Acts/Geometry/GeometryContext.hpp"
+#include "Acts/MagneticField/ConstantBField.hpp"
+#include "Acts/MagneticField/MagneticFieldContext.hpp"
+#include "Acts/Propagator/EigenStepper.hpp"
+#include "Acts/Propagator/Propagator.hpp"
+#include "Acts/Surfaces/PerigeeSurface.hpp"
+#include "Acts/Utilities/PdgParticle.hpp"
+#include "Acts/Utilities/Units.hpp"
+#include "Acts/Vertexing/HelicalTrackLinearizer.hpp"
+
+using namespace Acts::UnitLiterals;
+using namespace FW;
+
+namespace {
+
+using Clock             = std::chrono::steady_clock;
+using MagneticField     = Acts::ConstantBField;
+using Stepper           = Acts::EigenStepper<MagneticField>;
+using Propagator        = Acts::Propagator<Stepper>;
+using PropagatorOptions = Acts::PropagatorOptions<>;
+using Linearizer        = Acts::HelicalTrackLinearizer<Propagator>;
+using HelixLinearizer   = FWE::HelixTrackLinearizer<Propagator>;
+
+/// Truth track on the perigee at the origin and its vertex.
+struct TruthTrack
+{
+  Acts::BoundParameters                 parameters;
+  Acts::SpacePointVector                vertex;
+  std::shared_ptr<Acts::PerigeeSurface> vertexPerigee;
+};
+
+/// Largest deviations between two sets of perigee parameters.
+///
+/// The angles are in rad; q/p and the variances are relative deviations.
+struct Deviation
+{
+  double loc      = 0;
+  double angle    = 0;
+  double qop      = 0;
+  double variance = 0;
+
+  void
+  update(const Acts::BoundVector& params, const Acts::BoundVector& reference)
+  {
+    const Acts::BoundVector diff = params - reference;
+    loc   = std::max({loc,
+                    std::abs(diff[Acts::eLOC_0]),
+                    std::abs(diff[Acts::eLOC_1])});
+    angle = std::max({angle,
+                      std::abs(std::remainder(diff[Acts::ePHI], 2 * M_PI)),
+                      std::abs(diff[Acts::eTHETA])});
+    qop   = std::max(qop, std::abs(diff[Acts::eQOP] / reference[Acts::eQOP]));
+  }
+  void
+  update(const Acts::BoundSymMatrix& cov, const Acts::BoundSymMatrix& reference)
+  {
+    for (unsigned i = Acts::eLOC_0; i < Acts::eT; ++i) {
+      variance = std::max(variance, std::abs(cov(i, i) / reference(i, i) - 1));
+    }
+  }
+};
+
+/// Truth vertices and their tracks for all events of one pile-up value.
+using Events = std::vector<std::vector<VertexAndTracks>>;
+
+/// Generate the events and convert the truth particles to tracks.
+///
+/// The events are created once per pile-up value; all vertexing algorithms
+/// run on copies of the same events.
+Events
+makeEvents(EventGenerator&                       generator,
+           const TruthVerticesToTracksAlgorithm& converter,
+           const std::string&                    tracks,
+           size_t                                nEvents)
+{
+  Events events;
+  events.reserve(nEvents);
+  for (size_t ievent = 0; ievent < nEvents; ++ievent) {
+    WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    AlgorithmContext ctx(0, ievent, store);
+    if ((generator.read(ctx) != ProcessCode::SUCCESS)
+        or (converter.execute(ctx) != ProcessCode::SUCCESS)) {
+      throw std::runtime_error("Event generation failed");
+    }
+    events.push_back(store.pop<std::vector<VertexAndTracks>>(tracks));
+  }
+  return events;
+}
+
+/// Run a vertexing algorithm on all events and return the time of execute.
+///
+/// The output of each event is given to the analyze function while the event
+/// store, i.e. the tracks referenced by the vertices, still exists.
+template <typename analyze_t>
+double
+timeVertexing(const BareAlgorithm& algorithm,
+              const std::string&   tracks,
+              const Events&        events,
+              analyze_t&&          analyze)
+{
+  double seconds = 0;
+  for (size_t ievent = 0; ievent < events.size(); ++ievent) {
+    WhiteBoard store(
+        Acts::getDefaultLogger("EventStore", Acts::Logging::WARNING));
+    // the input copy is not part of the measurement
+    store.add(tracks, std::vector<VertexAndTracks>(events[ievent]));
+    AlgorithmContext ctx(0, ievent, store);
+
+    const auto start = Clock::now();
+    if (algorithm.execute(ctx) != ProcessCode::SUCCESS) {
+      throw std::runtime_error("Vertexing failed");
+    }
+    seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    analyze(ievent, store);
+  }
+  return seconds;
+}
+
+/// Matching of found to true vertices.
+struct Matching
+{
+  /// True vertices with at least two tracks, i.e. findable vertices.
+  size_t trueVertices = 0;
+  /// True vertices with at least one compatible found vertex.
+  size_t matchedTrue = 0;
+  size_t found       = 0;
+  /// Found vertices without a compatible true vertex.
+  size_t fakes = 0;
+
+  /// Match the found vertices of one event in z.
+  ///
+  /// Each found vertex is compatible with the closest findable true vertex
+  /// in z if their distance is within the given number of standard
+  /// deviations of the found vertex z position.
+  void
+  add(const std::vector<VertexAndTracks>& truth,
+      const RecVertexContainer&           vertices,
+      double                              nSigma)
+  {
+    std::vector<double> trueZ;
+    for (const auto& vertexAndTracks : truth) {
+      if (vertexAndTracks.tracks.size() < 2) { continue; }
+      trueZ.push_back(vertexAndTracks.vertex.position().z());
+    }
+    std::vector<bool> isMatched(trueZ.size(), false);
+    for (const auto& vertex : vertices) {
+      const double sigmaZ  = std::sqrt(vertex.covariance()(2, 2));
+      size_t       closest = trueZ.size();
+      double       minDist = std::numeric_limits<double>::infinity();
+      for (size_t i = 0; i < trueZ.size(); ++i) {
+        const double dist = std::abs(vertex.position().z() - trueZ[i]);
+        if (dist < minDist) {
+          minDist = dist;
+          closest = i;
+        }
+      }
+      if ((closest < trueZ.size()) and (minDist <= nSigma * sigmaZ)) {
+        isMatched[closest] = true;
+      } else {
+        fakes += 1;
+      }
+    }
+    trueVertices += trueZ.size();
+    matchedTrue += std::count(isMatched.begin(), isMatched.end(), true);
+    found += vertices.size();
+  }
+};
+
+/// Random tracks from vertices within the beam spot.
+///
+/// The truth parameters at the origin are computed with the analytic helix
+/// and carry a fixed, uncorrelated covariance as from the truth smearing.
+std::vector<TruthTrack>
+makeTruthTracks(size_t numTracks, double bz, RandomEngine& rng)
+{
+  std::normal_distribution<double>       xyDist(0, 15_um);
+  std::normal_distribution<double>       zDist(0, 55.5_mm);
+  std::uniform_real_distribution<double> phiDist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> etaDist(-2.5, 2.5);
+  std::uniform_real_distribution<double> ptDist(400_MeV, 10_GeV);
+  std::uniform_real_distribution<double> qDist(0, 1);
+
+  const auto origin = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+      Acts::Vector3D(0, 0, 0));
+  const double          pionMass = 139.57018_MeV;
+  Acts::GeometryContext geoContext;
+
+  std::vector<TruthTrack> tracks;
+  tracks.reserve(numTracks);
+  for (size_t i = 0; i < numTracks; ++i) {
+    const Acts::Vector3D vertex(xyDist(rng), xyDist(rng), zDist(rng));
+    const double         phi    = phiDist(rng);
+    const double         pt     = ptDist(rng);
+    const double         charge = (qDist(rng) < 0.5) ? -1.0 : 1.0;
+    const Acts::Vector3D momentum(
+        pt * std::cos(phi), pt * std::sin(phi), pt * std::sinh(etaDist(rng)));
+    const auto params = extrapolateHelixToPerigee(
+        vertex, momentum, charge, 0.0, pionMass, bz, Acts::Vector3D::Zero());
+
+    Acts::BoundSymMatrix cov = Acts::BoundSymMatrix::Zero();
+    cov.diagonal() << 20_um * 20_um, 20_um * 20_um, 1e-6, 1e-6,
+        1e-4 * params[Acts::eQOP] * params[Acts::eQOP], 1;
+    Acts::SpacePointVector vertex4 = Acts::SpacePointVector::Zero();
+    vertex4.head<3>()              = vertex;
+    tracks.push_back(
+        {Acts::BoundParameters(geoContext, cov, params, origin),
+         vertex4,
+         Acts::Surface::makeShared<Acts::PerigeeSurface>(vertex)});
+  }
+  return tracks;
+}
+
+/// Compare the closed-form helix with the propagator for single tracks.
+///
+/// The tracks are extrapolated and linearized at their true vertex. The
+/// propagator results are the reference for the deviations. Returns false
+/// if a deviation of the parameters exceeds the tolerance.
+bool
+compareTracks(size_t numTracks, double bz, double tolerance, uint64_t seed)
+{
+  RandomEngine rng(seed);
+  const auto   tracks = makeTruthTracks(numTracks, bz, rng);
+
+  Acts::GeometryContext      geoContext;
+  Acts::MagneticFieldContext magFieldContext;
+  MagneticField              bField(0, 0, bz);
+  auto              propagator = std::make_shared<Propagator>(Stepper(bField));
+  PropagatorOptions propagatorOpts(geoContext, magFieldContext);
+  Linearizer        linearizer(
+      Linearizer::Config(bField, propagator, propagatorOpts));
+  HelixLinearizer::Config helixCfg;
+  helixCfg.bFieldInZ = bz;
+  HelixLinearizer helixLinearizer(helixCfg);
+
+  // the results are stored and only compared after the timing
+  std::vector<Acts::BoundVector>    propagated, extrapolated;
+  std::vector<Acts::BoundVector>    linearized, helixLinearized;
+  std::vector<Acts::BoundSymMatrix> linearizedCov, helixLinearizedCov;
+  auto time = [&](auto&& method) {
+    const auto start = Clock::now();
+    for (const auto& track : tracks) {
+      if (not method(track)) { return -1.0; }
+    }
+    const auto seconds
+        = std::chrono::duration<double>(Clock::now() - start).count();
+    return seconds / tracks.size();
+  };
+  const double propagate = time([&](const TruthTrack& track) {
+    auto result = propagator->propagate(
+        track.parameters, *track.vertexPerigee, propagatorOpts);
+    if (not result.ok()) { return false; }
+    propagated.push_back((*result).endParameters->parameters());
+    return true;
+  });
+  const double helix = time([&](const TruthTrack& track) {
+    extrapolated.push_back(
+        extrapolateHelixToPerigee(track.parameters.position(),
+                                  track.parameters.momentum(),
+                                  track.parameters.charge(),
+                                  track.parameters.time(),
+                                  propagatorOpts.mass,
+                                  bz,
+                                  track.vertex.head<3>()));
+    return true;
+  });
+  const double linearize = time([&](const TruthTrack& track) {
+    auto result = linearizer.linearizeTrack(&track.parameters, track.vertex);
+    if (not result.ok()) { return false; }
+    linearized.push_back(result->parametersAtPCA);
+    linearizedCov.push_back(result->covarianceAtPCA);
+    return true;
+  });
+  const double linearizeHelix = time([&](const TruthTrack& track) {
+    auto result
+        = helixLinearizer.linearizeTrack(&track.parameters, track.vertex);
+    if (not result.ok()) { return false; }
+    helixLinearized.push_back(result->parametersAtPCA);
+    helixLinearizedCov.push_back(result->covarianceAtPCA);
+    return true;
+  });
+  if ((propagate < 0) or (helix < 0) or (linearize < 0)
+      or (linearizeHelix < 0)) {
+    std::fprintf(stderr, "Track extrapolation or linearization failed\n");
+    return false;
+  }
+
+  Deviation helixDeviation, linearizerDeviation;
+  for (size_t i = 0; i < tracks.size(); ++i) {
+    helixDeviation.update(extrapolated[i], propagated[i]);
+    linearizerDeviation.update(helixLinearized[i], linearized[i]);
+    linearizerDeviation.update(helixLinearizedCov[i], linearizedCov[i]);
+  }
+
+  std::printf("%-16s %10s %10s %12s %12s %12s\n",
+              "method",
+              "us/track",
+              "dloc[um]",
+              "dangle[urad]",
+              "dqop[rel]",
+              "dvar[rel]");
+  std::printf("%-16s %10.3f\n", "propagate", 1e6 * propagate);
+  std::printf("%-16s %10.3f %10.4f %12.4f %12.2e\n",
+              "helix",
+              1e6 * helix,
+              helixDeviation.loc / 1_um,
+              1e6 * helixDeviation.angle,
+              helixDeviation.qop);
+  std::printf("%-16s %10.3f\n", "linearize", 1e6 * linearize);
+  std::printf("%-16s %10.3f %10.4f %12.4f %12.2e %12.2e\n",
+              "linearize-helix",
+              1e6 * linearizeHelix,
+              linearizerDeviation.loc / 1_um,
+              1e6 * linearizerDeviation.angle,
+              linearizerDeviation.qop,
+              linearizerDeviation.variance);
+
+  for (const auto& deviation : {helixDeviation, linearizerDeviation}) {
+    if ((tolerance < deviation.loc) or (tolerance < deviation.angle)
+        or (tolerance < deviation.qop)) {
+      std::fprintf(stderr,
+                   "Analytic helix deviates from the propagator beyond the "
+                   "tolerance %g\n",
+                   tolerance);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+/// Vertexing throughput benchmark executable
+///
+/// Each event contains a single hard-scatter vertex and a Poisson-distributed
+/// number of pile-up vertices with a Gaussian beam spot. Every vertex emits a
+/// fixed number of charged pions. The events are generated and converted to
+/// truth tracks once for each requested pile-up value. The vertex fit and,
+/// optionally, the vertex finding then run directly on the same events; only
+/// their execution is timed, i.e. the event generation, the track conversion,
+/// and the event store setup are not part of the measurement. The vertex
+/// finding runs once with the z-scan and once with the grid density seeder.
+/// The time per event and per generated vertex is reported in a table, where
+/// the number of vertices is the actual number generated in the events.
+///
+/// For each seeder, the found vertices are matched to the true vertices with
+/// at least two tracks in z within the given number of standard deviations
+/// of the found vertex. The efficiency is the fraction of matched true
+/// vertices and the fake rate the fraction of found vertices without a
+/// compatible true vertex.
+///
+/// Each algorithm is run a second time with the vertexing tool chains rebuilt
+/// for every event instead of being reused. The difference of the time per
+/// event between both runs is the per-event setup overhead.
+///
+/// Afterwards, the extrapolation of single tracks to the perigee at their
+/// true vertex is timed with the propagator and with the analytic helix, as
+/// well as the track linearization with the Acts helical track linearizer and
+/// with the closed-form helix linearizer. The propagator results are the
+/// reference; the executable fails if the helix parameters deviate by more
+/// than the given tolerance, in mm and rad for the positions and angles and
+/// relative for q/p. The deviation of the transported variances is printed.
+///
+/// @param argc The argument count
+/// @param argv The argument list
+int
+main(int argc, char* argv[])
+{
+  using boost::program_options::bool_switch;
+  using boost::program_options::value;
+
+  // setup and parse options
+  auto desc = Options::makeDefaultOptions();
+  Options::addSequencerOptions(desc);
+  Options::addRandomNumbersOptions(desc);
+  desc.add_options()(
+      "bench-pileup",
+      value<read_series>()->multitoken()->default_value({0, 50, 100, 200}),
+      "Average pile-up values to benchmark")(
+      "bench-tracks-per-vertex",
+      value<size_t>()->default_value(20),
+      "Number of charged tracks per vertex")(
+      "bench-vertices-per-task",
+      value<size_t>()->default_value(0),
+      "Minimum number of vertices per parallel fit task; 0 fits serially")(
+      "bench-skip-finding", bool_switch(), "Only run the vertex fit")(
+      "bench-match-sigma",
+      value<double>()->default_value(3),
+      "Maximum z distance of matched found and true vertices [in sigma]")(
+      "analytic-helix",
+      bool_switch(),
+      "Extrapolate truth tracks with the analytic helix")(
+      "helix-linearizer",
+      bool_switch(),
+      "Linearize tracks with the analytic helix instead of the propagator")(
+      "bench-linearize-tracks",
+      value<size_t>()->default_value(10000),
+      "Number of single tracks to extrapolate and linearize; 0 disables it")(
+      "bench-helix-tolerance",
+      value<double>()->default_value(1e-3),
+      "Maximum deviation of the analytic helix from the propagator");
+  auto vm = Options::parse(desc, argc, argv);
+  if (vm.empty()) { return EXIT_FAILURE; }
+
+  auto logLevel     = Options::readLogLevel(vm);
+  auto sequencerCfg = Options::readSequencerConfig(vm);
+  // the generator provides an infinite number of events
+  auto nEvents      = vm["events"].empty() ? 100u : sequencerCfg.events;
+  auto pileups      = vm["bench-pileup"].as<read_series>();
+  auto skipFinding  = vm["bench-skip-finding"].as<bool>();
+  auto matchSigma   = vm["bench-match-sigma"].as<double>();
+  if ((nEvents == 0) or not(0 < matchSigma)) {
+    std::fprintf(stderr, "Invalid number of events or matching sigma\n");
+    return EXIT_FAILURE;
+  }
+  // the parallel vertex fit uses the configured number of threads
+  tbb::task_scheduler_init init(sequencerCfg.numThreads);
+
+  // Charged pions from the vertex with a realistic momentum spectrum
+  ParametricProcessGenerator::Config process;
+  process.numParticles    = vm["bench-tracks-per-vertex"].as<size_t>();
+  process.etaRange        = {{-2.5, 2.5}};
+  process.ptRange         = {{400_MeV, 10_GeV}};
+  process.pdg             = Acts::PdgParticle::ePionPlus;
+  process.randomizeCharge = true;
+  // Beam spot similar to the LHC
+  GaussianVertexGenerator beamSpot;
+  beamSpot.stddev = {15_um, 15_um, 55.5_mm, 0.08_ns};
+
+  // The same random numbers and converter are used for all pile-up values
+  auto rnd
+      = std::make_shared<RandomNumbers>(Options::readRandomNumbersConfig(vm));
+  EventGenerator::Config evgen;
+  evgen.output        = "generated_event";
+  evgen.randomNumbers = rnd;
+
+  TruthVerticesToTracksAlgorithm::Config trkConvConfig;
+  trkConvConfig.input            = evgen.output;
+  trkConvConfig.output           = "tracks";
+  trkConvConfig.randomNumberSvc  = rnd;
+  trkConvConfig.bField           = {0_T, 0_T, 2_T};
+  trkConvConfig.useAnalyticHelix = vm["analytic-helix"].as<bool>();
+  TruthVerticesToTracksAlgorithm converter(trkConvConfig, logLevel);
+
+  FWE::VertexFitAlgorithm::Config vertexFitCfg;
+  vertexFitCfg.trackCollection = trkConvConfig.output;
+  vertexFitCfg.outputVertices  = "fitted_vertices";
+  vertexFitCfg.bField          = trkConvConfig.bField;
+  vertexFitCfg.minVerticesPerTask
+      = vm["bench-vertices-per-task"].as<size_t>();
+  vertexFitCfg.useHelixLinearizer = vm["helix-linearizer"].as<bool>();
+
+  FWE::VertexFindingAlgorithm::Config vertexFindingCfg;
+  vertexFindingCfg.trackCollection    = trkConvConfig.output;
+  vertexFindingCfg.outputVertices     = "found_vertices";
+  vertexFindingCfg.bField             = trkConvConfig.bField;
+  vertexFindingCfg.useHelixLinearizer = vm["helix-linearizer"].as<bool>();
+
+  auto ignoreOutput = [](size_t, const WhiteBoard&) {};
+
+  struct FitResult
+  {
+    int    pileup;
+    double verticesPerEvent;
+    double perEvent;
+    double perVertex;
+    double perEventRebuilt;
+  };
+  struct FindResult
+  {
+    int         pileup;
+    const char* seeder;
+    double      perEvent;
+    double      perVertex;
+    double      perEventRebuilt;
+    Matching    matching;
+  };
+  std::vector<FitResult>  fitResults;
+  std::vector<FindResult> findResults;
+
+  for (auto pileup : pileups) {
+    if (pileup < 0) {
+      std::fprintf(stderr, "Invalid negative pile-up %d\n", pileup);
+      return EXIT_FAILURE;
+    }
+    evgen.generators = {
+        {FixedMultiplicityGenerator{1},
+         beamSpot,
+         ParametricProcessGenerator{process}},
+        {PoissonMultiplicityGenerator{size_t(pileup)},
+         beamSpot,
+         ParametricProcessGenerator{process}},
+    };
+    EventGenerator generator(evgen, logLevel);
+    const auto     events
+        = makeEvents(generator, converter, trkConvConfig.output, nEvents);
+    // the number of pile-up vertices fluctuates; use the generated number
+    size_t nVertices = 0;
+    for (const auto& event : events) { nVertices += event.size(); }
+    const double perVertex = 1.0 / std::max<size_t>(nVertices, 1u);
+
+    // the tool chains are either reused or rebuilt for every event
+    double fitSeconds[2];
+    for (bool rebuildTools : {false, true}) {
+      vertexFitCfg.rebuildTools = rebuildTools;
+      FWE::VertexFitAlgorithm fitter(vertexFitCfg, logLevel);
+      fitSeconds[rebuildTools] = timeVertexing(
+          fitter, trkConvConfig.output, events, ignoreOutput);
+    }
+    fitResults.push_back({pileup,
+                          double(nVertices) / nEvents,
+                          fitSeconds[false] / nEvents,
+                          fitSeconds[false] * perVertex,
+                          fitSeconds[true] / nEvents});
+    if (skipFinding) { continue; }
+
+    // both seeders find the vertices on the same events
+    for (bool useGrid : {false, true}) {
+      vertexFindingCfg.useGridDensitySeeder = useGrid;
+      Matching matching;
+      double   findSeconds[2];
+      for (bool rebuildTools : {false, true}) {
+        vertexFindingCfg.rebuildTools = rebuildTools;
+        FWE::VertexFindingAlgorithm finder(vertexFindingCfg, logLevel);
+        findSeconds[rebuildTools] = timeVertexing(
+            finder,
+            trkConvConfig.output,
+            events,
+            [&](size_t ievent, const WhiteBoard& store) {
+              // the rebuilt tool chains find the same vertices
+              if (rebuildTools) { return; }
+              matching.add(events[ievent],
+                           store.get<RecVertexContainer>(
+                               vertexFindingCfg.outputVertices),
+                           matchSigma);
+            });
+      }
+      findResults.push_back({pileup,
+                             useGrid ? "grid-density" : "z-scan",
+                             findSeconds[false] / nEvents,
+                             findSeconds[false] * perVertex,
+                             findSeconds[true] / nEvents,
+                             matching});
+    }
+  }
+
+  std::printf("%8s %12s %12s %12s %16s\n",
+              "pileup",
+              "vtx/event",
+              "fit[ms/evt]",
+              "fit[us/vtx]",
+              "rebuilt[ms/evt]");
+  for (const auto& result : fitResults) {
+    std::printf("%8d %12.2f %12.3f %12.3f %16.3f\n",
+                result.pileup,
+                result.verticesPerEvent,
+                1e3 * result.perEvent,
+                1e6 * result.perVertex,
+                1e3 * result.perEventRebuilt);
+  }
+  if (not findResults.empty()) {
+    std::printf("\n%8s %-14s %12s %12s %16s %12s %10s %10s\n",
+                "pileup",
+                "seeder",
+                "find[ms/evt]",
+                "find[us/vtx]",
+                "rebuilt[ms/evt]",
+                "found/event",
+                "eff[%]",
+                "fake[%]");
+  }
+  for (const auto& result : findResults) {
+    const auto& m = result.matching;
+    std::printf("%8d %-14s %12.3f %12.3f %16.3f %12.2f %10.2f %10.2f\n",
+                result.pileup,
+                result.seeder,
+                1e3 * result.perEvent,
+                1e6 * result.perVertex,
+                1e3 * result.perEventRebuilt,
+                double(m.found) / nEvents,
+                100. * m.matchedTrue / std::max<size_t>(m.trueVertices, 1u),
+                100. * m.fakes / std::max<size_t>(m.found, 1u));
+  }
+
+  const auto numTracks = vm["bench-linearize-tracks"].as<size_t>();
+  if (0 < numTracks) {
+    std::printf("\n");
+    if (not compareTracks(numTracks,
+                          2_T,
+                          vm["bench-helix-tolerance"].as<double>(),
+                          Options::readRandomNumbersConfig(vm).seed)) {
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -11,9 +11,8 @@
 #include <limits>
 #include <string>
 
-#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
 #include "ACTFW/Framework/WriterT.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
 
 namespace FW {
 
@@ -33,8 +32,7 @@ namespace FW {
 ///     ...
 ///
 /// and each line in the file corresponds to one hit/cluster.
-class CsvPlanarClusterWriter final
-  : public WriterT<GeometryIdMultimap<Acts::PlanarModuleCluster>>
+class CsvPlanarClusterWriter final : public WriterT<PlanarClusterContainer>
 {
 public:
   struct Config
@@ -61,9 +59,8 @@ protected:
   /// @param[in] ctx is the algorithm context
   /// @param[in] particles are the particle to be written
   ProcessCode
-  writeT(const AlgorithmContext&                              ctx,
-         const GeometryIdMultimap<Acts::PlanarModuleCluster>& clusters)
-      final override;
+  writeT(const AlgorithmContext&       ctx,
+         const PlanarClusterContainer& clusters) final override;
 
 private:
   Config m_cfg;
@@ -0,0 +1,68 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "ACTFW/EventData/TrackFindingStatistics.hpp"
+#include "ACTFW/Framework/WriterT.hpp"
+
+namespace FW {
+
+/// Write out the per-event track finding statistics.
+///
+/// The statistics of all events are collected and written to a single file
+/// in the configured output directory at the end of the run. Each line in
+/// the file corresponds to one event; the events are ordered by number. The
+/// totals and the averages per event are printed as well.
+///
+/// Safe to use from multiple writer threads - uses a std::mutex lock.
+class CsvTrackFindingStatisticsWriter final
+  : public WriterT<TrackFindingStatistics>
+{
+public:
+  struct Config
+  {
+    /// Input track finding statistics.
+    std::string inputStatistics;
+    /// Where to place the output file.
+    std::string outputDir;
+    /// Output filename.
+    std::string outputFilename = "trackfinding_statistics.csv";
+  };
+
+  /// Construct the statistics writer.
+  ///
+  /// @params cfg is the configuration object
+  /// @params lvl is the logging level
+  CsvTrackFindingStatisticsWriter(const Config& cfg, Acts::Logging::Level lvl);
+
+  /// Write the collected statistics and print the summary.
+  ProcessCode
+  endRun() final override;
+
+protected:
+  /// Collect the statistics of one event.
+  ///
+  /// @param[in] ctx is the algorithm context
+  /// @param[in] statistics are the track finding statistics of the event
+  ProcessCode
+  writeT(const FW::AlgorithmContext&   ctx,
+         const TrackFindingStatistics& statistics) final override;
+
+private:
+  Config m_cfg;
+  /// Mutex used to protect multi-threaded writes.
+  std::mutex                                    m_mutex;
+  std::map<std::size_t, TrackFindingStatistics> m_events;
+};
+
+}  // namespace FW
@@ -54,6 +54,7 @@ FW::ProcessCode
 FW::CsvParticleReader::read(const FW::AlgorithmContext& ctx)
 {
   SimParticleContainer::sequence_type unordered;
+  unordered.reserve(ctx.capacityHint(m_cfg.outputParticles, 0u));
 
   auto path = perEventFilepath(
       m_cfg.inputDir, m_cfg.inputStem + ".csv", ctx.eventNumber);
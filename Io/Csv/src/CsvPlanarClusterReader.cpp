@@ -12,13 +12,14 @@
 
 #include "ACTFW/EventData/GeometryContainers.hpp"
 #include "ACTFW/EventData/IndexContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
 #include "ACTFW/EventData/SimHit.hpp"
 #include "ACTFW/EventData/SimIdentifier.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
+#include "ACTFW/Utilities/RadixSort.hpp"
 #include "ACTFW/Utilities/Range.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
 #include "Acts/Plugins/Identification/IdentifiedDetectorElement.hpp"
 #include "Acts/Utilities/Units.hpp"
 #include "TrackMlData.hpp"
@@ -103,58 +104,51 @@ extractGeometryId(const FW::HitData& data)
   return geoId;
 }
 
-struct CompareGeometryId
-{
-  bool
-  operator()(const FW::HitData& left, const FW::HitData& right) const
-  {
-    auto leftId  = extractGeometryId(left).value();
-    auto rightId = extractGeometryId(right).value();
-    return leftId < rightId;
-  }
-};
-
 template <typename Data>
 inline std::vector<Data>
 readEverything(const std::string&              inputDir,
                const std::string&              filename,
                const std::vector<std::string>& optionalColumns,
-               size_t                          event)
+               size_t                          event,
+               size_t                          capacity)
 {
   std::string path = FW::perEventFilepath(inputDir, filename, event);
   dfe::NamedTupleCsvReader<Data> reader(path, optionalColumns);
 
   std::vector<Data> everything;
-  Data              one;
+  everything.reserve(capacity);
+  Data one;
   while (reader.read(one)) { everything.push_back(one); }
 
   return everything;
 }
 
 std::vector<FW::HitData>
-readHitsByGeoId(const std::string& inputDir, size_t event)
+readHitsByGeoId(const std::string& inputDir, size_t event, size_t capacity)
 {
   // geometry_id and t are optional columns
   auto hits = readEverything<FW::HitData>(
-      inputDir, "hits.csv", {"geometry_id", "t"}, event);
+      inputDir, "hits.csv", {"geometry_id", "t"}, event, capacity);
   // sort same way they will be sorted in the output container
-  std::sort(hits.begin(), hits.end(), CompareGeometryId{});
+  FW::radixSort(hits, [](const FW::HitData& hit) {
+    return extractGeometryId(hit).value();
+  });
   return hits;
 }
 
 std::vector<FW::CellData>
-readCellsByHitId(const std::string& inputDir, size_t event)
+readCellsByHitId(const std::string& inputDir, size_t event, size_t capacity)
 {
   // timestamp is an optional element
   auto cells = readEverything<FW::CellData>(
-      inputDir, "cells.csv", {"timestamp"}, event);
+      inputDir, "cells.csv", {"timestamp"}, event, capacity);
   // sort for fast hit id look up
-  std::sort(cells.begin(), cells.end(), CompareHitId{});
+  FW::radixSort(cells, [](const FW::CellData& cell) { return cell.hit_id; });
   return cells;
 }
 
 std::vector<FW::TruthHitData>
-readTruthHitsByHitId(const std::string& inputDir, size_t event)
+readTruthHitsByHitId(const std::string& inputDir, size_t event, size_t capacity)
 {
   // define all optional columns
   std::vector<std::string> optionalColumns = {
@@ -168,9 +162,10 @@ readTruthHitsByHitId(const std::string& inputDir, size_t event)
       "index",
   };
   auto truths = readEverything<FW::TruthHitData>(
-      inputDir, "truth.csv", optionalColumns, event);
+      inputDir, "truth.csv", optionalColumns, event, capacity);
   // sort for fast hit id look up
-  std::sort(truths.begin(), truths.end(), CompareHitId{});
+  FW::radixSort(truths,
+                [](const FW::TruthHitData& truth) { return truth.hit_id; });
   return truths;
 }
 
@@ -184,16 +179,23 @@ FW::CsvPlanarClusterReader::read(const FW::AlgorithmContext& ctx)
   // to simplify data handling. to be able to perform this mapping we first
   // read all data into memory before converting to the internal event data
   // types.
-  auto hits   = readHitsByGeoId(m_cfg.inputDir, ctx.eventNumber);
-  auto cells  = readCellsByHitId(m_cfg.inputDir, ctx.eventNumber);
-  auto truths = readTruthHitsByHitId(m_cfg.inputDir, ctx.eventNumber);
+  // the output collection sizes from previous events are used to estimate
+  // the number of entries in each file. cells are not stored separately and
+  // are estimated from a few cells per hit.
+  auto numHits   = ctx.capacityHint(m_cfg.outputClusters, 0u);
+  auto numTruths = ctx.capacityHint(m_cfg.outputSimulatedHits, 0u);
+  auto hits      = readHitsByGeoId(m_cfg.inputDir, ctx.eventNumber, numHits);
+  auto cells
+      = readCellsByHitId(m_cfg.inputDir, ctx.eventNumber, 4u * numHits);
+  auto truths
+      = readTruthHitsByHitId(m_cfg.inputDir, ctx.eventNumber, numTruths);
 
   // prepare containers for the hit data using the framework event data types
-  GeometryIdMultimap<Acts::PlanarModuleCluster> clusters;
-  std::vector<uint64_t>                         hitIds;
-  IndexMultimap<ActsFatras::Barcode>            hitParticlesMap;
-  SimHitContainer                               simHits;
-  clusters.reserve(hits.size());
+  PlanarClusterContainer             clusters;
+  std::vector<uint64_t>              hitIds;
+  IndexMultimap<ActsFatras::Barcode> hitParticlesMap;
+  SimHitContainer                    simHits;
+  clusters.reserve(hits.size(), cells.size(), truths.size());
   hitIds.reserve(hits.size());
   hitParticlesMap.reserve(truths.size());
   simHits.reserve(truths.size());
@@ -202,11 +204,9 @@ FW::CsvPlanarClusterReader::read(const FW::AlgorithmContext& ctx)
     Acts::GeometryID geoId = extractGeometryId(hit);
 
     // find associated truth/ simulation hits
-    std::vector<std::size_t> simHitIndices;
     {
       auto range = makeRange(std::equal_range(
           truths.begin(), truths.end(), hit.hit_id, CompareHitId{}));
-      simHitIndices.reserve(range.size());
       for (const auto& truth : range) {
         const auto simGeometryId = Acts::GeometryID(truth.geometry_id);
         // TODO validate geo id consistency
@@ -247,17 +247,18 @@ FW::CsvPlanarClusterReader::read(const FW::AlgorithmContext& ctx)
           ACTS_FATAL("Truth hit sorting broke for input hit id " << hit.hit_id);
           return ProcessCode::ABORT;
         }
-        simHitIndices.push_back(simHits.index_of(inserted));
+        clusters.addHitIndex(simHits.index_of(inserted));
       }
     }
 
     // find matching pixel cell information
-    std::vector<Acts::DigitizationCell> digitizationCells;
     {
       auto range = makeRange(std::equal_range(
           cells.begin(), cells.end(), hit.hit_id, CompareHitId{}));
       for (const auto& c : range) {
-        digitizationCells.emplace_back(c.ch0, c.ch1, c.value);
+        clusters.addCell({static_cast<uint32_t>(c.ch0),
+                          static_cast<uint32_t>(c.ch1),
+                          static_cast<float>(c.value)});
       }
     }
 
@@ -277,29 +278,21 @@ FW::CsvPlanarClusterReader::read(const FW::AlgorithmContext& ctx)
     Acts::Vector3D mom(1, 1, 1);  // fake momentum
     Acts::Vector2D local(0, 0);
     surface.globalToLocal(ctx.geoContext, pos, mom, local);
-    // TODO what to use as cluster uncertainty?
-    Acts::ActsSymMatrixD<3> cov = Acts::ActsSymMatrixD<3>::Identity();
     // create the planar cluster
-    Acts::PlanarModuleCluster cluster(
-        surface.getSharedPtr(),
-        Identifier(identifier_type(geoId.value()), std::move(simHitIndices)),
-        std::move(cov),
-        local[0],
-        local[1],
-        time,
-        std::move(digitizationCells));
+    PlanarCluster cluster;
+    cluster.geoId   = geoId;
+    cluster.surface = &surface;
+    cluster.local0  = local[0];
+    cluster.local1  = local[1];
+    cluster.time    = time;
+    // TODO what to use as cluster uncertainty?
+    cluster.cov = Acts::ActsSymMatrixD<3>::Identity();
 
     // due to the previous sorting of the raw hit data by geometry id, new
     // clusters should always end up at the end of the container. previous
     // elements were not touched; cluster indices remain stable and can
     // be used to identify the hit.
-    auto inserted
-        = clusters.emplace_hint(clusters.end(), geoId, std::move(cluster));
-    if (std::next(inserted) != clusters.end()) {
-      ACTS_FATAL("Something went horribly wrong with the hit sorting");
-      return ProcessCode::ABORT;
-    }
-    auto hitIndex   = clusters.index_of(inserted);
+    auto hitIndex   = clusters.finishCluster(std::move(cluster));
     auto truthRange = makeRange(std::equal_range(
         truths.begin(), truths.end(), hit.hit_id, CompareHitId{}));
     for (const auto& truth : truthRange) {
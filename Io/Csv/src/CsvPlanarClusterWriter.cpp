@@ -13,12 +13,11 @@
 #include <dfe/dfe_io_dsv.hpp>
 
 #include "ACTFW/EventData/SimHit.hpp"
-#include "ACTFW/EventData/SimIdentifier.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/EventData/SimVertex.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
+#include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/Units.hpp"
 #include "TrackMlData.hpp"
 
@@ -34,9 +33,8 @@ FW::CsvPlanarClusterWriter::CsvPlanarClusterWriter(
 }
 
 FW::ProcessCode
-FW::CsvPlanarClusterWriter::writeT(
-    const AlgorithmContext&                                  ctx,
-    const FW::GeometryIdMultimap<Acts::PlanarModuleCluster>& clusters)
+FW::CsvPlanarClusterWriter::writeT(const AlgorithmContext&       ctx,
+                                   const PlanarClusterContainer& clusters)
 {
   // retrieve simulated hits
   const auto& simHits
@@ -62,16 +60,14 @@ FW::CsvPlanarClusterWriter::writeT(
   // will be reused as hit counter
   hit.hit_id = 0;
 
-  for (const auto& entry : clusters) {
-    Acts::GeometryID                 geoId   = entry.first;
-    const Acts::PlanarModuleCluster& cluster = entry.second;
+  for (const PlanarCluster& cluster : clusters) {
+    Acts::GeometryID geoId = cluster.geoId;
     // local cluster information
-    const auto&    parameters = cluster.parameters();
-    Acts::Vector2D localPos(parameters[0], parameters[1]);
+    Acts::Vector2D localPos(cluster.local0, cluster.local1);
     Acts::Vector3D globalFakeMom(1, 1, 1);
     Acts::Vector3D globalPos(0, 0, 0);
     // transform local into global position information
-    cluster.referenceSurface().localToGlobal(
+    cluster.surface->localToGlobal(
         ctx.geoContext, localPos, globalFakeMom, globalPos);
 
     // encoded geometry identifier
@@ -84,17 +80,17 @@ FW::CsvPlanarClusterWriter::writeT(
     hit.x = globalPos.x() / Acts::UnitConstants::mm;
     hit.y = globalPos.y() / Acts::UnitConstants::mm;
     hit.z = globalPos.z() / Acts::UnitConstants::mm;
-    hit.t = parameters[2] / Acts::UnitConstants::ns;
+    hit.t = cluster.time / Acts::UnitConstants::ns;
     writerHits.append(hit);
 
     // write local cell information
     cell.hit_id = hit.hit_id;
-    for (auto& c : cluster.digitizationCells()) {
+    for (const auto& c : clusters.cells(cluster)) {
       cell.ch0 = c.channel0;
       cell.ch1 = c.channel1;
       // TODO store digitial timestamp once added to the cell definition
       cell.timestamp = 0;
-      cell.value     = c.data;
+      cell.value     = c.value;
       writerCells.append(cell);
     }
 
@@ -102,7 +98,7 @@ FW::CsvPlanarClusterWriter::writeT(
     // each hit can have multiple particles, e.g. in a dense environment
     truth.hit_id      = hit.hit_id;
     truth.geometry_id = hit.geometry_id;
-    for (auto idx : cluster.sourceLink().indices()) {
+    for (auto idx : clusters.hitIndices(cluster)) {
       auto it = simHits.nth(idx);
       if (it == simHits.end()) {
         ACTS_FATAL("Simulation hit with index " << idx << " does not exist");
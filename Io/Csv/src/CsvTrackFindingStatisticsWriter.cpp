@@ -0,0 +1,75 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Io/Csv/CsvTrackFindingStatisticsWriter.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <dfe/dfe_io_dsv.hpp>
+
+#include "ACTFW/Utilities/Paths.hpp"
+#include "TrackMlData.hpp"
+
+FW::CsvTrackFindingStatisticsWriter::CsvTrackFindingStatisticsWriter(
+    const FW::CsvTrackFindingStatisticsWriter::Config& cfg,
+    Acts::Logging::Level                               lvl)
+  : WriterT(cfg.inputStatistics, "CsvTrackFindingStatisticsWriter", lvl)
+  , m_cfg(cfg)
+{
+  // inputStatistics is already checked by base constructor
+  if (m_cfg.outputFilename.empty()) {
+    throw std::invalid_argument("Missing output filename");
+  }
+}
+
+FW::ProcessCode
+FW::CsvTrackFindingStatisticsWriter::writeT(
+    const FW::AlgorithmContext&   ctx,
+    const TrackFindingStatistics& statistics)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events[ctx.eventNumber] = statistics;
+  return ProcessCode::SUCCESS;
+}
+
+FW::ProcessCode
+FW::CsvTrackFindingStatisticsWriter::endRun()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  dfe::NamedTupleCsvWriter<TrackFindingStatisticsData> writer(
+      joinPaths(m_cfg.outputDir, m_cfg.outputFilename));
+
+  TrackFindingStatistics     total;
+  TrackFindingStatisticsData data;
+  for (const auto& [eventNumber, statistics] : m_events) {
+    data.event_id     = eventNumber;
+    data.seeds        = statistics.seeds;
+    data.failed_seeds = statistics.failedSeeds;
+    data.candidates   = statistics.candidates;
+    data.tracks       = statistics.tracks;
+    data.measurements = statistics.measurements;
+    writer.append(data);
+
+    total.seeds += statistics.seeds;
+    total.failedSeeds += statistics.failedSeeds;
+    total.candidates += statistics.candidates;
+    total.tracks += statistics.tracks;
+    total.measurements += statistics.measurements;
+  }
+
+  const double nEvents = std::max<std::size_t>(m_events.size(), 1u);
+  ACTS_INFO("Track finding in " << m_events.size() << " events:");
+  ACTS_INFO("  seeds/event: " << total.seeds / nEvents << ", failed "
+                              << total.failedSeeds << " of " << total.seeds);
+  ACTS_INFO("  candidates/event: " << total.candidates / nEvents);
+  ACTS_INFO("  tracks/event: " << total.tracks / nEvents);
+  ACTS_INFO("  measurements/event: " << total.measurements / nEvents);
+  return ProcessCode::SUCCESS;
+}
@@ -186,4 +186,23 @@ struct SurfaceData
                  pitch_v);
 };
 
+/// Track finding statistics of one event. Not part of the TrackML datasets.
+struct TrackFindingStatisticsData
+{
+  uint64_t event_id;
+  uint64_t seeds;
+  uint64_t failed_seeds;
+  uint64_t candidates;
+  uint64_t tracks;
+  uint64_t measurements;
+
+  DFE_NAMEDTUPLE(TrackFindingStatisticsData,
+                 event_id,
+                 seeds,
+                 failed_seeds,
+                 candidates,
+                 tracks,
+                 measurements);
+};
+
 }  // namespace FW
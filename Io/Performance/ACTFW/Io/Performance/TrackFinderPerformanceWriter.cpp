@@ -11,7 +11,6 @@
 #include <algorithm>
 #include <cstdint>
 #include <mutex>
-#include <unordered_map>
 #include <vector>
 
 #include <TFile.h>
@@ -19,6 +18,7 @@
 
 #include "ACTFW/EventData/IndexContainers.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
+#include "ACTFW/EventData/SimParticleIndex.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
 #include "ACTFW/Utilities/Range.hpp"
 #include "ACTFW/Validation/ProtoTrackClassification.hpp"
@@ -147,12 +147,12 @@ struct FW::TrackFinderPerformanceWriter::Impl
   {
     // compute the inverse mapping on-the-fly
     const auto& particleHitsMap = invertIndexMultimap(hitParticlesMap);
+    // barcode lookup to store per-particle counts by container position
+    const SimParticleIndex particlesIndex(particles);
     // How often a particle was reconstructed.
-    std::unordered_map<ActsFatras::Barcode, std::size_t> reconCount;
-    reconCount.reserve(particles.size());
+    std::vector<std::size_t> reconCount(particles.size(), 0u);
     // How often a particle was reconstructed as the majority particle.
-    std::unordered_map<ActsFatras::Barcode, std::size_t> majorityCount;
-    majorityCount.reserve(particles.size());
+    std::vector<std::size_t> majorityCount(particles.size(), 0u);
     // For each particle within a track, how many hits did it contribute
     std::vector<ParticleHitCount> particleHitCounts;
 
@@ -167,16 +167,16 @@ struct FW::TrackFinderPerformanceWriter::Impl
         // extract per-particle reconstruction counts
         // empty track hits counts could originate from a  buggy track finder
         // that results in empty tracks or from purely noise track where no hits
-        // is from a particle.
+        // is from a particle. particles missing from the input collection are
+        // not counted.
         if (not particleHitCounts.empty()) {
-          auto it = majorityCount
-                        .try_emplace(particleHitCounts.front().particleId, 0u)
-                        .first;
-          it->second += 1;
+          const auto& majority = particleHitCounts.front();
+          auto        ip       = particlesIndex.indexOf(majority.particleId);
+          if (ip != SIZE_MAX) { majorityCount[ip] += 1; }
         }
         for (const auto& hc : particleHitCounts) {
-          auto it = reconCount.try_emplace(hc.particleId, 0u).first;
-          it->second += 1;
+          auto ip = particlesIndex.indexOf(hc.particleId);
+          if (ip != SIZE_MAX) { reconCount[ip] += 1; }
         }
 
         trkEventId      = eventId;
@@ -202,7 +202,9 @@ struct FW::TrackFinderPerformanceWriter::Impl
     // write per-particle performance measures
     {
       std::lock_guard<std::mutex> guardPrt(trkMutex);
-      for (const auto& particle : particles) {
+      for (auto ip = particles.begin(); ip != particles.end(); ++ip) {
+        const auto& particle = *ip;
+        const auto  index    = particles.index_of(ip);
         // find all hits for this particle
         auto hits
             = makeRange(particleHitsMap.equal_range(particle.particleId()));
@@ -224,10 +226,8 @@ struct FW::TrackFinderPerformanceWriter::Impl
         prtQ         = particle.charge() / Acts::UnitConstants::e;
         // reconstruction
         prtNumHits           = hits.size();
-        auto nt              = reconCount.find(particle.particleId());
-        prtNumTracks         = (nt != reconCount.end()) ? nt->second : 0u;
-        auto nm              = majorityCount.find(particle.particleId());
-        prtNumTracksMajority = (nm != majorityCount.end()) ? nm->second : 0u;
+        prtNumTracks         = reconCount[index];
+        prtNumTracksMajority = majorityCount[index];
 
         prtTree->Fill();
       }
@@ -15,6 +15,7 @@
 #include <TTree.h>
 
 #include "ACTFW/EventData/SimParticle.hpp"
+#include "ACTFW/EventData/SimParticleIndex.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
 
 using Acts::VectorHelpers::eta;
@@ -89,6 +90,8 @@ FW::TrackFitterPerformanceWriter::writeT(
   // Read truth particles from input collection
   const auto& particles
       = ctx.eventStore.get<SimParticleContainer>(m_cfg.inputParticles);
+  // Build the barcode lookup index once for all trajectories
+  const SimParticleIndex particlesIndex(particles);
 
   // Exclusive access to the tree while writing
   std::lock_guard<std::mutex> lock(m_writeMutex);
@@ -106,7 +109,7 @@ FW::TrackFitterPerformanceWriter::writeT(
     if (particleHitCount.empty()) { continue; }
 
     // find the truth particle for the majority barcode
-    const auto ip = particles.find(particleHitCount.front().particleId);
+    const auto ip = particlesIndex.find(particleHitCount.front().particleId);
     if (ip == particles.end()) { continue; }
 
     // record this trajectory with its truth info
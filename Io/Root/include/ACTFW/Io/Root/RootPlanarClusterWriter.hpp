@@ -10,9 +10,8 @@
 
 #include <mutex>
 
-#include "ACTFW/EventData/GeometryContainers.hpp"
+#include "ACTFW/EventData/PlanarClusters.hpp"
 #include "ACTFW/Framework/WriterT.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
 
 class TFile;
 class TTree;
@@ -30,8 +29,7 @@ namespace FW {
 /// this is done by setting the Config::rootFile pointer to an existing file
 ///
 /// Safe to use from multiple writer threads - uses a std::mutex lock.
-class RootPlanarClusterWriter
-  : public WriterT<GeometryIdMultimap<Acts::PlanarModuleCluster>>
+class RootPlanarClusterWriter : public WriterT<PlanarClusterContainer>
 {
 public:
   struct Config
@@ -65,9 +63,8 @@ protected:
   /// @param ctx The Algorithm context with per event information
   /// @param clusters is the data to be written out
   ProcessCode
-  writeT(const AlgorithmContext&                              ctx,
-         const GeometryIdMultimap<Acts::PlanarModuleCluster>& clusters)
-      final override;
+  writeT(const AlgorithmContext&       ctx,
+         const PlanarClusterContainer& clusters) final override;
 
 private:
   Config             m_cfg;         ///< the configuration object
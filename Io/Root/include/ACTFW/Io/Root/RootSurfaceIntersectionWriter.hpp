@@ -0,0 +1,94 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#pragma once
+
+#include <mutex>
+
+#include <ACTFW/Framework/WriterT.hpp>
+
+#include "ACTFW/Propagation/SurfaceIntersectionRecorder.hpp"
+
+class TFile;
+class TTree;
+
+namespace FW {
+
+/// @class RootSurfaceIntersectionWriter
+///
+/// Write out the target surface intersections of test propagations, i.e.
+/// the output of the surface mode of the propagation algorithm. The
+/// intersections of each test propagation are one entry in the root file;
+/// tests without any intersection have no entry.
+/// The event number and the test index are part of the written data.
+///
+/// A common file can be provided for to the writer to attach his TTree,
+/// this is done by setting the Config::rootFile pointer to an existing file
+///
+/// Safe to use from multiple writer threads - uses a std::mutex lock.
+class RootSurfaceIntersectionWriter
+  : public WriterT<std::vector<SurfaceIntersection>>
+{
+public:
+  struct Config
+  {
+    std::string collection
+        = "propagation-intersections";  ///< intersection collection to write
+    std::string filePath = "";          ///< path of the output file
+    std::string fileMode = "RECREATE";  ///< file access mode
+    std::string treeName
+        = "propagation_intersections";  ///< name of the output tree
+    TFile* rootFile = nullptr;          ///< common root file
+  };
+
+  /// Constructor with
+  /// @param cfg configuration struct
+  /// @param output logging level
+  RootSurfaceIntersectionWriter(
+      const Config&        cfg,
+      Acts::Logging::Level level = Acts::Logging::INFO);
+
+  /// Virtual destructor
+  ~RootSurfaceIntersectionWriter() override;
+
+  /// End-of-run hook
+  ProcessCode
+  endRun() final override;
+
+protected:
+  /// This implementation holds the actual writing method
+  /// and is called by the WriterT<>::write interface
+  ///
+  /// @param context The Algorithm context with per event information
+  /// @param intersections is the data to be written out
+  ProcessCode
+  writeT(const AlgorithmContext&                 context,
+         const std::vector<SurfaceIntersection>& intersections) final override;
+
+private:
+  Config             m_cfg;          ///< the configuration object
+  std::mutex         m_writeMutex;   ///< protect multi-threaded writes
+  TFile*             m_outputFile;   ///< the output file name
+  TTree*             m_outputTree;   ///< the output tree
+  int                m_eventNr;      ///< the event number of
+  int                m_trackNr;      ///< the test index within the event
+  std::vector<int>   m_volumeID;     ///< volume identifier
+  std::vector<int>   m_boundaryID;   ///< boundary identifier
+  std::vector<int>   m_layerID;      ///< layer identifier if
+  std::vector<int>   m_approachID;   ///< surface identifier
+  std::vector<int>   m_sensitiveID;  ///< surface identifier
+  std::vector<float> m_x;            ///< global x
+  std::vector<float> m_y;            ///< global y
+  std::vector<float> m_z;            ///< global z
+  std::vector<float> m_px;           ///< global momentum x
+  std::vector<float> m_py;           ///< global momentum y
+  std::vector<float> m_pz;           ///< global momentum z
+  std::vector<float> m_pathLength;   ///< path length from the start
+};
+
+}  // namespace FW
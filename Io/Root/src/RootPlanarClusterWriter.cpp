@@ -15,14 +15,14 @@
 #include <TTree.h>
 
 #include "ACTFW/EventData/SimHit.hpp"
-#include "ACTFW/EventData/SimIdentifier.hpp"
 #include "ACTFW/EventData/SimParticle.hpp"
 #include "ACTFW/Framework/WhiteBoard.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
 #include "Acts/Plugins/Digitization/DigitizationModule.hpp"
-#include "Acts/Plugins/Digitization/PlanarModuleCluster.hpp"
+#include "Acts/Plugins/Digitization/DigitizationCell.hpp"
 #include "Acts/Plugins/Digitization/Segmentation.hpp"
 #include "Acts/Plugins/Identification/IdentifiedDetectorElement.hpp"
+#include "Acts/Surfaces/Surface.hpp"
 #include "Acts/Utilities/Units.hpp"
 
 FW::RootPlanarClusterWriter::RootPlanarClusterWriter(
@@ -96,9 +96,8 @@ FW::RootPlanarClusterWriter::endRun()
 }
 
 FW::ProcessCode
-FW::RootPlanarClusterWriter::writeT(
-    const AlgorithmContext&                                  ctx,
-    const FW::GeometryIdMultimap<Acts::PlanarModuleCluster>& clusters)
+FW::RootPlanarClusterWriter::writeT(const AlgorithmContext&       ctx,
+                                    const PlanarClusterContainer& clusters)
 {
   // retrieve simulated hits
   const auto& simHits
@@ -110,19 +109,16 @@ FW::RootPlanarClusterWriter::writeT(
   m_eventNr = ctx.eventNumber;
 
   // Loop over the planar clusters in this event
-  for (const auto& entry : clusters) {
-    Acts::GeometryID                 geoId   = entry.first;
-    const Acts::PlanarModuleCluster& cluster = entry.second;
+  for (const PlanarCluster& cluster : clusters) {
+    Acts::GeometryID geoId = cluster.geoId;
     // local cluster information: position, @todo coveraiance
-    auto           parameters = cluster.parameters();
-    Acts::Vector2D local(parameters[Acts::ParDef::eLOC_0],
-                         parameters[Acts::ParDef::eLOC_1]);
+    Acts::Vector2D local(cluster.local0, cluster.local1);
 
     /// prepare for calculating the
     Acts::Vector3D pos(0, 0, 0);
     Acts::Vector3D mom(1, 1, 1);
     // the cluster surface
-    const auto& clusterSurface = cluster.referenceSurface();
+    const auto& clusterSurface = *cluster.surface;
     // transform local into global position information
     clusterSurface.localToGlobal(ctx.geoContext, local, mom, pos);
     // identification
@@ -132,16 +128,16 @@ FW::RootPlanarClusterWriter::writeT(
     m_x         = pos.x();
     m_y         = pos.y();
     m_z         = pos.z();
-    m_t         = parameters[2] / Acts::UnitConstants::ns;
+    m_t         = cluster.time / Acts::UnitConstants::ns;
     m_lx        = local.x();
     m_ly        = local.y();
     m_cov_lx    = 0.;  // @todo fill in
     m_cov_ly    = 0.;  // @todo fill in
     // get the cells and run through them
-    const auto& cells    = cluster.digitizationCells();
     auto detectorElement = dynamic_cast<const Acts::IdentifiedDetectorElement*>(
         clusterSurface.associatedDetectorElement());
-    for (auto& cell : cells) {
+    for (const auto& c : clusters.cells(cluster)) {
+      Acts::DigitizationCell cell(c.channel0, c.channel1, c.value);
       // cell identification
       m_cell_IDx.push_back(cell.channel0);
       m_cell_IDy.push_back(cell.channel1);
@@ -159,7 +155,7 @@ FW::RootPlanarClusterWriter::writeT(
     }
     // write hit-particle truth association
     // each hit can have multiple particles, e.g. in a dense environment
-    for (auto idx : cluster.sourceLink().indices()) {
+    for (auto idx : clusters.hitIndices(cluster)) {
       auto it = simHits.nth(idx);
       if (it == simHits.end()) {
         ACTS_FATAL("Simulation hit with index " << idx << " does not exist");
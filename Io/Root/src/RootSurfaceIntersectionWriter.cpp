@@ -0,0 +1,132 @@
+// This file is part of the Acts project.
+//
+// Copyright (C) 2020 CERN for the benefit of the Acts project
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include "ACTFW/Io/Root/RootSurfaceIntersectionWriter.hpp"
+
+#include <ios>
+#include <stdexcept>
+
+#include <TFile.h>
+#include <TTree.h>
+
+#include "ACTFW/Framework/WhiteBoard.hpp"
+
+FW::RootSurfaceIntersectionWriter::RootSurfaceIntersectionWriter(
+    const FW::RootSurfaceIntersectionWriter::Config& cfg,
+    Acts::Logging::Level                             level)
+  : WriterT(cfg.collection, "RootSurfaceIntersectionWriter", level)
+  , m_cfg(cfg)
+  , m_outputFile(cfg.rootFile)
+{
+  // An input collection name and tree name must be specified
+  if (m_cfg.collection.empty()) {
+    throw std::invalid_argument("Missing input collection");
+  } else if (m_cfg.treeName.empty()) {
+    throw std::invalid_argument("Missing tree name");
+  }
+
+  // Setup ROOT I/O
+  if (m_outputFile == nullptr) {
+    m_outputFile = TFile::Open(m_cfg.filePath.c_str(), m_cfg.fileMode.c_str());
+    if (m_outputFile == nullptr) {
+      throw std::ios_base::failure("Could not open '" + m_cfg.filePath);
+    }
+  }
+  m_outputFile->cd();
+
+  m_outputTree = new TTree(m_cfg.treeName.c_str(),
+                           "TTree from RootSurfaceIntersectionWriter");
+  if (m_outputTree == nullptr) throw std::bad_alloc();
+
+  // Set the branches
+  m_outputTree->Branch("event_nr", &m_eventNr);
+  m_outputTree->Branch("track_nr", &m_trackNr);
+  m_outputTree->Branch("volume_id", &m_volumeID);
+  m_outputTree->Branch("boundary_id", &m_boundaryID);
+  m_outputTree->Branch("layer_id", &m_layerID);
+  m_outputTree->Branch("approach_id", &m_approachID);
+  m_outputTree->Branch("sensitive_id", &m_sensitiveID);
+  m_outputTree->Branch("g_x", &m_x);
+  m_outputTree->Branch("g_y", &m_y);
+  m_outputTree->Branch("g_z", &m_z);
+  m_outputTree->Branch("p_x", &m_px);
+  m_outputTree->Branch("p_y", &m_py);
+  m_outputTree->Branch("p_z", &m_pz);
+  m_outputTree->Branch("path_length", &m_pathLength);
+}
+
+FW::RootSurfaceIntersectionWriter::~RootSurfaceIntersectionWriter()
+{
+  /// Close the file if it's yours
+  if (m_cfg.rootFile == nullptr) { m_outputFile->Close(); }
+}
+
+FW::ProcessCode
+FW::RootSurfaceIntersectionWriter::endRun()
+{
+  // Write the tree
+  m_outputFile->cd();
+  m_outputTree->Write();
+  ACTS_VERBOSE("Wrote surface intersections to tree '"
+               << m_cfg.treeName << "' in '" << m_cfg.filePath << "'");
+  return ProcessCode::SUCCESS;
+}
+
+FW::ProcessCode
+FW::RootSurfaceIntersectionWriter::writeT(
+    const AlgorithmContext&                 context,
+    const std::vector<SurfaceIntersection>& intersections)
+{
+  // Exclusive access to the tree while writing
+  std::lock_guard<std::mutex> lock(m_writeMutex);
+
+  // we get the event number
+  m_eventNr = context.eventNumber;
+
+  // the intersections are ordered by test, i.e. each test is one contiguous
+  // range that is written as one entry
+  auto it = intersections.begin();
+  while (it != intersections.end()) {
+
+    // clear the vectors for each test
+    m_volumeID.clear();
+    m_boundaryID.clear();
+    m_layerID.clear();
+    m_approachID.clear();
+    m_sensitiveID.clear();
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_px.clear();
+    m_py.clear();
+    m_pz.clear();
+    m_pathLength.clear();
+
+    m_trackNr = it->track;
+    for (; (it != intersections.end()) and (it->track == size_t(m_trackNr));
+         ++it) {
+      // the identification of the crossed surface
+      m_volumeID.push_back(it->geoId.volume());
+      m_boundaryID.push_back(it->geoId.boundary());
+      m_layerID.push_back(it->geoId.layer());
+      m_approachID.push_back(it->geoId.approach());
+      m_sensitiveID.push_back(it->geoId.sensitive());
+
+      // kinematic information
+      m_x.push_back(it->position.x());
+      m_y.push_back(it->position.y());
+      m_z.push_back(it->position.z());
+      m_px.push_back(it->momentum.x());
+      m_py.push_back(it->momentum.y());
+      m_pz.push_back(it->momentum.z());
+      m_pathLength.push_back(it->pathLength);
+    }
+    m_outputTree->Fill();
+  }
+  return FW::ProcessCode::SUCCESS;
+}
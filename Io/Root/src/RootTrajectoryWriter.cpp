@@ -15,6 +15,7 @@
 #include <TTree.h>
 
 #include "ACTFW/EventData/SimParticle.hpp"
+#include "ACTFW/EventData/SimParticleIndex.hpp"
 #include "ACTFW/Utilities/Paths.hpp"
 #include "Acts/EventData/Measurement.hpp"
 #include "Acts/EventData/MultiTrajectory.hpp"
@@ -261,6 +262,8 @@ FW::RootTrajectoryWriter::writeT(const AlgorithmContext&    ctx,
   // read truth particles from input collection
   const auto& particles
       = ctx.eventStore.get<SimParticleContainer>(m_cfg.inputParticles);
+  // build the barcode lookup index once for all trajectories
+  const SimParticleIndex particlesIndex(particles);
 
   // Exclusive access to the tree while writing
   std::lock_guard<std::mutex> lock(m_writeMutex);
@@ -289,7 +292,7 @@ FW::RootTrajectoryWriter::writeT(const AlgorithmContext&    ctx,
       // Get the barcode of the majority truth particle
       m_t_barcode = particleHitCount.front().particleId.value();
       // Find the truth particle via the barcode
-      auto ip = particles.find(m_t_barcode);
+      auto ip = particlesIndex.find(m_t_barcode);
       if (ip != particles.end()) {
         const auto& particle = *ip;
         ACTS_DEBUG("Find the truth particle with barcode = " << m_t_barcode);